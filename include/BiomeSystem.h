@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 
 enum class BiomeType : int {
     // Cold biomes
@@ -36,6 +37,26 @@ struct TemperatureHumidity {
     float humidity;    // 0.0 = dry, 1.0 = wet
 };
 
+// Biome and climate of every column of one chunk, built once by BiomeSystem::ComputeBiomeMap.
+// Climate and river noise are sampled on a world-aligned grid every GRID_SPACING blocks (the
+// chunk's own corners plus the first column of its +X and +Z neighbours) and interpolated
+// bilinearly in between, so a chunk costs GRID_POINTS^2 climate samples instead of one per column.
+// Grid points are sampled exactly, so there the map agrees with BiomeSystem::GetBiomeType.
+// Plain data, so it can be copied into network messages and mesh snapshots as is.
+struct ChunkBiomeMap {
+    static constexpr int WIDTH = 16;        // Columns per side, the chunk width
+    static constexpr int GRID_SPACING = 4;  // Blocks between climate samples
+    static constexpr int GRID_POINTS = WIDTH / GRID_SPACING + 1;
+    
+    std::array<uint8_t, WIDTH * WIDTH> biomes = {};                           // BiomeType per column, [z * 16 + x]
+    std::array<TemperatureHumidity, GRID_POINTS * GRID_POINTS> climateGrid = {}; // [j * GRID_POINTS + i]
+    
+    BiomeType GetBiome(int x, int z) const { return static_cast<BiomeType>(biomes[z * WIDTH + x]); }
+    
+    // Interpolated climate of column (x, z)
+    TemperatureHumidity GetClimate(int x, int z) const;
+};
+
 class BiomeSystem {
 public:
     // Get biome type from world coordinates using temperature and humidity
@@ -44,6 +65,9 @@ public:
     // Get temperature and humidity at world coordinates
     static TemperatureHumidity GetTemperatureHumidity(int worldX, int worldZ, int seed);
     
+    // Biome map of chunk (chunkX, chunkZ), see ChunkBiomeMap
+    static void ComputeBiomeMap(int chunkX, int chunkZ, int seed, ChunkBiomeMap& map);
+    
     // Determine biome from temperature and humidity values
     static BiomeType GetBiomeFromClimate(float temperature, float humidity);
     
@@ -63,7 +87,12 @@ private:
     // Biome color data based on your specifications
     static const std::array<BiomeColors, static_cast<int>(BiomeType::COUNT)> s_biomeColors;
     
-    // Noise functions for climate generation
-    static double PerlinNoise(double x, double z, int seed, double scale);
-    static double SimplexNoise(double x, double z, int seed, double scale);
+    // Climate and river noise octaves of one world seed, built once per seed on each thread
+    // (construction shuffles eight permutation tables, far more work than a sample)
+    struct ClimateNoise;
+    static const ClimateNoise& GetClimateNoise(int seed);
+    
+    // Shared by the single-column and biome map paths so both classify a grid point identically
+    static TemperatureHumidity CombineClimate(const float temperatureOctaves[3], const float humidityOctaves[3]);
+    static bool IsRiverValue(float riverNoise1, float riverNoise2);
 };
\ No newline at end of file
@@ -17,6 +17,32 @@ struct BlockTextureInfo {
     bool hasOverlay = false;   // Needs overlay rendering
 };
 
+// Biome colour applied to a texture layer, resolved per chunk when the mesh is built
+enum class BiomeTint : uint8_t {
+    NONE = 0,
+    GRASS = 1,    // BiomeSystem::GetGrassColor
+    FOLIAGE = 2   // BiomeSystem::GetFoliageColor
+};
+
+// Layers of the block texture array used by each face of a block
+struct BlockTextureLayers {
+    uint16_t top = 0;
+    uint16_t bottom = 0;
+    uint16_t side = 0;                      // Also used by cross sprites
+    BiomeTint topTint = BiomeTint::NONE;
+    BiomeTint bottomTint = BiomeTint::NONE;
+    BiomeTint sideTint = BiomeTint::NONE;   // Applies to the overlay when sideOverlay is set
+    bool sideOverlay = false;               // Layer side + 1 is an alpha overlay drawn over the side texture
+};
+
+// One layer of the block texture array: a texture file with the block definition's tint baked in
+struct TextureLayerSource {
+    std::string file;   // Relative to assets/block/
+    float tintR = 1.0f;
+    float tintG = 1.0f;
+    float tintB = 1.0f;
+};
+
 enum class BlockCategory {
     SOLID,
     TRANSPARENT,
@@ -54,6 +80,14 @@ public:
     // Get texture information
     const BlockTextureInfo& GetTextureInfo(BlockType blockType) const;
     
+    // Texture array layout, assigned whenever definitions are loaded. Layer lookups are plain
+    // array reads, so mesh workers can call them concurrently.
+    const BlockTextureLayers& GetTextureLayers(BlockType blockType) const {
+        size_t index = static_cast<size_t>(blockType);
+        return index < m_textureLayers.size() ? m_textureLayers[index] : m_defaultTextureLayers;
+    }
+    const std::vector<TextureLayerSource>& GetTextureLayerSources() const { return m_textureLayerSources; }
+    
     // Block category checks
     BlockCategory GetBlockCategory(BlockType blockType) const;
     bool IsTransparent(BlockType blockType) const;
@@ -67,9 +101,15 @@ private:
     // Default fallback for unknown blocks
     BlockDefinition m_defaultBlock;
     
+    // Texture array layout, indexed by BlockType value
+    std::vector<BlockTextureLayers> m_textureLayers;
+    std::vector<TextureLayerSource> m_textureLayerSources;
+    BlockTextureLayers m_defaultTextureLayers;
+    
     // Helper functions
     void InitializeDefaultBlocks();
     bool ParseJsonContent(const std::string& jsonContent);
     bool ParseBlocksSection(const std::string& blocksContent);
     void AddBlock(const std::string& blockKey, const BlockDefinition& blockDef);
+    void AssignTextureLayers();
 };
@@ -1,9 +1,13 @@
 #pragma once
 
+#include "BiomeSystem.h"
 #include "Block.h"
 #include "BlockManager.h"
+#include "ChunkMeshPool.h"
+#include "ChunkSection.h"
+#include "ChunkVertex.h"
+#include "GenerationRandom.h"
 #include <array>
-#include <random>
 #include <vector>
 #include <unordered_map> // Added for unordered_map
 
@@ -14,22 +18,56 @@
     #include <epoxy/gl.h>
 #endif
 
-// Forward declaration
+// Forward declarations
 class World;
+struct ChunkMeshData;
 
 // Chunk dimensions
 constexpr int CHUNK_WIDTH = 16;
 constexpr int CHUNK_HEIGHT = 256;
 constexpr int CHUNK_DEPTH = 16;
+constexpr int CHUNK_SECTION_COUNT = CHUNK_HEIGHT / SECTION_SIZE;
+constexpr uint16_t ALL_SECTIONS_MASK = static_cast<uint16_t>((1u << CHUNK_SECTION_COUNT) - 1); // One bit per section
+
+// Vertex data of one mesh group, split by section so sections can be replaced on their own
+using ChunkSectionVertices = std::array<std::vector<ChunkVertex>, CHUNK_SECTION_COUNT>;
+
+// Which faces of a section can see each other through its non-opaque cells, for cave culling:
+// bit (a * 6 + b) is set when faces a and b are joined by a path of non-opaque cells. Face ids
+// follow the mesher: 0 +Z, 1 -Z, 2 -X, 3 +X, 4 -Y, 5 +Y (the opposite face is id ^ 1)
+using SectionVisibility = uint64_t;
+constexpr int SECTION_FACE_COUNT = 6;
+constexpr SectionVisibility SECTION_VISIBILITY_ALL = (1ull << (SECTION_FACE_COUNT * SECTION_FACE_COUNT)) - 1; // Nothing blocks the view
+inline bool AreSectionFacesConnected(SectionVisibility visibility, int faceA, int faceB) {
+    return (visibility >> (faceA * SECTION_FACE_COUNT + faceB)) & 1;
+}
+
+// Per-column heightmaps kept by every chunk (value is -1 when nothing in the column matches)
+enum class HeightmapType {
+    NON_AIR = 0,         // Highest block that is not air
+    SOLID = 1,           // Highest block the player collides with (ground plants excluded)
+    LIGHT_BLOCKING = 2,  // Highest block that stops skylight (not air, water, transparent or ground)
+    COUNT = 3
+};
 
 class Chunk {
 public:
-    // Special grass face types (different textures per face)
-    enum GrassFaceType {
-        GRASS_TOP = 0,
-        GRASS_SIDE = 1, 
-        GRASS_BOTTOM = 2
+    // GPU meshes per chunk. Each pass lives in its own shared ChunkMeshPool and is drawn for all
+    // visible chunks with one submission; water is drawn last with its own shader and blending
+    enum MeshPass {
+        MESH_PASS_SOLID = 0,   // Opaque cubes
+        MESH_PASS_CUTOUT = 1,  // Textures with transparent texels: leaves, glass, ground plants
+        MESH_PASS_WATER = 2,
+        MESH_PASS_COUNT = 3
+    };
+    
+    // Mesh construction strategy, switchable at runtime to compare vertex counts and frame times
+    enum class MeshingMode {
+        PER_FACE = 0,  // One quad per visible block face
+        GREEDY = 1     // Coplanar faces with the same texture and AO merged into larger tiled quads
     };
+    static void SetMeshingMode(MeshingMode mode) { s_meshingMode = mode; }
+    static MeshingMode GetMeshingMode() { return s_meshingMode; }
     
     Chunk();
     Chunk(int chunkX, int chunkZ);
@@ -53,43 +91,102 @@ public:
     void Generate(int seed, const BlockManager* blockManager = nullptr);
     
     // Mesh generation and rendering
-    void GenerateMesh(const World* world, const BlockManager* blockManager = nullptr);
+    void GenerateMesh(const World* world, const BlockManager* blockManager = nullptr); // Build and upload synchronously
+    void ApplyMesh(const ChunkMeshData& meshData); // Main thread: replace the GPU meshes with vertex data built by ChunkMesher
     void UpdateBlockMesh(int x, int y, int z, const World* world, const BlockManager* blockManager = nullptr); // Incremental mesh update for single block
+    static uint16_t GetEditSectionMask(int y); // Sections whose mesh can change when a block at height y changes
     void BatchBlockUpdate(int x, int y, int z, BlockType oldType, BlockType newType); // Queue block update for batching
     void ProcessBatchedUpdates(const World* world, const BlockManager* blockManager); // Process all batched updates at once
-    void RenderMesh() const;
-    void RenderMeshForBlockType(BlockType blockType) const;
-    void RenderGrassMesh(GrassFaceType faceType) const;
-    void RenderLogMesh(GrassFaceType faceType) const;
+    void QueueMeshPass(MeshPass pass, uint16_t sectionMask = ALL_SECTIONS_MASK) const; // Adds the masked sections to the pass pool's draw list
+    
+    // Shared vertex storage of every chunk mesh, one pool per pass. The Renderer owns the pools and
+    // registers them at startup; without pools, meshes are built but not uploaded
+    using MeshPools = std::array<ChunkMeshPool, MESH_PASS_COUNT>;
+    static void SetMeshPools(MeshPools* pools) { s_meshPools = pools; }
     
     // Apply chunk data received from server
-    void ApplyServerData(const uint16_t* blockData);
+    void ApplyServerData(const uint16_t* blockData, const ChunkBiomeMap& biomeMap, const BlockManager* blockManager = nullptr);
     
-    // World generation
-    std::vector<BlockType> GetBlockTypesInChunk() const;
-    bool HasMesh() const { return !m_blockMeshes.empty() || !m_grassFaceMeshes.empty() || !m_logFaceMeshes.empty(); }
+    bool HasMesh() const;
     void ClearMesh();
+    int GetVertexCount() const; // Vertices currently uploaded across all of this chunk's meshes
+    uint16_t GetMeshSectionMask() const; // One bit per section with geometry in any pass
+    
+    // Lowest and highest occupied block Y when the current mesh was captured (-1 when the chunk was empty),
+    // so culling can clip section bounds to the blocks that are actually drawn
+    int GetMeshMinY() const { return m_meshMinY; }
+    int GetMeshMaxY() const { return m_meshMaxY; }
+    bool GetOccupiedYRange(int& minY, int& maxY) const; // Current blocks; false when the chunk is all air
+    SectionVisibility GetSectionVisibility(int sectionY) const { return m_sectionVisibility[sectionY]; } // All connected until meshed
+    
+    // Heightmap queries (local coordinates); O(1) lookups kept current by every block write
+    int GetHeight(int x, int z, HeightmapType type) const { return m_heightmaps[static_cast<int>(type)][z * CHUNK_WIDTH + x]; }
+    int FindHighestBlockBelow(int x, int z, int maxY, HeightmapType type) const; // Highest match at or below maxY
+    
+    // Biome and climate per column, computed once by Generate (or received with server data)
+    const ChunkBiomeMap& GetBiomeMap() const { return m_biomeMap; }
+    BiomeType GetBiome(int x, int z) const { return m_biomeMap.GetBiome(x, z); }
+    void SetBlockManager(const BlockManager* blockManager); // Block categories used to classify heightmaps
+    
+    // Section access (sectionY 0-15, each covering 16 blocks of height)
+    const ChunkSection& GetSection(int sectionY) const { return m_sections[sectionY]; }
+    bool IsSectionEmpty(int sectionY) const { return m_sections[sectionY].IsEmpty(); }
+    bool IsSectionFullyOpaque(int sectionY, const BlockManager* blockManager) const;
+    
+    // Occupancy bitmask queries (local coordinates, not bounds checked): set for every non-air block
+    bool IsOccupied(int x, int y, int z) const { return m_sections[y >> 4].IsOccupied(x, y & 15, z); }
+    uint16_t GetOccupancyRow(int y, int z) const { return m_sections[y >> 4].GetOccupancyRow(y & 15, z); } // Bit x per block
+    
+    // Block storage statistics
+    size_t GetMemoryUsage() const;
+    void CompactStorage(); // Drop unused palette entries after bulk edits
 
 private:
-    // 3D array of blocks [x][y][z]
-    std::array<std::array<std::array<Block, CHUNK_DEPTH>, CHUNK_HEIGHT>, CHUNK_WIDTH> m_blocks;
+    // Palette-compressed block storage, one 16x16x16 section per 16 blocks of height
+    std::array<ChunkSection, CHUNK_SECTION_COUNT> m_sections;
+    
+    // Unchecked block access for generation and meshing loops (local coordinates must be valid)
+    BlockType GetTypeAt(int x, int y, int z) const { return m_sections[y >> 4].Get(x, y & 15, z); }
+    void SetTypeAt(int x, int y, int z, BlockType type) {
+        m_sections[y >> 4].Set(x, y & 15, z, type);
+        UpdateHeightmaps(x, y, z, type);
+    }
+    
+    // Column heightmaps indexed [type][z * 16 + x]
+    std::array<std::array<int16_t, CHUNK_WIDTH * CHUNK_DEPTH>, static_cast<int>(HeightmapType::COUNT)> m_heightmaps;
+    const BlockManager* m_blockManager = nullptr;
+    
+    ChunkBiomeMap m_biomeMap;
+    static_assert(ChunkBiomeMap::WIDTH == CHUNK_WIDTH && ChunkBiomeMap::WIDTH == CHUNK_DEPTH, "Biome maps cover one chunk");
+    
+    bool MatchesHeightmap(BlockType type, HeightmapType heightmap) const;
+    void UpdateHeightmaps(int x, int y, int z, BlockType type);
+    int ScanColumnDown(int x, int z, int startY, HeightmapType type) const;
+    void RebuildHeightmaps();
+    int FindSurfaceBlock(int x, int z, BlockType surfaceType) const;
     
     int m_chunkX;
     int m_chunkZ;
     
-    // Mesh data per block type
-    struct BlockMesh {
-        GLuint VAO = 0;
-        GLuint VBO = 0;
-        int vertexCount = 0;
+    // Mesh data per render pass: one range of the pass's pool per section, so a section can be
+    // rebuilt without touching the rest of the chunk's geometry
+    struct PassMesh {
+        std::array<ChunkMeshPool::Range, CHUNK_SECTION_COUNT> sectionRanges;
+        std::array<int, CHUNK_SECTION_COUNT> sectionCount = {}; // Vertices in use in each range
+        int vertexCount = 0;                                    // Packed vertices in use across all sections, 4 per quad
     };
-    std::unordered_map<BlockType, BlockMesh> m_blockMeshes;
-    
-    // Special mesh data for grass faces (different textures per face)
-    std::unordered_map<GrassFaceType, BlockMesh> m_grassFaceMeshes;
-    std::unordered_map<GrassFaceType, BlockMesh> m_logFaceMeshes;
+    std::array<PassMesh, MESH_PASS_COUNT> m_passMeshes;
     
     bool m_meshGenerated;
+    int m_meshMinY = -1;
+    int m_meshMaxY = -1;
+    std::array<SectionVisibility, CHUNK_SECTION_COUNT> m_sectionVisibility;
+    
+    static MeshingMode s_meshingMode;
+    static MeshPools* s_meshPools;
+    
+    static void UpdateMeshSections(PassMesh& mesh, ChunkMeshPool& pool, const ChunkSectionVertices& sections, uint16_t sectionMask); // Replaces the masked sections
+    static constexpr int SECTION_SLACK_VERTICES = 64; // Spare room (16 quads) reserved when an edited section outgrows its range
     
     // Batched update system for efficiency
     struct PendingBlockUpdate {
@@ -100,49 +197,27 @@ private:
     std::vector<PendingBlockUpdate> m_pendingUpdates;
     bool m_hasPendingUpdates = false;
     
-    // Face culling helpers
-    bool ShouldRenderFace(int x, int y, int z, int faceDirection, const World* world, const BlockManager* blockManager = nullptr) const;
-    Block GetNeighborBlock(int x, int y, int z, int faceDirection, const World* world) const;
-    void AddFaceToMesh(std::vector<float>& vertices, int x, int y, int z, int faceDirection, const World* world, const BlockManager* blockManager, bool flipTextureV = false) const;
-    void AddCrossToMesh(std::vector<float>& vertices, int x, int y, int z, const World* world) const;
-    
-    // Ambient occlusion calculation
-    float CalculateVertexAO(int x, int y, int z, int faceDirection, int vertexIndex, const World* world, const BlockManager* blockManager) const;
-    Block GetBlockAtOffset(int x, int y, int z, int dx, int dy, int dz, const World* world) const;
-    
-    // Face direction constants
-    enum Face {
-        FACE_FRONT = 0,   // +Z
-        FACE_BACK = 1,    // -Z  
-        FACE_LEFT = 2,    // -X
-        FACE_RIGHT = 3,   // +X
-        FACE_BOTTOM = 4,  // -Y
-        FACE_TOP = 5      // +Y
-    };
-    
-    // Perlin noise utilities for world generation
-    double Perlin(double x, double z, int seed) const;
-    double Perlin3D(double x, double y, double z, int seed) const;
-    double Fade(double t) const;
-    double Lerp(double t, double a, double b) const;
-    double Grad(int hash, double x, double z) const;
+    // Section elision helper, shared with the light-blocking heightmap
+    static bool IsOpaqueForCulling(BlockType type, const BlockManager* blockManager);
     
     // Tree generation
-    void GenerateTree(int x, int z, std::mt19937& rng, const BlockManager* blockManager);
-    void GenerateOakTree(int x, int z, int surfaceY, std::mt19937& rng, const BlockManager* blockManager);
-    void GenerateBirchTree(int x, int z, int surfaceY, std::mt19937& rng, const BlockManager* blockManager);
+    void GenerateTree(int x, int z, GenerationRandom& rng, const BlockManager* blockManager);
+    void GenerateOakTree(int x, int z, int surfaceY, GenerationRandom& rng, const BlockManager* blockManager);
+    void GenerateBirchTree(int x, int z, int surfaceY, GenerationRandom& rng, const BlockManager* blockManager);
     
     // Ore generation
     void GenerateOreVeins(int seed);
-    void GenerateOreVein(int startX, int startY, int startZ, BlockType oreType, int maxSize, std::mt19937& rng);
+    void GenerateOreVein(int startX, int startY, int startZ, BlockType oreType, int maxSize, GenerationRandom& rng);
     
     // Terrain generation constants  
-    static constexpr double NOISE_SCALE = 0.03;         // Scale for Perlin noise sampling
-    static constexpr double NOISE_SCALE_FINE = 0.08;    // Fine detail noise scale
-    static constexpr double NOISE_SCALE_COARSE = 0.01;  // Large terrain features scale
+    static constexpr float NOISE_SCALE = 0.03f;         // Scale for Perlin noise sampling
+    static constexpr float NOISE_SCALE_FINE = 0.08f;    // Fine detail noise scale
+    static constexpr float NOISE_SCALE_COARSE = 0.01f;  // Large terrain features scale
     static constexpr int BASE_HEIGHT = 65;              // Base terrain height (above sea level)
     static constexpr int MAX_HEIGHT_VARIATION = 50;     // Maximum hill height above base
     static constexpr int SEA_LEVEL = 60;                // Sea level constant
+    static constexpr float ORE_NOISE_AMPLITUDE = 1.7f;  // Widens the [-1, 1] noise so the ore thresholds keep their old density
+    static constexpr int MAX_ORE_VEIN_SIZE = 8;         // Largest OreConfig::veinSize
     
     // Cave generation constants
     static constexpr double CAVE_NOISE_SCALE = 0.08;    // Scale for cave noise sampling (increased for smaller caves)
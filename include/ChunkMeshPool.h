@@ -0,0 +1,90 @@
+#pragma once
+
+#include "ChunkVertex.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#ifdef __APPLE__
+    #define GL_SILENCE_DEPRECATION
+    #include <OpenGL/gl3.h>
+#else
+    #include <epoxy/gl.h>
+#endif
+
+// Layout of one glMultiDrawElementsIndirect command (GL 4.3 / ARB_multi_draw_indirect)
+struct DrawElementsIndirectCommand {
+    GLuint count;         // Indices, 6 per quad
+    GLuint instanceCount; // Always 1
+    GLuint firstIndex;    // Always 0: every range starts at the first quad of the shared index buffer
+    GLint baseVertex;     // First vertex of the range in its page
+    GLuint baseInstance;  // Unused
+};
+
+// Shared vertex storage for one chunk mesh pass. Chunks sub-allocate their section ranges from a few
+// large fixed-size pages, each one vertex buffer behind one VAO, so meshing and edits never create or
+// delete GL objects once the pages exist, and all visible chunks of a pass are drawn with one
+// multi-draw submission per page instead of a bind and a draw per chunk.
+// Owned by the Renderer (see Chunk::SetMeshPools). Main thread only; every call that touches OpenGL
+// needs a current context.
+class ChunkMeshPool {
+public:
+    // A reserved run of vertices inside one page. capacity is 0 for an unallocated range
+    struct Range {
+        int page = 0;
+        int first = 0;
+        int capacity = 0;
+    };
+
+    ChunkMeshPool() = default;
+    ChunkMeshPool(const ChunkMeshPool&) = delete;
+    ChunkMeshPool& operator=(const ChunkMeshPool&) = delete;
+
+    // Reserves vertexCount vertices (first fit across pages), adding a page when none has a large
+    // enough free run. Returns an empty range for a vertexCount of 0 or one larger than a page.
+    Range Allocate(int vertexCount);
+    void Free(Range& range); // CPU bookkeeping only, safe after Release
+    void Upload(const Range& range, const std::vector<ChunkVertex>& vertices); // vertices.size() <= range.capacity
+    void Release();          // Deletes the GL objects and forgets every allocation
+
+    // Per-frame draw list: queue the visible ranges, then submit them with one call per page
+    void BeginCommands();
+    void AddCommand(const Range& range, int vertexCount); // Extends the page's previous command when the ranges touch
+    void SubmitCommands();
+    int GetCommandCount() const;
+    int GetSubmissionCount() const; // Pages with at least one queued command
+
+    // GPU memory held by the pool: allocated pages and the vertices reserved in them
+    int GetPageCount() const { return static_cast<int>(m_pages.size()); }
+    size_t GetAllocatedBytes() const { return m_pages.size() * PAGE_VERTICES * sizeof(ChunkVertex); }
+    size_t GetReservedBytes() const { return static_cast<size_t>(m_reservedVertices) * sizeof(ChunkVertex); }
+
+    // True when glMultiDrawElementsIndirect is available; otherwise commands are submitted
+    // with glMultiDrawElementsBaseVertex (GL 3.3)
+    static bool SupportsIndirectDraw();
+
+    static constexpr int PAGE_VERTICES = 1 << 20; // 8 MB per page, well above the largest section mesh
+
+private:
+    struct Page {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        std::map<int, int> freeRuns; // first -> length, coalesced
+        std::vector<DrawElementsIndirectCommand> commands;
+    };
+    std::vector<Page> m_pages;
+    int m_reservedVertices = 0;  // Vertices held by live ranges
+    int m_maxRangeVertices = 0;  // Largest range handed out; the shared index buffer must cover it
+    GLuint m_indirectBuffer = 0;
+
+    // Submission arrays, rebuilt each frame from the page command lists
+    std::vector<DrawElementsIndirectCommand> m_indirectCommands;
+    std::vector<GLsizei> m_fallbackCounts;
+    std::vector<GLint> m_fallbackBaseVertices;
+    std::vector<const void*> m_fallbackOffsets;
+
+    bool AddPage();
+    static void AddFreeRun(Page& page, int first, int length);
+    static int64_t GetPageVertexCount(const Page& page); // Vertices referenced by the page's queued commands
+};
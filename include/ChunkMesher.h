@@ -0,0 +1,178 @@
+#pragma once
+
+#include "BlockManager.h"
+#include "Chunk.h"
+#include "ChunkSection.h"
+#include "ChunkVertex.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Forward declaration
+class World;
+
+// Columns in the one-block ring around a chunk (18x18 minus the 16x16 interior)
+constexpr int MESH_BORDER_COLUMN_COUNT = (CHUNK_WIDTH + 2) * (CHUNK_DEPTH + 2) - CHUNK_WIDTH * CHUNK_DEPTH;
+
+// Biome tints are sampled on a world-aligned grid every BIOME_TINT_SPACING blocks, from one grid cell
+// before the chunk to one cell after it. The grid matches the biome map's climate grid, so every
+// point is a column the owning chunk's biome map sampled exactly
+constexpr int BIOME_TINT_SPACING = ChunkBiomeMap::GRID_SPACING;
+constexpr int BIOME_TINT_CELLS = CHUNK_WIDTH / BIOME_TINT_SPACING; // Grid cells per chunk side
+constexpr int BIOME_TINT_POINTS = BIOME_TINT_CELLS + 3;             // Grid points per side, neighbours included
+
+// Immutable copy of everything a mesh build reads: the chunk's own sections plus the neighbouring
+// block columns that face culling and ambient occlusion sample across the chunk border.
+// Captured on the main thread, then read by a mesh worker without touching the World.
+struct ChunkMeshSnapshot {
+    int chunkX = 0;
+    int chunkZ = 0;
+    Chunk::MeshingMode meshingMode = Chunk::MeshingMode::GREEDY;
+    uint16_t sectionMask = ALL_SECTIONS_MASK; // Sections to build; the rest are left out of the result
+    
+    // Biome at each tint grid point, [j * BIOME_TINT_POINTS + i], read from the biome maps of the chunk
+    // and its loaded neighbours. Points of missing neighbours are BiomeType::COUNT; the mesh worker
+    // evaluates those from the world seed
+    std::array<BiomeType, BIOME_TINT_POINTS * BIOME_TINT_POINTS> tintBiomes;
+    int seed = 0;
+    
+    // Occupied block height range of the whole chunk (see Chunk::GetMeshMinY), -1 when it is all air
+    int minOccupiedY = -1;
+    int maxOccupiedY = -1;
+
+    std::array<ChunkSection, CHUNK_SECTION_COUNT> sections;
+    std::array<std::array<BlockType, CHUNK_HEIGHT>, MESH_BORDER_COLUMN_COUNT> borderColumns; // AIR where there is no neighbour
+
+    // One bit per section: set when the section is a single opaque block type
+    uint16_t opaqueSections = 0;
+    std::array<uint16_t, 4> neighborOpaqueSections = {}; // +X, -X, +Z, -Z neighbours (0 when missing)
+
+    // Block lookup for x, z in [-1, 16]; AIR above and below the world
+    BlockType GetType(int x, int y, int z) const {
+        if (y < 0 || y >= CHUNK_HEIGHT) {
+            return BlockType::AIR;
+        }
+        if (x >= 0 && x < CHUNK_WIDTH && z >= 0 && z < CHUNK_DEPTH) {
+            return sections[y >> 4].Get(x, y & 15, z);
+        }
+        return borderColumns[BorderColumnIndex(x, z)][y];
+    }
+
+    // Ring order: the z = -1 row, the z = 16 row (x from -1 to 16), then the x = -1 and x = 16 columns (z from 0 to 15)
+    static int BorderColumnIndex(int x, int z) {
+        if (z < 0) return x + 1;
+        if (z >= CHUNK_DEPTH) return (CHUNK_WIDTH + 2) + x + 1;
+        if (x < 0) return 2 * (CHUNK_WIDTH + 2) + z;
+        return 2 * (CHUNK_WIDTH + 2) + CHUNK_DEPTH + z;
+    }
+};
+
+// CPU-side vertex data for one chunk, one vertex list per render pass and section.
+// Only the sections in sectionMask were built; their vertex lists replace the uploaded ones
+// (an empty list clears the section).
+struct ChunkMeshData {
+    uint16_t sectionMask = ALL_SECTIONS_MASK;
+    int minOccupiedY = -1; // Copied from the snapshot, so the bounds always match the geometry they describe
+    int maxOccupiedY = -1;
+    std::array<SectionVisibility, CHUNK_SECTION_COUNT> sectionVisibility = {}; // Valid for the sections in sectionMask
+    std::array<ChunkSectionVertices, Chunk::MESH_PASS_COUNT> passVertices;
+};
+
+// Builds chunk vertex data from a snapshot. Building makes no OpenGL calls and reads nothing
+// but the snapshot and the (read-only) BlockManager, so it is safe to run on a worker thread.
+class ChunkMesher {
+public:
+    ChunkMesher(const ChunkMeshSnapshot& snapshot, const BlockManager* blockManager);
+
+    // Main thread only: copy the chunk and the border columns of its loaded neighbours
+    static void CaptureSnapshot(ChunkMeshSnapshot& snapshot, const Chunk& chunk, const World* world, const BlockManager* blockManager,
+                                uint16_t sectionMask = ALL_SECTIONS_MASK);
+
+    // Builds every requested section. Not const: the mesher reuses one padded block buffer per section
+    void Build(ChunkMeshData& meshData);
+
+private:
+    // The section being meshed plus a one-block border on every side (18x18x18), so face culling
+    // and ambient occlusion samples are plain array reads with no chunk or section edge checks
+    static constexpr int PADDED_SIZE = SECTION_SIZE + 2;
+    static constexpr int PADDED_VOLUME = PADDED_SIZE * PADDED_SIZE * PADDED_SIZE;
+
+    const ChunkMeshSnapshot& m_snapshot;
+    const BlockManager* m_blockManager;
+    int m_originX; // Chunk corner relative to WORLD_MIN_CHUNK, added to every emitted vertex
+    int m_originZ;
+    std::array<BlockType, PADDED_VOLUME> m_padded;
+    int m_paddedBaseY = 0; // World Y of the padded section's first layer
+
+    // Per-type properties the mesher tests as bits, looked up from the BlockManager once per type
+    enum BlockFlags : uint8_t {
+        BLOCK_FLAG_KNOWN = 1 << 0,       // Entry has been filled in
+        BLOCK_FLAG_CUBE = 1 << 1,        // Meshed as a cube (not air, not a ground plant); also darkens AO
+        BLOCK_FLAG_SEE_THROUGH = 1 << 2, // Does not hide the faces of non-water neighbours
+        BLOCK_FLAG_WATER = 1 << 3,       // Still or flowing water
+        BLOCK_FLAG_CUTOUT = 1 << 4       // Texture has transparent texels; meshed into the cutout pass
+    };
+    std::array<uint8_t, 256> m_typeFlags; // Indexed by BlockType, 0 until looked up
+    
+    // Biome colours per column (RGB555, see ChunkVertex::PackTintColor), indexed [z * 16 + x].
+    // Each tint grid point is averaged with its 8 neighbours, and columns interpolate between grid
+    // points. Neighbouring chunks share grid points, so tints blend across biome borders without
+    // seams at chunk edges.
+    std::array<uint16_t, CHUNK_WIDTH * CHUNK_DEPTH> m_grassTints;
+    std::array<uint16_t, CHUNK_WIDTH * CHUNK_DEPTH> m_foliageTints;
+
+    // Bitmask rows of the padded section: bit (x + 1) of row (localY, z) is set when that block has the flag
+    std::array<uint32_t, PADDED_SIZE * PADDED_SIZE> m_occluderRows;   // BLOCK_FLAG_CUBE
+    std::array<uint32_t, PADDED_SIZE * PADDED_SIZE> m_seeThroughRows; // BLOCK_FLAG_SEE_THROUGH
+    std::array<uint32_t, PADDED_SIZE * PADDED_SIZE> m_waterRows;      // BLOCK_FLAG_WATER
+
+    // Visible cube faces of the section: bit x of m_faceRows[face][localY * 16 + z]
+    std::array<std::array<uint16_t, SECTION_SIZE * SECTION_SIZE>, 6> m_faceRows;
+    
+    // Flood fill scratch: unvisited non-opaque cells as rows (bit x of [localY * 16 + z]) and the cell stack
+    std::array<uint16_t, SECTION_SIZE * SECTION_SIZE> m_unvisitedRows;
+    std::array<uint16_t, SECTION_SIZE * SECTION_SIZE * SECTION_SIZE> m_floodStack;
+
+    // Copies the section and its border out of the snapshot into m_padded and the bitmask rows,
+    // then derives the visible faces of every cell from them
+    void FillPaddedSection(int sectionY);
+    void BuildFaceRows();
+    SectionVisibility ComputeSectionVisibility(); // Flood fill of the padded section's non-opaque cells
+    uint8_t GetTypeFlags(BlockType blockType); // Cached for ids below 256
+    uint8_t ClassifyType(BlockType blockType) const;
+    void ComputeBiomeTints();
+
+    // x, z in [-1, 16] and y within one block of the current section
+    static int PaddedIndex(int x, int localY, int z) { return ((localY + 1) * PADDED_SIZE + (z + 1)) * PADDED_SIZE + (x + 1); }
+    BlockType GetTypeAt(int x, int y, int z) const { return m_padded[PaddedIndex(x, y - m_paddedBaseY, z)]; }
+    static int OccluderRowIndex(int localY, int z) { return (localY + 1) * PADDED_SIZE + (z + 1); }
+    bool IsFaceVisible(int x, int localY, int z, int faceDirection) const { return (m_faceRows[faceDirection][localY * SECTION_SIZE + z] >> x) & 1; }
+
+    bool IsSectionFullyOpaque(int sectionY) const { return (m_snapshot.opaqueSections >> sectionY) & 1; }
+    bool AreSectionNeighborsOpaque(int sectionY) const;
+
+    std::vector<ChunkVertex>& SelectPassVertices(ChunkMeshData& meshData, int sectionY, BlockType blockType) const; // Type must be in the current section
+    uint32_t GetTintColor(BiomeTint tint, int x, int z) const; // Local column
+    void AddSectionPerFace(ChunkMeshData& meshData, int sectionY, bool fullyOpaque) const;
+    void AddSectionGreedy(ChunkMeshData& meshData, int sectionY, bool fullyOpaque) const;
+
+    // Face emission helpers
+    // Texture layer, tint colour and flags come from the block type's BlockTextureLayers
+    void AddFaceToMesh(std::vector<ChunkVertex>& vertices, int x, int y, int z, int faceDirection, BlockType blockType) const;
+    void AddQuadToMesh(std::vector<ChunkVertex>& vertices, int x, int y, int z, int faceDirection, const int extent[3], const uint8_t aoLevels[4], BlockType blockType) const; // extent is in blocks along X, Y, Z
+    void AddCrossToMesh(std::vector<ChunkVertex>& vertices, int x, int y, int z, BlockType blockType) const;
+
+    // AO levels of all four corners of a face (see ChunkVertex.h), in FaceLayout corner order.
+    // Reads the 3x3 occluder ring in front of the face and looks the levels up in one table.
+    void CalculateFaceAOLevels(int x, int y, int z, int faceDirection, uint8_t aoLevels[4]) const;
+
+    // Face direction constants
+    enum Face {
+        FACE_FRONT = 0,   // +Z
+        FACE_BACK = 1,    // -Z
+        FACE_LEFT = 2,    // -X
+        FACE_RIGHT = 3,   // +X
+        FACE_BOTTOM = 4,  // -Y
+        FACE_TOP = 5      // +Y
+    };
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "BlockTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Section dimensions (a chunk column is split into 16 vertical 16x16x16 sections)
+constexpr int SECTION_SIZE = 16;
+constexpr int SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+
+// Palette-compressed storage for one 16x16x16 section of a chunk.
+// Blocks are stored as indices into a small per-section palette of BlockType values.
+// The index width grows (0, 1, 2, 4, 8, 16 bits) only when the palette outgrows it,
+// and a section that holds a single block type collapses to one palette entry with no index data.
+class ChunkSection {
+public:
+    ChunkSection();
+    explicit ChunkSection(BlockType fillType);
+
+    // Block access (section-local coordinates 0-15, not bounds checked)
+    BlockType Get(int x, int y, int z) const { return GetByIndex(ToIndex(x, y, z)); }
+    void Set(int x, int y, int z, BlockType type) { SetByIndex(ToIndex(x, y, z), type); }
+
+    // Linear access using the section's internal index order (see ToIndex)
+    BlockType GetByIndex(int index) const;
+    void SetByIndex(int index, BlockType type);
+
+    // Replace the whole section with a single block type
+    void Fill(BlockType type);
+
+    // Drop palette entries that are no longer referenced and shrink the index width to fit
+    void Compact();
+
+    // Occupancy tracking, kept current by every write
+    int GetNonAirCount() const { return m_nonAirCount; }
+    bool IsEmpty() const { return m_nonAirCount == 0; }
+    bool IsUniform() const { return m_bitsPerEntry == 0; } // Uniform sections always collapse to one entry
+    BlockType GetUniformType() const { return m_palette[0]; } // Only meaningful when IsUniform()
+
+    // Occupancy bitmask (non-air cells), so collision and ray queries skip the palette decode
+    // and can test a whole 16-block row at once
+    bool IsOccupied(int x, int y, int z) const {
+        if (m_occupancy.empty()) {
+            return m_palette[0] != BlockType::AIR;
+        }
+        int index = ToIndex(x, y, z);
+        return (m_occupancy[index >> 6] >> (index & 63)) & 1;
+    }
+    uint16_t GetOccupancyRow(int y, int z) const { // Bit x set for each non-air cell of the row
+        if (m_occupancy.empty()) {
+            return m_palette[0] != BlockType::AIR ? 0xFFFF : 0;
+        }
+        return static_cast<uint16_t>(m_occupancy[ToIndex(0, y, z) >> 6] >> ((z & 3) << 4));
+    }
+    
+    // Storage statistics
+    size_t GetPaletteSize() const { return m_palette.size(); }
+    int GetBitsPerEntry() const { return m_bitsPerEntry; }
+    size_t GetMemoryUsage() const;
+
+    // Index order is x fastest, then z, then y, so horizontal layers are contiguous
+    static int ToIndex(int x, int y, int z) { return (y << 8) | (z << 4) | x; }
+
+private:
+    std::vector<BlockType> m_palette;       // Block types referenced by this section
+    std::vector<uint16_t> m_paletteCounts;  // Number of cells using each palette entry
+    std::vector<uint64_t> m_data;           // Bit-packed palette indices (empty when single-entry)
+    int m_bitsPerEntry;                     // 0 when the palette has a single entry
+    int m_entriesPerWordShift;              // log2(64 / m_bitsPerEntry)
+    int m_bitShift;                         // log2(m_bitsPerEntry)
+    int m_nonAirCount;                      // Number of cells that are not AIR
+    std::vector<uint64_t> m_occupancy;      // One bit per cell in index order, set when not AIR (empty when single-entry)
+
+    uint32_t GetPaletteIndex(int index) const;
+    void SetPaletteIndex(int index, uint32_t paletteIndex);
+    uint32_t FindOrAddPaletteEntry(BlockType type);
+    void Repack(int newBitsPerEntry);
+    static int BitsForPaletteSize(size_t paletteSize);
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __APPLE__
+    #define GL_SILENCE_DEPRECATION
+    #include <OpenGL/gl3.h>
+#else
+    #include <epoxy/gl.h>
+#endif
+
+// Face ids stored in the packed vertex. 0-5 match Chunk's cube faces,
+// 6 and 7 are the two diagonal planes of a cross sprite.
+constexpr int CHUNK_VERTEX_FACE_CROSS_A = 6; // Diagonal from (-x, -z) to (+x, +z)
+constexpr int CHUNK_VERTEX_FACE_CROSS_B = 7; // Diagonal from (-x, +z) to (+x, -z)
+
+// Per-vertex flags
+constexpr uint32_t CHUNK_VERTEX_FLAG_LOWERED_TOP = 1u << 0; // Water surface sits 1/16 below the block top
+constexpr uint32_t CHUNK_VERTEX_FLAG_FLIP_V = 1u << 1;      // Texture v runs top to bottom (grass sides)
+constexpr uint32_t CHUNK_VERTEX_FLAG_OVERLAY = 1u << 2;     // Texture layer + 1 is a tinted overlay drawn over the layer (grass sides)
+
+// Tint colours are RGB555 (5 bits per channel, red lowest); white leaves the texture unchanged
+constexpr uint32_t CHUNK_VERTEX_TINT_WHITE = 0x7FFFu;
+
+// AO levels: 0-3 occluding neighbours (scaled by the face shade in the shader), 4 = both sides occluded
+constexpr int AO_LEVEL_COUNT = 5;
+constexpr int AO_LEVEL_FULLY_OCCLUDED = 4;
+
+// Packed 8-byte chunk vertex, decoded in vertex.glsl and water_vertex.glsl.
+// Positions are integer block-corner coordinates relative to the world's minimum corner (see WORLD_MIN_CHUNK),
+// so every chunk in the shared mesh pools is drawn with the same model matrix. Texture coordinates are derived from the position
+// and face in the shader, so merged quads tile their texture without storing UVs.
+struct ChunkVertex {
+    uint32_t position;   // x (10 bits) | z (10 bits) << 10 | y (9 bits) << 20 | face (3 bits) << 29
+    uint32_t attributes; // AO level (3 bits) | corner (2 bits) << 3 | flags (3 bits) << 5 | texture layer (9 bits) << 8 | tint colour (15 bits) << 17
+
+    // layer indexes the renderer's block texture array; tintColor is RGB555 (see PackTintColor)
+    static ChunkVertex Pack(int x, int y, int z, int face, int aoLevel, int corner, uint32_t flags, int layer = 0,
+                            uint32_t tintColor = CHUNK_VERTEX_TINT_WHITE) {
+        ChunkVertex vertex;
+        vertex.position = (static_cast<uint32_t>(x) & 0x3FFu) |
+                          ((static_cast<uint32_t>(z) & 0x3FFu) << 10) |
+                          ((static_cast<uint32_t>(y) & 0x1FFu) << 20) |
+                          ((static_cast<uint32_t>(face) & 0x7u) << 29);
+        vertex.attributes = (static_cast<uint32_t>(aoLevel) & 0x7u) |
+                            ((static_cast<uint32_t>(corner) & 0x3u) << 3) |
+                            ((flags & 0x7u) << 5) |
+                            ((static_cast<uint32_t>(layer) & 0x1FFu) << 8) |
+                            ((tintColor & 0x7FFFu) << 17);
+        return vertex;
+    }
+    
+    // Channels in [0, 1]
+    static uint32_t PackTintColor(float r, float g, float b) {
+        auto channel = [](float value) {
+            value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+            return static_cast<uint32_t>(value * 31.0f + 0.5f);
+        };
+        return channel(r) | (channel(g) << 5) | (channel(b) << 10);
+    }
+};
+static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+
+// Index buffer shared by every quad mesh: quad q uses vertices 4q..4q+3 as triangles (0,1,2) and (2,3,0).
+// Quads must therefore emit their corners in an order that gives the intended winding.
+class QuadIndexBuffer {
+public:
+    // Returns the shared buffer, growing it in place so it covers at least quadCount quads.
+    // Must be called with a current GL context; VAOs keep referencing the same buffer name.
+    static GLuint Acquire(size_t quadCount);
+    static void Release();
+    static size_t GetByteSize() { return s_quadCapacity * INDICES_PER_QUAD * sizeof(uint32_t); }
+
+    static constexpr int INDICES_PER_QUAD = 6;
+    static constexpr int VERTICES_PER_QUAD = 4;
+
+private:
+    static GLuint s_buffer;
+    static size_t s_quadCapacity;
+};
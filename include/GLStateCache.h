@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef __APPLE__
+    #define GL_SILENCE_DEPRECATION
+    #include <OpenGL/gl3.h>
+#else
+    #include <epoxy/gl.h>
+#endif
+
+// Thin filter in front of the OpenGL state the renderer switches every frame: the bound program,
+// VAO and textures, the depth test, blending and face culling capabilities, the blend function and
+// the depth write mask. A call that would set what is already current is skipped instead of
+// reaching the driver. Each pass sets the state it needs rather than restoring what it changed.
+// The cache starts out matching a new context. State changed behind its back (ImGui, other
+// libraries) must be followed by Invalidate, which the Renderer does when it initializes and at the
+// start of every frame. Main thread only, like every GL call.
+class GLStateCache {
+public:
+    // Calls since the last ResetStats: forwarded to OpenGL, and skipped as redundant
+    struct Stats {
+        int issued = 0;
+        int skipped = 0;
+    };
+
+    static void UseProgram(GLuint program);
+    static void BindVertexArray(GLuint vao);
+    static void ActiveTexture(GLenum unit);                 // GL_TEXTURE0 + n
+    static void BindTexture(GLenum target, GLuint texture); // On the active unit
+    static void SetEnabled(GLenum capability, bool enabled); // GL_DEPTH_TEST, GL_BLEND or GL_CULL_FACE are tracked
+    static void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+    static void DepthMask(bool writeDepth);
+
+    // Forgets every tracked value, so the next call of each kind reaches OpenGL
+    static void Invalidate();
+
+    static const Stats& GetStats() { return s_stats; }
+    static void ResetStats() { s_stats = Stats(); }
+
+    static constexpr int TRACKED_TEXTURE_UNITS = 4; // Bindings on higher units are always forwarded
+
+private:
+    static constexpr GLuint UNKNOWN_NAME = 0xFFFFFFFFu;
+    static constexpr int UNKNOWN_FLAG = -1;
+
+    // Tracked texture targets, indexed [unit][TextureTargetIndex]
+    enum TrackedTarget {
+        TRACKED_TEXTURE_2D = 0,
+        TRACKED_TEXTURE_2D_ARRAY,
+        TRACKED_TARGET_COUNT
+    };
+    static int TextureTargetIndex(GLenum target); // -1 when the target is not tracked
+
+    // Tracked capabilities, indexed by CapabilityIndex
+    enum TrackedCapability {
+        TRACKED_DEPTH_TEST = 0,
+        TRACKED_BLEND,
+        TRACKED_CULL_FACE,
+        TRACKED_CAPABILITY_COUNT
+    };
+    static int CapabilityIndex(GLenum capability); // -1 when the capability is not tracked
+
+    // Returns true when value differs from cached (or cached is unknown) and records it
+    template <typename T>
+    static bool Update(T& cached, T value) {
+        if (cached == value) {
+            ++s_stats.skipped;
+            return false;
+        }
+        cached = value;
+        ++s_stats.issued;
+        return true;
+    }
+
+    static GLuint s_program;
+    static GLuint s_vertexArray;
+    static GLenum s_activeTexture;
+    static GLuint s_textures[TRACKED_TEXTURE_UNITS][TRACKED_TARGET_COUNT];
+    static int s_capabilities[TRACKED_CAPABILITY_COUNT]; // 0, 1 or UNKNOWN_FLAG
+    static GLenum s_blendSource;
+    static GLenum s_blendDestination;
+    static int s_depthMask;
+    static Stats s_stats;
+};
@@ -135,6 +135,7 @@ private:
     struct PendingChunkData {
         int32_t chunkX, chunkZ;
         std::vector<uint16_t> blockData; // Copy the block data
+        ChunkBiomeMap biomeMap;
     };
     std::queue<PendingChunkData> m_pendingChunkData;
     std::mutex m_pendingChunkDataMutex;
@@ -192,6 +193,10 @@ private:
     // UI visibility toggle
     bool m_showUI;
     
+    // GPU pass timings and draw statistics (F3), see GpuProfiler
+    bool m_showPerformanceWindow;
+    std::string m_profileExportMessage; // Result of the last CSV export
+    
     // Hotbar selection
     int m_selectedHotbarSlot;
     
@@ -213,6 +218,7 @@ private:
     void RenderCustomHotbarSlot(const InventorySlot& slot, float x, float y, float size, int slotIndex, bool isSelected);
     void RenderCursorItem(); // Render item following mouse cursor
     void RenderHotbar();
+    void RenderPerformanceWindow();
     
     // Inventory interaction helpers
     void HandleSlotClick(int slotIndex);
@@ -240,7 +246,7 @@ private:
     void OnMyPlayerIdReceived(uint32_t myPlayerId); // Handle receiving own player ID
     void OnBlockBreakReceived(uint32_t playerId, int32_t x, int32_t y, int32_t z);
     void OnBlockUpdateReceived(uint32_t playerId, int32_t x, int32_t y, int32_t z, uint16_t blockType);
-    void OnChunkDataReceived(int32_t chunkX, int32_t chunkZ, const uint16_t* blockData);
+    void OnChunkDataReceived(int32_t chunkX, int32_t chunkZ, const uint16_t* blockData, const ChunkBiomeMap& biomeMap);
     
     // Centralized spawn position calculation
     Vec3 CalculateSpawnPosition() const;
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+// Stateless counter-based random numbers for world generation. A stream is keyed by a hash of
+// (world seed, feature, two coordinates), and its n-th value is the SplitMix64 output at position n
+// of that key, so every value can be computed on its own. No generator state is shared between
+// chunks, columns or threads, and a feature can be re-evaluated for a single column without
+// replaying the rest of its chunk. The Next* calls read a stream in order by advancing a counter.
+class GenerationRandom {
+public:
+    // Each use of randomness in generation has its own id, so no two features draw the same values.
+    // The ids shape every generated world: append new ones, never renumber
+    enum Feature : uint32_t {
+        FEATURE_TERRAIN_NOISE = 1, // Noise seeds; index = octave
+        FEATURE_CLIMATE_NOISE,     // Noise seeds; index = temperature 0-2, humidity 3-5, river 6-7
+        FEATURE_ORE_NOISE,         // Noise seeds; index = ore block type
+        FEATURE_CAVES,             // Per chunk; a substream per worm
+        FEATURE_ORES,              // Per chunk; a substream per ore type, then per vein
+        FEATURE_TREES,             // Per world column
+        FEATURE_VEGETATION         // Per world column
+    };
+
+    GenerationRandom(int seed, Feature feature, int x, int z)
+        : m_key(Mix(Mix(Pack(static_cast<uint32_t>(seed), feature)) ^ Pack(static_cast<uint32_t>(x), static_cast<uint32_t>(z)))) {}
+
+    // The index-th value of the stream, independent of any other draw
+    uint64_t At(uint64_t index) const { return Mix(m_key + (index + 1) * GOLDEN_GAMMA); }
+
+    // Independent stream for one part of a feature, such as a single cave worm
+    GenerationRandom Substream(uint64_t id) const { return GenerationRandom(Mix(m_key ^ Mix(id + GOLDEN_GAMMA))); }
+
+    uint32_t NextUInt() { return static_cast<uint32_t>(At(m_counter++) >> 32); }
+
+    // Uniform in [0, bound) for bound > 0, by multiply-shift rather than the biased modulo
+    int NextInt(int bound) {
+        return static_cast<int>((static_cast<uint64_t>(NextUInt()) * static_cast<uint32_t>(bound)) >> 32);
+    }
+
+    // Uniform in [0, 1), from the top 24 bits
+    float NextFloat() { return static_cast<float>(NextUInt() >> 8) * (1.0f / 16777216.0f); }
+
+    // Seed for the index-th noise layer of a feature, so layers never share a permutation table
+    static int DeriveSeed(int seed, Feature feature, int index) {
+        return static_cast<int>(static_cast<uint32_t>(GenerationRandom(seed, feature, index, 0).At(0) >> 32));
+    }
+
+private:
+    explicit GenerationRandom(uint64_t key) : m_key(key) {}
+
+    static uint64_t Pack(uint32_t high, uint32_t low) { return (static_cast<uint64_t>(high) << 32) | low; }
+
+    // SplitMix64 finalizer
+    static uint64_t Mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull; // SplitMix64 increment
+
+    uint64_t m_key;
+    uint64_t m_counter = 0;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#ifdef __APPLE__
+    #define GL_SILENCE_DEPRECATION
+    #include <OpenGL/gl3.h>
+#else
+    #include <epoxy/gl.h>
+#endif
+
+// Per-frame rendering measurements: GPU time of each render pass from GL_TIME_ELAPSED queries,
+// plus CPU-side counts of draw calls, vertices, GL state calls and buffer bytes uploaded.
+// Queries are kept for QUERY_FRAMES frames before their results are read, so reading them never
+// waits on the GPU; a frame's timings therefore arrive QUERY_FRAMES - 1 frames after its counters.
+// Frames run from one BeginFrame to the next. Main thread only, like every GL call.
+class GpuProfiler {
+public:
+    enum Pass {
+        PASS_SKY = 0,
+        PASS_OPAQUE,   // Solid chunk pass
+        PASS_CUTOUT,   // Cutout chunk pass
+        PASS_WATER,
+        PASS_PLAYERS,  // Remote players
+        PASS_ARM,      // First-person arm
+        PASS_IMGUI,
+        PASS_COUNT
+    };
+
+    struct FrameStats {
+        uint64_t frame = 0;
+        float cpuFrameMs = 0.0f;          // Wall time from this frame's BeginFrame to the next
+        float passMs[PASS_COUNT] = {};    // GPU time per pass
+        bool passTimed[PASS_COUNT] = {};  // False when the pass did not run or its result was not ready
+        int drawCalls = 0;                // Draw API calls; a multi-draw submission counts once
+        int64_t vertices = 0;             // Vertices submitted, times the instance count
+        int stateCalls = 0;               // GL state calls GLStateCache forwarded
+        int stateCallsSkipped = 0;        // Redundant ones it filtered out
+        size_t uploadBytes = 0;           // Bytes written to buffer objects
+
+        float GetGpuTotalMs() const;      // Sum of the timed passes
+    };
+
+    static bool Initialize(); // Creates the query objects; needs a current context
+    static void Shutdown();
+
+    // Closes the previous frame and collects the oldest outstanding query results
+    static void BeginFrame();
+
+    // Times the GL commands between the two calls. Passes cannot nest, and each runs at most once per
+    // frame; a BeginPass that breaks either rule is ignored, along with its EndPass
+    static void BeginPass(Pass pass);
+    static void EndPass(Pass pass);
+
+    static void CountDraw(int64_t vertices, int instances = 1);
+    static void CountDraws(int drawCalls, int64_t vertices); // Several draws at once (ImGui's draw lists)
+    static void CountUpload(size_t bytes);
+
+    // Newest frame whose GPU timings have arrived, and up to HISTORY_FRAMES frames before it (oldest first)
+    static const FrameStats& GetLastFrame() { return s_lastFrame; }
+    static const std::deque<FrameStats>& GetHistory() { return s_history; }
+
+    // Writes the history as CSV, one row per frame; untimed passes are left empty
+    static bool ExportCSV(const std::string& filepath);
+
+    static const char* GetPassName(Pass pass);
+
+    static constexpr int QUERY_FRAMES = 3;
+    static constexpr size_t HISTORY_FRAMES = 600; // About ten seconds at 60 FPS
+
+private:
+    // One set of queries per buffered frame, with the counters of the frame that issued them
+    struct QueryFrame {
+        GLuint queries[PASS_COUNT] = {};
+        bool issued[PASS_COUNT] = {};
+        FrameStats stats;
+        bool recorded = false; // Holds a finished frame waiting for its timings
+    };
+
+    static QueryFrame s_queryFrames[QUERY_FRAMES];
+    static int s_currentQueryFrame;
+    static int s_activePass; // -1 when no query is running
+    static bool s_initialized;
+    static FrameStats s_current;
+    static FrameStats s_lastFrame;
+    static std::deque<FrameStats> s_history;
+    static std::chrono::steady_clock::time_point s_frameStart;
+};
@@ -39,7 +39,7 @@ public:
     void SetGameTimeCallback(std::function<void(float gameTime)> callback);
     void SetBlockBreakCallback(std::function<void(uint32_t playerId, int32_t x, int32_t y, int32_t z)> callback);
     void SetBlockUpdateCallback(std::function<void(uint32_t playerId, int32_t x, int32_t y, int32_t z, uint16_t blockType)> callback);
-    void SetChunkDataCallback(std::function<void(int32_t chunkX, int32_t chunkZ, const uint16_t* blockData)> callback);
+    void SetChunkDataCallback(std::function<void(int32_t chunkX, int32_t chunkZ, const uint16_t* blockData, const ChunkBiomeMap& biomeMap)> callback);
     void SetMyPlayerIdCallback(std::function<void(uint32_t myPlayerId)> callback); // New callback for receiving own player ID
     
     // Get other players
@@ -71,7 +71,7 @@ private:
     std::function<void(float)> m_onGameTime;
     std::function<void(uint32_t, int32_t, int32_t, int32_t)> m_onBlockBreak;
     std::function<void(uint32_t, int32_t, int32_t, int32_t, uint16_t)> m_onBlockUpdate;
-    std::function<void(int32_t, int32_t, const uint16_t*)> m_onChunkData;
+    std::function<void(int32_t, int32_t, const uint16_t*, const ChunkBiomeMap&)> m_onChunkData;
     std::function<void(uint32_t)> m_onMyPlayerId; // Callback for receiving own player ID
     
     // Thread-safe outgoing message queue
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Seeded 2D gradient noise (improved Perlin noise) in single precision, shared by terrain, ore and
+// climate generation. Gradients are picked through a 256-entry permutation table shuffled from the
+// seed, so the pattern repeats every 256 units of noise space; results lie in [-1, 1].
+//
+// The batched calls evaluate a 16-wide row or a 16x16 grid of integer world columns in one call
+// with SSE2 or AVX2 kernels, chosen at startup from what the CPU supports (scalar elsewhere). Every
+// kernel performs the same float operations in the same order as Sample, so a column gets the same
+// bits from any kernel on any machine; clients rebuild terrain from the seed and rely on this. The
+// build compiles PerlinNoise.cpp without multiply-add contraction to keep the scalar path unfused,
+// and a kernel is only used after VerifyKernel finds it bit-identical to SampleColumn. Instances are
+// immutable and thread-safe.
+class PerlinNoise {
+public:
+    enum class Kernel {
+        SCALAR = 0,
+        SSE2,
+        AVX2
+    };
+
+    explicit PerlinNoise(int seed);
+
+    // One sample at a point in noise space
+    float Sample(float x, float z) const;
+
+    // World column (worldX, worldZ) scaled by frequency; the batched calls sample exactly these points
+    float SampleColumn(int worldX, int worldZ, float frequency) const {
+        return Sample(static_cast<float>(worldX) * frequency, static_cast<float>(worldZ) * frequency);
+    }
+
+    // Columns worldX .. worldX + 15 of row worldZ into out[0..15]
+    void SampleRow(int worldX, int worldZ, float frequency, float* out) const;
+
+    // Columns [worldX, worldX + 16) x [worldZ, worldZ + 16) into out[z * 16 + x]
+    void SampleGrid(int worldX, int worldZ, float frequency, float* out) const;
+
+    // Kernel used by the batched calls. SetKernel is for comparing kernels; an unsupported or
+    // mismatching choice falls back to the best usable one below it
+    static Kernel GetKernel() { return s_kernel; }
+    static void SetKernel(Kernel kernel);
+    static bool IsKernelSupported(Kernel kernel);
+    
+    // Compares the kernel's rows with SampleColumn bit for bit over a spread of seeds, frequencies
+    // and coordinates, negative ones included; reports the first mismatch to std::cerr
+    static bool VerifyKernel(Kernel kernel);
+    static const char* GetKernelName(Kernel kernel);
+
+    static constexpr int BATCH_WIDTH = 16;
+
+private:
+    // The table stored twice, so p[p[x] + z + 1] never needs wrapping; 32-bit entries for AVX2 gathers
+    std::array<int32_t, 512> m_permutation;
+
+    void SampleRowScalar(int worldX, int worldZ, float frequency, float* out) const;
+    void SampleRowSSE2(int worldX, int worldZ, float frequency, float* out) const;
+    void SampleRowAVX2(int worldX, int worldZ, float frequency, float* out) const;
+    void SampleRowWith(Kernel kernel, int worldX, int worldZ, float frequency, float* out) const;
+
+    static Kernel DetectKernel();
+    static Kernel s_kernel;
+};
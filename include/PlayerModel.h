@@ -11,6 +11,16 @@
 #include <random>
 #include "Player.h"
 
+// One remote player for PlayerModel::RenderInstanced, laid out as the per-instance attributes
+// of player_instanced_vertex.glsl
+struct PlayerInstance {
+    float x, y, z;   // Feet position
+    float yaw;       // Degrees
+    float pitch;     // Degrees; tilts the head
+    float walkPhase; // Radians; arms and legs swing with sin(walkPhase), standing straight at multiples of pi
+    float skinLayer; // Layer of the skin texture array, below GetSkinLayerCount()
+};
+
 class PlayerModel {
 public:
     PlayerModel();
@@ -18,7 +28,11 @@ public:
 
     bool Initialize();
     void Shutdown();
-    void Render(const Vec3& position, float yaw = 0.0f, float pitch = 0.0f);
+    
+    // Draws every instance with one glDrawArraysInstanced call. The caller binds the instanced
+    // player program (player_instanced_vertex.glsl), which samples the skin array from unit 0
+    void RenderInstanced(const std::vector<PlayerInstance>& instances);
+    int GetSkinLayerCount() const { return m_skinLayerCount; }
     
     // First-person arm rendering (like Minecraft)
     void RenderFirstPersonArm(const Player& player);
@@ -39,13 +53,24 @@ public:
     void SetSkin(const std::string& skinName);
 
 private:
+    // Body parts of the instanced mesh, in vertex order; the vertex shader places each one by this id
+    enum BodyPart {
+        BODY_PART_HEAD = 0,
+        BODY_PART_TORSO,
+        BODY_PART_LEFT_ARM,
+        BODY_PART_RIGHT_ARM,
+        BODY_PART_LEFT_LEG,
+        BODY_PART_RIGHT_LEG,
+        BODY_PART_COUNT
+    };
+    static constexpr int VERTICES_PER_PART = 36;  // 6 faces * 6 vertices
+    static constexpr int INSTANCED_VERTEX_FLOATS = 6; // x, y, z, u, v, body part
+    
     // OpenGL objects
-    unsigned int m_headVAO, m_headVBO;
-    unsigned int m_torsoVAO, m_torsoVBO;
-    unsigned int m_leftArmVAO, m_leftArmVBO;
-    unsigned int m_rightArmVAO, m_rightArmVBO;
-    unsigned int m_leftLegVAO, m_leftLegVBO;
-    unsigned int m_rightLegVAO, m_rightLegVBO;
+    unsigned int m_rightArmVAO, m_rightArmVBO; // First-person arm
+    unsigned int m_instancedVAO;
+    unsigned int m_instancedVBO;  // Every body part, relative to its own centre
+    unsigned int m_instanceVBO;   // PlayerInstance per player, refilled each frame
     
     // Shader uniforms (set by Renderer)
     unsigned int m_shaderProgram;
@@ -55,6 +80,8 @@ private:
     std::vector<std::string> m_availableSkins;
     std::vector<unsigned int> m_skinTextures;
     unsigned int m_currentSkinTexture;
+    unsigned int m_skinArrayTexture; // GL_TEXTURE_2D_ARRAY of every 64x64 skin, used by the instanced players
+    int m_skinLayerCount;
     std::mt19937 m_randomGenerator;
     
     // First-person arm animation
@@ -63,10 +90,8 @@ private:
     float m_punchAnimationDuration;
     
     // Geometry generation
-    void CreateHeadGeometry();
-    void CreateTorsoGeometry();
     void CreateArmGeometry(unsigned int& vao, unsigned int& vbo, const std::vector<std::vector<float>>& uvMapping);
-    void CreateLegGeometry(unsigned int& vao, unsigned int& vbo, const std::vector<std::vector<float>>& uvMapping);
+    void CreateInstancedGeometry();
     
     // Helper function to create cube geometry with specific dimensions and UV coordinates
     std::vector<float> CreateCubeVerticesWithUV(float width, float height, float depth, 
@@ -82,11 +107,10 @@ private:
     std::vector<std::vector<float>> GetLeftLegUVMapping();
     
     // Utility functions
-    unsigned int LoadSkinTexture(const std::string& skinPath);
+    unsigned int LoadSkinTexture(const std::string& skinPath, std::vector<unsigned char>& skinLayers); // Appends 64x64 skins to skinLayers
+    void CreateSkinArrayTexture(const std::vector<unsigned char>& skinLayers);
     
     // Matrix operations
     Mat4 CreateScaleMatrix(float sx, float sy, float sz);
-    Mat4 CreateRotationYMatrix(float angle);
-    Mat4 CreateTranslationMatrix(float x, float y, float z);
     Mat4 MultiplyMatrices(const Mat4& a, const Mat4& b);
 }; 
\ No newline at end of file
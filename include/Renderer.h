@@ -14,6 +14,7 @@
 #include "Server.h" // For PlayerPosition
 #include "Block.h"
 #include "BlockManager.h"
+#include "Chunk.h"
 #include "PlayerModel.h"
 
 class World;
@@ -57,13 +58,13 @@ public:
     void SetViewport(int width, int height);
     
     // 3D rendering
-    void BeginFrame(const Player& player);
-    void RenderWorld(const World& world, float gameTime);
-    void RenderChunks(const World& world, float gameTime);  // New chunk-based rendering
+    void BeginFrame(const Player& player, float gameTime); // Uploads the per-frame uniform buffer (FrameData)
+    void RenderWorld(const World& world);
+    void RenderChunks(const World& world);  // New chunk-based rendering
     void RenderCube(float x, float y, float z);  // Legacy individual cube rendering
     void RenderOtherPlayers(const std::vector<PlayerPosition>& playerPositions);
     void RenderFirstPersonArm(const Player& player); // First-person arm like in Minecraft
-    void RenderSky(float gameTime); // Render sky with sun/moon based on time
+    void RenderSky(); // Render sky with sun/moon based on the frame's game time
     void EndFrame();
     
     // First-person arm animation
@@ -78,12 +79,16 @@ public:
 
     // Frustum culling methods
     void ExtractFrustum(const Mat4& viewMatrix, const Mat4& projMatrix);
-    bool IsChunkInFrustum(int chunkX, int chunkZ) const;
+    uint16_t CullChunkSections(const Chunk& chunk); // Sections of the chunk's mesh that intersect the frustum
     bool IsAABBInFrustum(const AABB& aabb) const;
     
-    // Debug flag to disable frustum culling temporarily
-    // Starting with culling disabled until we verify it works correctly with 70° FOV
-    bool m_enableFrustumCulling = false;
+    // Cave culling: marks the sections reachable from the camera's section through faces each section
+    // connects (see SectionVisibility). Returns false when the camera is outside the world
+    bool TraverseVisibleSections(const World& world);
+    
+    // Debug toggles (F1 for frustum culling); both are on by default
+    bool m_enableFrustumCulling = true;
+    bool m_enableCaveCulling = true;
 
     // Texture access for UI rendering
     unsigned int GetHotbarTexture() const { return m_hotbarTexture; }
@@ -93,6 +98,23 @@ public:
     unsigned int LoadItemTexture(const std::string& itemIconPath);
     unsigned int GetItemTexture(const std::string& itemIconPath);
     unsigned int GetHotbarSelectionTexture() const { return m_hotbarSelectionTexture; }
+    
+    // Chunk draw statistics from the last RenderChunks call
+    int GetChunkDrawSubmissions() const { return m_chunkDrawSubmissions; } // One per non-empty pool page
+    int GetChunkDrawCommands() const { return m_chunkDrawCommands; }       // Section ranges across all passes
+    
+    // Section culling statistics from the last RenderChunks call. Tested counts the sections with geometry
+    // in meshed chunks; culled ones were outside the frustum or, for occluded ones, not reached by cave culling
+    int GetSectionsTested() const { return m_sectionsTested; }
+    int GetSectionsCulled() const { return m_sectionsCulled; }
+    int GetSectionsOccluded() const { return m_sectionsOccluded; }
+    int GetSectionsDrawn() const { return m_sectionsTested - m_sectionsCulled; }
+    
+    // GPU memory held by chunk meshes: pool pages plus the shared quad index buffer (allocated),
+    // and the part of the pages reserved by live section ranges
+    size_t GetChunkMeshAllocatedBytes() const;
+    size_t GetChunkMeshReservedBytes() const;
+    int GetChunkMeshPageCount() const;
 
     // Block management (public for world generation access)
     BlockManager m_blockManager;
@@ -111,40 +133,41 @@ private:
     unsigned int m_wireframeVAO;
     unsigned int m_wireframeVBO;
     unsigned int m_wireframeShaderProgram;
-    int m_wireframeModelLoc, m_wireframeViewLoc, m_wireframeProjLoc;
+    int m_wireframeModelLoc;
     
     // Player model rendering
     PlayerModel m_playerModel;
     unsigned int m_playerShaderProgram;
     int m_playerModelLoc, m_playerViewLoc, m_playerProjLoc;
     
+    // Remote players, drawn together with one instanced call (player_instanced_vertex.glsl)
+    unsigned int m_playerInstancedShaderProgram;
+    std::vector<PlayerInstance> m_playerInstances; // Rebuilt every frame
+    
+    // Walk animation of each remote player, advanced by the distance they moved since the last frame
+    struct RemotePlayerWalk {
+        float x = 0.0f, z = 0.0f; // Position last frame
+        float phase = 0.0f;       // PlayerInstance::walkPhase
+        bool seen = false;        // In this frame's player list; entries of players who left are dropped
+    };
+    std::unordered_map<uint32_t, RemotePlayerWalk> m_remotePlayerWalks;
+    static constexpr float WALK_PHASE_PER_BLOCK = 4.0f; // Radians of walk phase per block moved
+    static constexpr float WALK_SETTLE_STEP = 0.15f;    // Radians per frame the limbs swing back while standing
+    static constexpr float WALK_MAX_STEP = 2.0f;        // Longer moves in one frame are teleports and do not animate
+    
     // Sky rendering
     unsigned int m_skyVAO;
     unsigned int m_skyVBO;
     unsigned int m_skyShaderProgram;
-    int m_skyViewLoc, m_skyProjLoc, m_skyGameTimeLoc, m_skySunDirLoc;
     
     // Water rendering
     unsigned int m_waterShaderProgram;
-    int m_waterModelLoc, m_waterViewLoc, m_waterProjLoc, m_waterTimeLoc;
-    int m_waterGameTimeLoc, m_waterCameraPosLoc, m_waterSunDirLoc;
-    
-    // Texture management
-    std::unordered_map<BlockType, unsigned int> m_blockTextures;
-    
-    // Special grass block textures (different per face)
-    unsigned int m_grassTopTexture;
-    unsigned int m_grassSideTexture;
-    unsigned int m_grassSideOverlayTexture;
-    unsigned int m_grassBottomTexture;
-    
-    // Log block textures (different per face, no overlay)
-    unsigned int m_oakLogTopTexture;
-    unsigned int m_oakLogSideTexture;
-    unsigned int m_birchLogTopTexture;
-    unsigned int m_birchLogSideTexture;
-    unsigned int m_darkOakLogTopTexture;
-    unsigned int m_darkOakLogSideTexture;
+    int m_waterModelLoc;
+    
+    // Block textures: one GL_TEXTURE_2D_ARRAY layer per BlockManager texture layer source, so every
+    // solid block of a chunk draws with a single bound texture
+    unsigned int m_blockTextureArray;
+    static constexpr int BLOCK_TEXTURE_SIZE = 32; // Layer resolution in texels; other sizes are resampled
     
     // Sky textures
     unsigned int m_sunTexture;
@@ -170,13 +193,47 @@ private:
     Mat4 m_viewMatrix;  // Store view matrix for player rendering
     int m_viewportWidth, m_viewportHeight;
     float m_cameraY;  // Store camera Y position for underwater effect
-    Vec3 m_cameraPos;  // Store camera position for water reflections
+    Vec3 m_eyePosition; // Camera (eye level) position the view matrix was built from
     
     // Shader uniforms
-    int m_modelLoc, m_viewLoc, m_projLoc;
-    int m_textureLoc;
-    int m_colorTintLoc;
-    int m_cameraYLoc;
+    int m_modelLoc;
+    
+    // Per-frame values every world shader reads from one uniform buffer (shaders/frame_data.glsl),
+    // uploaded once in BeginFrame instead of setting the same uniforms on each program. std140 layout
+    struct FrameData {
+        float view[16];
+        float projection[16];
+        float cameraPosition[4]; // Eye position, w unused
+        float sunDirection[4];   // Unit vector towards the sun, w unused
+        float gameTime;
+        float animationTime;     // Water animation clock, advanced a fixed step per frame
+        float padding[2];        // std140 rounds the block up to 16 bytes
+    };
+    static_assert(sizeof(FrameData) == 176, "FrameData must match the std140 layout of shaders/frame_data.glsl");
+    static constexpr GLuint FRAME_DATA_BINDING = 0;     // Uniform buffer binding point of the FrameData block
+    static constexpr float ANIMATION_TIME_STEP = 0.016f; // Per frame (~60 FPS)
+    unsigned int m_frameDataUBO;
+    FrameData m_frameData; // Values uploaded for the current frame
+    float m_animationTime;
+    void BindFrameData(unsigned int program); // Points the program's FrameData block at FRAME_DATA_BINDING
+    
+    // Chunk shader variants built from vertex.glsl and fragment.glsl, indexed [variant][underwater].
+    // Opaque geometry is drawn without discard so early depth testing stays on; the underwater tint is
+    // compiled in or out and the variant is picked once per frame. m_shaderProgram is the opaque,
+    // above-water variant.
+    enum BlockShaderVariant {
+        BLOCK_SHADER_OPAQUE = 0,  // Solid pass
+        BLOCK_SHADER_CUTOUT = 1,  // Cutout pass: discards transparent texels
+        BLOCK_SHADER_VARIANT_COUNT = 2
+    };
+    struct BlockShader {
+        unsigned int program = 0;
+        int modelLoc = -1;
+    };
+    BlockShader m_blockShaders[BLOCK_SHADER_VARIANT_COUNT][2];
+    static constexpr float UNDERWATER_TINT_BELOW_Y = 60.0f; // Camera height below which the underwater variants are used
+    unsigned int LinkBlockShaderVariant(unsigned int vertexShader, const std::string& fragmentSource, const std::string& defines);
+    void UseBlockShader(const BlockShader& shader); // Binds the program and sets its model matrix
 
     // Shader management
     bool CreateShaders();
@@ -192,15 +249,28 @@ private:
     bool CheckShaderCompilation(unsigned int shader, const char* type);
     bool CheckProgramLinking(unsigned int program);
     
-    // Biome-based tinting helpers
-    bool NeedsBiomeTinting(BlockType blockType) const;
-    bool IsLeafBlock(BlockType blockType) const;
-    void ApplyBiomeTinting(BlockType blockType, int chunkX, int chunkZ, int worldSeed);
-    
     // Matrix operations
     Mat4 CreateProjectionMatrix(float fov, float aspect, float near, float far);
     Mat4 CreateTranslationMatrix(float x, float y, float z);
+    void SetRegionModelMatrix(int modelLoc); // Chunk vertices are relative to WORLD_MIN_CHUNK
     
     // Frustum culling
     Frustum m_frustum;
+    
+    // Shared chunk mesh storage, one pool per mesh pass (registered with Chunk::SetMeshPools)
+    Chunk::MeshPools m_chunkMeshPools;
+    int m_chunkDrawSubmissions = 0;
+    int m_chunkDrawCommands = 0;
+    int m_sectionsTested = 0;
+    int m_sectionsCulled = 0;
+    int m_sectionsOccluded = 0;
+    
+    // Cave culling traversal state, reused every frame
+    struct SectionStep {
+        int chunkX, sectionY, chunkZ;
+        int enteredFace; // Face of this section the walk came in through, -1 for the camera's section
+        uint8_t directions; // Faces stepped through so far; the walk never turns back against one of them
+    };
+    std::vector<SectionStep> m_sectionQueue;
+    std::vector<uint16_t> m_reachedSections; // Section mask per chunk, indexed like the world grid
 }; 
\ No newline at end of file
@@ -73,6 +73,7 @@ struct ChunkDataMessage {
     NetworkMessageHeader header;
     int32_t chunkX, chunkZ;
     uint16_t blocks[16 * 256 * 16];
+    ChunkBiomeMap biomeMap; // Sent with the blocks so clients never re-run the climate noise
 };
 
 // Server announcement for UDP broadcast discovery
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of worker threads running queued tasks in submission order.
+// Tasks must not touch OpenGL or any state the main thread mutates without synchronisation.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threadCount = 0); // 0 = one worker per hardware thread, minus the main thread
+    ~ThreadPool();                                // Drops tasks that have not started and joins the workers
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    void Submit(std::function<void()> task);
+    void WaitIdle(); // Blocks until the queue is empty and no task is running
+    
+    size_t GetThreadCount() const { return m_workers.size(); }
+    size_t GetQueuedTaskCount() const;
+
+private:
+    void WorkerLoop();
+    
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_taskAvailable;
+    std::condition_variable m_idle;
+    size_t m_activeTasks;
+    bool m_stopping;
+};
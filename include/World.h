@@ -1,28 +1,41 @@
 #pragma once
 
 #include "Chunk.h"
+#include "ChunkMesher.h"
 #include "Block.h"
 #include "BlockManager.h"
+#include "ThreadPool.h"
 #include <array>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <random>
+#include <utility>
 
 // World dimensions (10x10 chunks centered around origin)
 constexpr int WORLD_SIZE = 10;
+constexpr int WORLD_MIN_CHUNK = -WORLD_SIZE / 2; // Chunk mesh positions are relative to this chunk's corner on X and Z
+static_assert(WORLD_SIZE * CHUNK_WIDTH < 1024, "Chunk vertex x and z are packed into 10 bits");
 
 class World {
 public:
     World();
     explicit World(int seed);
+    ~World();
     
     // Block access (world coordinates)
     Block GetBlock(int worldX, int worldY, int worldZ) const;
     void SetBlock(int worldX, int worldY, int worldZ, BlockType type);
     void SetBlock(int worldX, int worldY, int worldZ, const Block& block);
     
+    // Occupancy queries against the sections' non-air bitmasks (same result as GetBlock().IsSolid(),
+    // without decoding the block). The region test covers the inclusive box and checks a row per step.
+    bool IsBlockOccupied(int worldX, int worldY, int worldZ) const;
+    bool IsRegionOccupied(int minX, int minY, int minZ, int maxX, int maxY, int maxZ) const;
+    
     // Efficient block updates for streaming
-    void SetBlockWithMeshUpdate(int worldX, int worldY, int worldZ, BlockType type, const BlockManager* blockManager);
-    void UpdateNeighboringChunks(int worldX, int worldY, int worldZ, const BlockManager* blockManager);
+    void SetBlockWithMeshUpdate(int worldX, int worldY, int worldZ, BlockType type);
+    void UpdateNeighboringChunks(int worldX, int worldY, int worldZ);
     void SetBlockBatched(int worldX, int worldY, int worldZ, BlockType type); // Queue block update for batching
     void ProcessAllBatchedUpdates(const BlockManager* blockManager); // Process batched updates across all chunks
     
@@ -33,24 +46,47 @@ public:
     // World properties
     int GetSeed() const { return m_seed; }
     
-    // Generation
+    // Generation (blocking: chunks generate in parallel on the workers, with the same result for a seed
+    // as generating them in order, then every mesh is built)
     void Generate();
     void GenerateWithBlockManager(const BlockManager* blockManager);
     void RegenerateWithSeed(int newSeed);
     void RegenerateWithSeed(int newSeed, const BlockManager* blockManager);
     
-    // Mesh generation
+    // Mesh generation (blocking: every chunk is built on the mesh workers, then uploaded)
     void GenerateAllMeshes();
     void GenerateAllMeshes(const BlockManager* blockManager);
     void RegenerateMeshes();
     void RegenerateMeshes(const BlockManager* blockManager);
     
+    // Background meshing: requested chunks are snapshotted on the main thread, built on the mesh
+    // workers and uploaded by ProcessMeshQueue. Urgent requests (block edits) jump the queue.
+    void RequestChunkMesh(int chunkX, int chunkZ, bool urgent = false);
+    void RequestSectionMesh(int chunkX, int chunkZ, uint16_t sectionMask, bool urgent = false); // Rebuild only these sections
+    void RequestChunkMeshWithNeighbors(int chunkX, int chunkZ, bool urgent = false); // Also the 8 chunks bordering it
+    void RequestAllChunkMeshes();
+    void ProcessMeshQueue(const BlockManager* blockManager, int maxUploads = MESH_UPLOADS_PER_FRAME); // Call once per frame
+    size_t GetPendingMeshCount() const; // Requests not yet uploaded
+    
+    static constexpr int MESH_UPLOADS_PER_FRAME = 4;  // Finished meshes uploaded per ProcessMeshQueue call
+    static constexpr int MESH_JOBS_PER_WORKER = 2;    // Snapshots in flight per worker; later requests wait unsnapshotted
+    
     // Utility functions
     bool IsValidWorldPosition(int worldX, int worldY, int worldZ) const;
     void WorldToChunkCoords(int worldX, int worldZ, int& chunkX, int& chunkZ, int& localX, int& localZ) const;
     
     // Find highest non-air block at given world coordinates
     int FindHighestBlock(int worldX, int worldZ) const;
+    
+    // Heightmap queries (world coordinates); -1 when the column is empty or outside the world
+    int GetHeight(int worldX, int worldZ, HeightmapType type) const;
+    int FindHighestBlockBelow(int worldX, int worldZ, int maxY, HeightmapType type) const;
+    
+    // Total bytes used by palette-compressed block storage
+    size_t GetBlockMemoryUsage() const;
+    
+    // Total vertices uploaded across all chunk meshes
+    size_t GetTotalVertexCount() const;
 
 private:
     // 10x10 grid of chunks: [x][z] where x,z are 0 to 9
@@ -60,8 +96,30 @@ private:
     int m_seed;
     std::mt19937 m_randomGenerator;
     
+    // Background meshing state, owned by the main thread except for m_completedMeshes
+    enum MeshRequestState : uint8_t {
+        MESH_QUEUED = 1 << 0,     // Waiting in m_meshQueue for a snapshot
+        MESH_IN_FLIGHT = 1 << 1   // Snapshot taken; building on a worker or waiting for upload
+    };
+    struct CompletedMesh {
+        int chunkX;
+        int chunkZ;
+        ChunkMeshData meshData;
+    };
+    std::deque<std::pair<int, int>> m_meshQueue;  // Chunk coordinates, most urgent first
+    std::array<std::array<uint8_t, WORLD_SIZE>, WORLD_SIZE> m_meshState = {};
+    std::array<std::array<uint16_t, WORLD_SIZE>, WORLD_SIZE> m_meshDirtySections = {}; // Requested sections not yet snapshotted
+    int m_meshJobsInFlight = 0;
+    std::mutex m_completedMeshMutex;              // Guards m_completedMeshes, which workers append to
+    std::deque<CompletedMesh> m_completedMeshes;
+    std::unique_ptr<ThreadPool> m_workers;        // Generation and meshing; created on first use, declared last so it stops first
+    
     // Helper functions
     void InitializeChunks();
+    ThreadPool& GetWorkers();
+    void GenerateChunks(const BlockManager* blockManager); // Terrain of every chunk on the workers; blocks until done
+    void SubmitMeshJob(int chunkX, int chunkZ, const BlockManager* blockManager);
+    void CancelMeshRequests(); // Waits for running builds and forgets every pending request
     bool IsValidChunkIndex(int x, int z) const;
     void ChunkCoordsToArrayIndex(int chunkX, int chunkZ, int& arrayX, int& arrayZ) const;
 }; 
\ No newline at end of file
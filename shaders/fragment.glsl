@@ -1,37 +1,48 @@
 #version 330 core
+// Compiled in variants (see Renderer::CreateShaders), which insert #defines after the #version line:
+//   ALPHA_CUTOUT - discard transparent texels (leaves, glass, plants); without it the shader has no
+//                  discard, so early depth testing stays enabled for opaque terrain
+//   UNDERWATER   - blue underwater tint; the renderer picks the variant once per frame
 out vec4 FragColor;
 
 in float vertexAO;
 in vec2 TexCoord;
+flat in float textureLayer;
+flat in int hasOverlay;
+flat in vec3 biomeTint;
 
-uniform sampler2D blockTexture;
-uniform vec3 colorTint; // RGB color multiplier for tinting
-uniform float cameraY; // Camera Y position for underwater effect
+uniform sampler2DArray blockTextures; // One layer per block texture (see BlockManager::GetTextureLayers)
 
 void main()
 {
     // Sample the texture
-    vec4 textureColor = texture(blockTexture, TexCoord);
+    vec4 textureColor = texture(blockTextures, vec3(TexCoord, textureLayer));
     
-    // Discard transparent pixels (for overlay textures)
+#ifdef ALPHA_CUTOUT
+    // Discard transparent pixels (leaves, plants)
     if (textureColor.a < 0.1) {
         discard;
     }
+#endif
     
-    // Apply color tint to the texture
-    vec3 tintedColor = textureColor.rgb * colorTint;
+    // Apply the biome tint. Overlay faces (grass sides) keep the base texture untinted
+    // and tint only the opaque texels of the overlay layer drawn over it.
+    vec3 tintedColor = textureColor.rgb * biomeTint;
+    if (hasOverlay != 0) {
+        vec4 overlayColor = texture(blockTextures, vec3(TexCoord, textureLayer + 1.0));
+        tintedColor = overlayColor.a < 0.1 ? textureColor.rgb : overlayColor.rgb * biomeTint;
+    }
     
     // Apply ambient occlusion to the tinted color
     // AO values: 1.0=bright, 0.8=light shadow, 0.6=medium shadow, 0.4=dark shadow, 0.25=very dark
     vec3 finalColor = tintedColor * vertexAO;
     
-    // Apply underwater blue tint if camera is below water level (y < 60)
-    if (cameraY < 60.0) {
-        // Mix with blue tint for underwater effect
-        vec3 underwaterTint = vec3(0.4, 0.7, 1.0); // Blue tint
-        float tintStrength = 0.4; // How much blue tint to apply
-        finalColor = mix(finalColor, finalColor * underwaterTint, tintStrength);
-    }
+#ifdef UNDERWATER
+    // Mix with blue tint for underwater effect (camera below water level)
+    vec3 underwaterTint = vec3(0.4, 0.7, 1.0); // Blue tint
+    float tintStrength = 0.4; // How much blue tint to apply
+    finalColor = mix(finalColor, finalColor * underwaterTint, tintStrength);
+#endif
     
     FragColor = vec4(finalColor, 1.0);
 } 
\ No newline at end of file
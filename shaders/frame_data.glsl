@@ -0,0 +1,10 @@
+// Per-frame values shared by the world shaders, written once per frame by Renderer::BeginFrame.
+// The layout must match Renderer::FrameData. Shaders pull this in with an #include line.
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 cameraPosition; // Eye position in xyz
+    vec4 sunDirection;   // Unit vector towards the sun in xyz
+    float gameTime;      // Day cycle clock
+    float animationTime; // Water animation clock
+} frame;
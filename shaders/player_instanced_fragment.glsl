@@ -0,0 +1,12 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+flat in float SkinLayer;
+
+uniform sampler2DArray skinTextures;
+
+void main()
+{
+    FragColor = texture(skinTextures, vec3(TexCoord, SkinLayer));
+}
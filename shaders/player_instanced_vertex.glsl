@@ -0,0 +1,52 @@
+#version 330 core
+// Remote players, all drawn with one instanced call (see PlayerModel::RenderInstanced).
+// The mesh holds every body part around its own centre; the part placement, head pitch,
+// limb swing and yaw are built here from the per-instance data.
+layout (location = 0) in vec3 aPos;         // Relative to the body part's centre
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in float aPart;       // PlayerModel::BodyPart
+layout (location = 3) in vec4 aPositionYaw; // Per instance: feet position, yaw in degrees
+layout (location = 4) in vec3 aPose;        // Per instance: pitch in degrees, walk phase, skin layer
+
+#include "frame_data.glsl"
+
+out vec2 TexCoord;
+flat out float SkinLayer;
+
+// Part centres above the feet, in BodyPart order: head, torso, left arm, right arm, left leg, right leg
+const vec3 PART_CENTER[6] = vec3[6](
+    vec3(0.0, 1.575, 0.0), vec3(0.0, 1.0125, 0.0),
+    vec3(-0.375, 1.0125, 0.0), vec3(0.375, 1.0125, 0.0),
+    vec3(-0.125, 0.3375, 0.0), vec3(0.125, 0.3375, 0.0));
+
+// Height of each part's pivot above its centre: the neck for the head, shoulders and hips for the limbs
+const float PART_PIVOT_Y[6] = float[6](-0.225, 0.0, 0.3375, 0.3375, 0.3375, 0.3375);
+
+// Swing direction of each part; an arm swings against the leg on its side
+const float PART_SWING[6] = float[6](0.0, 0.0, -1.0, 1.0, 1.0, -1.0);
+const float MAX_SWING = 0.7; // Radians at the peak of a stride
+
+void main()
+{
+    int part = int(aPart + 0.5);
+
+    // Rotate about X through the pivot: the head tilts up with positive pitch (+Z is the model's front),
+    // limbs swing with the walk phase
+    float angle = part == 0 ? -radians(aPose.x) : PART_SWING[part] * MAX_SWING * sin(aPose.y);
+    float c = cos(angle);
+    float s = sin(angle);
+    vec3 pivot = vec3(0.0, PART_PIVOT_Y[part], 0.0);
+    vec3 local = aPos - pivot;
+    local = vec3(local.x, c * local.y - s * local.z, s * local.y + c * local.z) + pivot;
+    vec3 body = PART_CENTER[part] + local;
+
+    // Yaw about the feet, then move to the player's position
+    float yaw = radians(aPositionYaw.w);
+    float cy = cos(yaw);
+    float sy = sin(yaw);
+    vec3 worldPos = vec3(cy * body.x - sy * body.z, body.y, sy * body.x + cy * body.z) + aPositionYaw.xyz;
+
+    gl_Position = frame.projection * frame.view * vec4(worldPos, 1.0);
+    TexCoord = aTexCoord;
+    SkinLayer = aPose.z;
+}
@@ -4,8 +4,7 @@ out vec4 FragColor;
 in vec3 worldPos;
 in vec3 viewDir;
 
-uniform float gameTime; // Time of day for color transitions
-uniform vec3 sunDirection; // Direction to sun for atmospheric scattering
+#include "frame_data.glsl"
 
 void main()
 {
@@ -13,14 +12,14 @@ void main()
     float height = normalize(viewDir).y;
     
     // Calculate time factor (0.0 = start of day, 1.0 = end of day cycle)
-    float timeFactor = gameTime / 900.0f; // 900 seconds = 15 minutes
+    float timeFactor = frame.gameTime / 900.0f; // 900 seconds = 15 minutes
     
     vec3 skyColor;
     vec3 horizonColor;
     vec3 groundColor; // Color for looking downward
     
     // Get position within current 15-minute cycle (0-900 seconds)
-    float cycleTime = mod(gameTime, 900.0);
+    float cycleTime = mod(frame.gameTime, 900.0);
     // Normalize to 0-1 for color transitions
     float normalizedTime = cycleTime / 900.0;
     
@@ -173,7 +172,7 @@ void main()
     finalColor *= (0.85 + 0.15 * atmosphericFade) * atmosphericIntensity;
     
     // Add subtle color variations for more dynamic sky
-    float noise = sin(viewDir.x * 6.0 + gameTime * 0.01) * cos(viewDir.z * 6.0 + gameTime * 0.01) * 0.008;
+    float noise = sin(viewDir.x * 6.0 + frame.gameTime * 0.01) * cos(viewDir.z * 6.0 + frame.gameTime * 0.01) * 0.008;
     finalColor += noise;
     
     // Add time-based color temperature shifts
@@ -1,8 +1,7 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
-uniform mat4 view;
-uniform mat4 projection;
+#include "frame_data.glsl"
 
 out vec3 worldPos;
 out vec3 viewDir;
@@ -10,9 +9,9 @@ out vec3 viewDir;
 void main()
 {
     // Remove translation from view matrix to keep sky at infinite distance
-    mat4 skyView = mat4(mat3(view)); // Keep only rotation, remove translation
+    mat4 skyView = mat4(mat3(frame.view)); // Keep only rotation, remove translation
     
-    vec4 pos = projection * skyView * vec4(aPos, 1.0);
+    vec4 pos = frame.projection * skyView * vec4(aPos, 1.0);
     gl_Position = pos.xyww; // Set z to w for infinite distance
     
     // Pass local position as world position for calculations
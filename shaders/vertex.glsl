@@ -1,18 +1,57 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in float aAO;
-layout (location = 2) in vec2 aTexCoord;
+// Packed chunk vertex (see ChunkVertex.h)
+layout (location = 0) in uint aPosition;   // x (10 bits) | z (10 bits) | y (9 bits) | face (3 bits)
+layout (location = 1) in uint aAttributes; // AO level (3 bits) | corner (2 bits) | flags (3 bits) | texture layer (9 bits) | tint (RGB555)
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat4 model; // Places the world-relative block corners of every chunk (one matrix for all chunks)
+#include "frame_data.glsl"
 
 out float vertexAO;
 out vec2 TexCoord;
+flat out float textureLayer;
+flat out int hasOverlay; // Sample layer + 1 as a tinted overlay
+flat out vec3 biomeTint;
+
+const uint FLAG_LOWERED_TOP = 1u;
+const uint FLAG_FLIP_V = 2u;
+const uint FLAG_OVERLAY = 4u;
+
+// AO curve per level and directional shade per face (front, back, left, right, bottom, top, cross A, cross B)
+const float AO_CURVE[5] = float[5](1.0, 0.8, 0.6, 0.4, 0.25);
+const float FACE_SHADE[8] = float[8](0.8, 0.8, 0.6, 0.6, 0.5, 1.0, 1.0, 1.0);
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    vertexAO = aAO;
-    TexCoord = aTexCoord;
-} 
\ No newline at end of file
+    vec3 corner = vec3(float(aPosition & 1023u), float((aPosition >> 20) & 511u), float((aPosition >> 10) & 1023u));
+    uint face = aPosition >> 29;
+    uint aoLevel = aAttributes & 7u;
+    uint cornerIndex = (aAttributes >> 3) & 3u;
+    uint flags = (aAttributes >> 5) & 7u;
+    uint layer = (aAttributes >> 8) & 511u;
+    uint tint = aAttributes >> 17;
+    
+    // Texture coordinates follow the block grid so merged quads tile one texture per block
+    vec2 uv;
+    if (face == 0u)      uv = vec2(corner.x, corner.y);   // Front (+Z)
+    else if (face == 1u) uv = vec2(-corner.x, corner.y);  // Back (-Z)
+    else if (face == 2u) uv = vec2(corner.z, corner.y);   // Left (-X)
+    else if (face == 3u) uv = vec2(-corner.z, corner.y);  // Right (+X)
+    else if (face == 4u) uv = vec2(corner.x, corner.z);   // Bottom (-Y)
+    else if (face == 5u) uv = vec2(corner.z, corner.x);   // Top (+Y)
+    else uv = vec2(cornerIndex == 1u || cornerIndex == 2u ? 1.0 : 0.0, cornerIndex >= 2u ? 0.0 : 1.0); // Cross sprite
+    if ((flags & FLAG_FLIP_V) != 0u) {
+        uv.y = -uv.y;
+    }
+    
+    vec3 position = corner;
+    if ((flags & FLAG_LOWERED_TOP) != 0u) {
+        position.y -= 0.0625; // Water surface at 15/16 block height
+    }
+    
+    gl_Position = frame.projection * frame.view * model * vec4(position, 1.0);
+    vertexAO = aoLevel == 4u ? AO_CURVE[4] : AO_CURVE[aoLevel] * FACE_SHADE[face];
+    TexCoord = uv;
+    textureLayer = float(layer);
+    hasOverlay = (flags & FLAG_OVERLAY) != 0u ? 1 : 0;
+    biomeTint = vec3(float(tint & 31u), float((tint >> 5) & 31u), float((tint >> 10) & 31u)) / 31.0;
+}
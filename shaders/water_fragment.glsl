@@ -8,10 +8,7 @@ in vec3 surfaceNormal;
 in vec2 waveCoords;
 in float waveHeight;
 
-uniform float time; // For water animation
-uniform float gameTime; // Game time for sky color synchronization
-uniform vec3 cameraPos; // Camera position
-uniform vec3 sunDirection; // Sun direction for specular highlights
+#include "frame_data.glsl"
 
 // Function to calculate sky color based on viewing direction and game time
 // This mirrors the sky shader's color calculation system
@@ -94,7 +91,7 @@ void main()
     vec3 reflectionDir = reflect(-viewDirection, normal);
     
     // Get sky color for reflections
-    vec3 reflectionColor = calculateSkyColor(reflectionDir, gameTime);
+    vec3 reflectionColor = calculateSkyColor(reflectionDir, frame.gameTime);
     
     // Proper Fresnel effect - more transparent looking down, less transparent at grazing angles
     float NdotV = max(dot(normal, viewDirection), 0.0);
@@ -102,7 +99,7 @@ void main()
     fresnel = mix(0.15, 0.85, fresnel);  // More transparent range
     
     // Distance-based blending (keep this from before since user liked it)
-    float distanceToWater = length(cameraPos - worldPos);
+    float distanceToWater = length(frame.cameraPosition.xyz - worldPos);
     float distanceFactor = smoothstep(8.0, 30.0, distanceToWater);
     distanceFactor = clamp(distanceFactor, 0.0, 0.7);
     
@@ -112,7 +109,7 @@ void main()
     vec3 baseWaterColor = mix(clearWaterColor, deepWaterColor, depth * 0.6);
     
     // Simple specular highlights - just occasional sparkles on wave peaks
-    vec3 localSunDir = normalize(sunDirection);
+    vec3 localSunDir = normalize(frame.sunDirection.xyz);
     vec3 halfVector = normalize(viewDirection + localSunDir);
     float specular = pow(max(dot(normal, halfVector), 0.0), 128.0);  // Sharp highlights
     specular *= max(dot(normal, localSunDir), 0.0);
@@ -1,13 +1,10 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in float aAO;
-layout (location = 2) in vec2 aTexCoord;
+// Packed chunk vertex (see ChunkVertex.h)
+layout (location = 0) in uint aPosition;   // x (10 bits) | z (10 bits) | y (9 bits) | face (3 bits)
+layout (location = 1) in uint aAttributes; // AO level (3 bits) | corner (2 bits) | flags (3 bits) | texture layer (9 bits) | tint (RGB555)
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform float time; // For water animation
-uniform vec3 cameraPos; // Camera position for reflection calculations
+uniform mat4 model; // Places the world-relative block corners of every chunk (one matrix for all chunks)
+#include "frame_data.glsl"
 
 out float vertexAO;
 out vec3 worldPos;
@@ -16,36 +13,48 @@ out vec3 surfaceNormal;
 out vec2 waveCoords;
 out float waveHeight;
 
+const uint FLAG_LOWERED_TOP = 1u;
+const float AO_CURVE[5] = float[5](1.0, 0.8, 0.6, 0.4, 0.25);
+const float FACE_SHADE[8] = float[8](0.8, 0.8, 0.6, 0.6, 0.5, 1.0, 1.0, 1.0);
+
 void main()
 {
+    // Decode the packed vertex
+    vec3 corner = vec3(float(aPosition & 1023u), float((aPosition >> 20) & 511u), float((aPosition >> 10) & 1023u));
+    uint face = aPosition >> 29;
+    uint aoLevel = aAttributes & 7u;
+    if (((aAttributes >> 5) & FLAG_LOWERED_TOP) != 0u) {
+        corner.y -= 0.0625; // Water surface at 15/16 block height
+    }
+    
     // Calculate base world position
-    vec4 worldPosition = model * vec4(aPos, 1.0);
+    vec4 worldPosition = model * vec4(corner, 1.0);
     worldPos = worldPosition.xyz;
     
     // Simple, realistic wave generation
     vec2 pos = worldPos.xz * 0.05; // Larger wave patterns for realism
     
     // Just a few gentle waves - much more realistic than complex noise
-    float wave1 = sin(pos.x * 1.2 + time * 0.6) * 0.08;  // Large, slow waves
-    float wave2 = sin(pos.y * 0.8 + time * 0.4) * 0.06;  // Cross waves
-    float wave3 = sin((pos.x + pos.y) * 2.0 + time * 1.0) * 0.03;  // Small detail waves
+    float wave1 = sin(pos.x * 1.2 + frame.animationTime * 0.6) * 0.08;  // Large, slow waves
+    float wave2 = sin(pos.y * 0.8 + frame.animationTime * 0.4) * 0.06;  // Cross waves
+    float wave3 = sin((pos.x + pos.y) * 2.0 + frame.animationTime * 1.0) * 0.03;  // Small detail waves
     
     // Combine waves - keep it simple
     waveHeight = wave1 + wave2 + wave3;
     
     // Only apply wave displacement to top surface (y-component)
-    if (aPos.y > 0.5) { // Assuming water blocks have vertices at y=0 (bottom) and y=1 (top)
+    if (worldPosition.y > 0.5) { // Assuming water blocks have vertices at y=0 (bottom) and y=1 (top)
         worldPos.y += waveHeight * 0.3; // Scale down the displacement for subtlety
     }
     
     // Calculate surface normal from simple wave derivatives
     float dWave_dx = 
-        1.2 * 0.05 * cos(pos.x * 1.2 + time * 0.6) * 0.08 +  // wave1 derivative
-        2.0 * 0.05 * cos((pos.x + pos.y) * 2.0 + time * 1.0) * 0.03;  // wave3 derivative
+        1.2 * 0.05 * cos(pos.x * 1.2 + frame.animationTime * 0.6) * 0.08 +  // wave1 derivative
+        2.0 * 0.05 * cos((pos.x + pos.y) * 2.0 + frame.animationTime * 1.0) * 0.03;  // wave3 derivative
     
     float dWave_dz = 
-        0.8 * 0.05 * cos(pos.y * 0.8 + time * 0.4) * 0.06 +  // wave2 derivative  
-        2.0 * 0.05 * cos((pos.x + pos.y) * 2.0 + time * 1.0) * 0.03;  // wave3 derivative
+        0.8 * 0.05 * cos(pos.y * 0.8 + frame.animationTime * 0.4) * 0.06 +  // wave2 derivative  
+        2.0 * 0.05 * cos((pos.x + pos.y) * 2.0 + frame.animationTime * 1.0) * 0.03;  // wave3 derivative
     
     // Create surface normal from wave gradients
     vec3 tangent = normalize(vec3(1.0, dWave_dx * 0.3, 0.0));
@@ -53,11 +62,11 @@ void main()
     surfaceNormal = normalize(cross(tangent, bitangent));
     
     // Calculate view direction from camera to surface point
-    viewDir = normalize(cameraPos - worldPos);
+    viewDir = normalize(frame.cameraPosition.xyz - worldPos);
     
     // Simple texture coordinates for surface effects
-    waveCoords = vec2(worldPos.x, worldPos.z) * 0.1 + vec2(time * 0.05, time * 0.03);
+    waveCoords = vec2(worldPos.x, worldPos.z) * 0.1 + vec2(frame.animationTime * 0.05, frame.animationTime * 0.03);
     
-    gl_Position = projection * view * vec4(worldPos, 1.0);
-    vertexAO = aAO;
+    gl_Position = frame.projection * frame.view * vec4(worldPos, 1.0);
+    vertexAO = aoLevel == 4u ? AO_CURVE[4] : AO_CURVE[aoLevel] * FACE_SHADE[face];
 }
\ No newline at end of file
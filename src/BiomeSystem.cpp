@@ -1,6 +1,9 @@
 #include "BiomeSystem.h"
+#include "GenerationRandom.h"
+#include "PerlinNoise.h"
 #include <cmath>
 #include <algorithm>
+#include <memory>
 
 // Biome color data based on your specifications
 // Updated for new biome system
@@ -31,6 +34,40 @@ const std::array<BiomeColors, static_cast<int>(BiomeType::COUNT)> BiomeSystem::s
     {0.568f, 0.741f, 0.349f,  0.467f, 0.671f, 0.184f}  // Same as plains for river banks
 }};
 
+struct BiomeSystem::ClimateNoise {
+    int seed;
+    PerlinNoise temperature[3];
+    PerlinNoise humidity[3];
+    PerlinNoise river[2];
+
+    explicit ClimateNoise(int worldSeed)
+        : seed(worldSeed),
+          temperature{Layer(worldSeed, 0), Layer(worldSeed, 1), Layer(worldSeed, 2)},
+          humidity{Layer(worldSeed, 3), Layer(worldSeed, 4), Layer(worldSeed, 5)},
+          river{Layer(worldSeed, 6), Layer(worldSeed, 7)} {}
+
+    // Seeds hashed from the world seed, so no layer shares a permutation table with terrain or ore noise
+    static PerlinNoise Layer(int worldSeed, int index) {
+        return PerlinNoise(GenerationRandom::DeriveSeed(worldSeed, GenerationRandom::FEATURE_CLIMATE_NOISE, index));
+    }
+};
+
+namespace {
+    // Large, medium and small scale octaves
+    constexpr float TEMPERATURE_FREQUENCIES[3] = {0.005f, 0.02f, 0.08f};
+    constexpr float HUMIDITY_FREQUENCIES[3] = {0.006f, 0.025f, 0.09f};
+    constexpr float RIVER_FREQUENCIES[2] = {0.008f, 0.004f};
+}
+
+const BiomeSystem::ClimateNoise& BiomeSystem::GetClimateNoise(int seed) {
+    // Chunks are generated on worker threads, so each thread keeps its own copy
+    thread_local std::unique_ptr<ClimateNoise> noise;
+    if (!noise || noise->seed != seed) {
+        noise = std::make_unique<ClimateNoise>(seed);
+    }
+    return *noise;
+}
+
 BiomeType BiomeSystem::GetBiomeType(int worldX, int worldZ, int seed) {
     // Check for rivers first (they override other biomes)
     if (IsRiver(worldX, worldZ, seed)) {
@@ -46,26 +83,89 @@ BiomeType BiomeSystem::GetBiomeType(int worldX, int worldZ, int seed) {
 
 TemperatureHumidity BiomeSystem::GetTemperatureHumidity(int worldX, int worldZ, int seed) {
     // Use multiple octaves of noise for more natural climate patterns
-    double tempNoise1 = PerlinNoise(worldX, worldZ, seed, 0.005);        // Large scale
-    double tempNoise2 = PerlinNoise(worldX, worldZ, seed + 1000, 0.02);  // Medium scale
-    double tempNoise3 = PerlinNoise(worldX, worldZ, seed + 2000, 0.08);  // Small scale
-    
-    double humidNoise1 = PerlinNoise(worldX, worldZ, seed + 3000, 0.006);   // Large scale
-    double humidNoise2 = PerlinNoise(worldX, worldZ, seed + 4000, 0.025);   // Medium scale
-    double humidNoise3 = PerlinNoise(worldX, worldZ, seed + 5000, 0.09);    // Small scale
+    const ClimateNoise& noise = GetClimateNoise(seed);
+    float temperatureOctaves[3];
+    float humidityOctaves[3];
+    for (int octave = 0; octave < 3; ++octave) {
+        temperatureOctaves[octave] = noise.temperature[octave].SampleColumn(worldX, worldZ, TEMPERATURE_FREQUENCIES[octave]);
+        humidityOctaves[octave] = noise.humidity[octave].SampleColumn(worldX, worldZ, HUMIDITY_FREQUENCIES[octave]);
+    }
+    return CombineClimate(temperatureOctaves, humidityOctaves);
+}
+
+void BiomeSystem::ComputeBiomeMap(int chunkX, int chunkZ, int seed, ChunkBiomeMap& map) {
+    constexpr int WIDTH = ChunkBiomeMap::WIDTH;
+    constexpr int SPACING = ChunkBiomeMap::GRID_SPACING;
+    constexpr int POINTS = ChunkBiomeMap::GRID_POINTS;
+    const ClimateNoise& noise = GetClimateNoise(seed);
+    
+    // Climate and raw river noise at the grid points. The river noise is interpolated before the
+    // ridge is taken, which keeps river channels as wide as per-column sampling makes them
+    float riverGrid[2][POINTS * POINTS];
+    for (int j = 0; j < POINTS; ++j) {
+        for (int i = 0; i < POINTS; ++i) {
+            int worldX = chunkX * WIDTH + i * SPACING;
+            int worldZ = chunkZ * WIDTH + j * SPACING;
+            int point = j * POINTS + i;
+            map.climateGrid[point] = GetTemperatureHumidity(worldX, worldZ, seed);
+            riverGrid[0][point] = noise.river[0].SampleColumn(worldX, worldZ, RIVER_FREQUENCIES[0]);
+            riverGrid[1][point] = noise.river[1].SampleColumn(worldX, worldZ, RIVER_FREQUENCIES[1]);
+        }
+    }
     
+    for (int z = 0; z < WIDTH; ++z) {
+        for (int x = 0; x < WIDTH; ++x) {
+            int i = x / SPACING;
+            int j = z / SPACING;
+            float tx = static_cast<float>(x % SPACING) / SPACING;
+            float tz = static_cast<float>(z % SPACING) / SPACING;
+            auto interpolate = [&](const float* grid) {
+                float row0 = grid[j * POINTS + i] + (grid[j * POINTS + i + 1] - grid[j * POINTS + i]) * tx;
+                float row1 = grid[(j + 1) * POINTS + i] + (grid[(j + 1) * POINTS + i + 1] - grid[(j + 1) * POINTS + i]) * tx;
+                return row0 + (row1 - row0) * tz;
+            };
+            
+            BiomeType biome = BiomeType::RIVER;
+            if (!IsRiverValue(interpolate(riverGrid[0]), interpolate(riverGrid[1]))) {
+                TemperatureHumidity climate = map.GetClimate(x, z);
+                biome = GetBiomeFromClimate(climate.temperature, climate.humidity);
+            }
+            map.biomes[z * WIDTH + x] = static_cast<uint8_t>(biome);
+        }
+    }
+}
+
+TemperatureHumidity ChunkBiomeMap::GetClimate(int x, int z) const {
+    int i = x / GRID_SPACING;
+    int j = z / GRID_SPACING;
+    float tx = static_cast<float>(x % GRID_SPACING) / GRID_SPACING;
+    float tz = static_cast<float>(z % GRID_SPACING) / GRID_SPACING;
+    const TemperatureHumidity& p00 = climateGrid[j * GRID_POINTS + i];
+    const TemperatureHumidity& p10 = climateGrid[j * GRID_POINTS + i + 1];
+    const TemperatureHumidity& p01 = climateGrid[(j + 1) * GRID_POINTS + i];
+    const TemperatureHumidity& p11 = climateGrid[(j + 1) * GRID_POINTS + i + 1];
+    auto interpolate = [&](float v00, float v10, float v01, float v11) {
+        float row0 = v00 + (v10 - v00) * tx;
+        float row1 = v01 + (v11 - v01) * tx;
+        return row0 + (row1 - row0) * tz;
+    };
+    return {interpolate(p00.temperature, p10.temperature, p01.temperature, p11.temperature),
+            interpolate(p00.humidity, p10.humidity, p01.humidity, p11.humidity)};
+}
+
+TemperatureHumidity BiomeSystem::CombineClimate(const float temperatureOctaves[3], const float humidityOctaves[3]) {
     // Combine noise octaves with different weights
-    double temperature = (tempNoise1 * 0.6 + tempNoise2 * 0.3 + tempNoise3 * 0.1);
-    double humidity = (humidNoise1 * 0.6 + humidNoise2 * 0.3 + humidNoise3 * 0.1);
+    float temperature = temperatureOctaves[0] * 0.6f + temperatureOctaves[1] * 0.3f + temperatureOctaves[2] * 0.1f;
+    float humidity = humidityOctaves[0] * 0.6f + humidityOctaves[1] * 0.3f + humidityOctaves[2] * 0.1f;
     
     // Add some correlation between temperature and humidity (hot areas can be dry)
-    humidity -= temperature * 0.2;
+    humidity -= temperature * 0.2f;
     
     // Normalize to [0, 1] range
-    temperature = std::max(0.0, std::min(1.0, (temperature + 1.0) * 0.5));
-    humidity = std::max(0.0, std::min(1.0, (humidity + 1.0) * 0.5));
+    temperature = std::max(0.0f, std::min(1.0f, (temperature + 1.0f) * 0.5f));
+    humidity = std::max(0.0f, std::min(1.0f, (humidity + 1.0f) * 0.5f));
     
-    return {static_cast<float>(temperature), static_cast<float>(humidity)};
+    return {temperature, humidity};
 }
 
 BiomeType BiomeSystem::GetBiomeFromClimate(float temperature, float humidity) {
@@ -105,73 +205,23 @@ BiomeType BiomeSystem::GetBiomeFromClimate(float temperature, float humidity) {
 
 bool BiomeSystem::IsRiver(int worldX, int worldZ, int seed) {
     // Create rivers at biome boundaries using ridge noise
-    double riverNoise1 = PerlinNoise(worldX, worldZ, seed + 6000, 0.008);
-    double riverNoise2 = PerlinNoise(worldX, worldZ, seed + 7000, 0.004);
-    
+    const ClimateNoise& noise = GetClimateNoise(seed);
+    float riverNoise1 = noise.river[0].SampleColumn(worldX, worldZ, RIVER_FREQUENCIES[0]);
+    float riverNoise2 = noise.river[1].SampleColumn(worldX, worldZ, RIVER_FREQUENCIES[1]);
+    return IsRiverValue(riverNoise1, riverNoise2);
+}
+
+bool BiomeSystem::IsRiverValue(float riverNoise1, float riverNoise2) {
     // Create ridges (rivers flow in valleys)
-    double ridge1 = 1.0 - std::abs(riverNoise1);
-    double ridge2 = 1.0 - std::abs(riverNoise2);
+    float ridge1 = 1.0f - std::abs(riverNoise1);
+    float ridge2 = 1.0f - std::abs(riverNoise2);
     
     // Combine ridges
-    double riverValue = ridge1 * ridge2;
+    float riverValue = ridge1 * ridge2;
     
     // Only create rivers where the value is high enough
     // This creates narrow river channels
-    return riverValue > 0.85;
-}
-
-double BiomeSystem::PerlinNoise(double x, double z, int seed, double scale) {
-    // Simple Perlin-like noise implementation
-    x *= scale;
-    z *= scale;
-    
-    // Add seed offset
-    x += seed * 0.1;
-    z += seed * 0.1;
-    
-    // Integer coordinates
-    int xi = static_cast<int>(std::floor(x)) & 255;
-    int zi = static_cast<int>(std::floor(z)) & 255;
-    
-    // Fractional coordinates
-    double xf = x - std::floor(x);
-    double zf = z - std::floor(z);
-    
-    // Smoothing function
-    auto fade = [](double t) { return t * t * t * (t * (t * 6 - 15) + 10); };
-    
-    double u = fade(xf);
-    double v = fade(zf);
-    
-    // Simple hash function for gradients
-    auto hash = [seed](int x, int z) {
-        int h = seed + x * 374761393 + z * 668265263;
-        h = (h ^ (h >> 13)) * 1274126177;
-        return (h ^ (h >> 16)) & 3;
-    };
-    
-    // Get gradient vectors
-    auto grad = [](int hash, double x, double z) {
-        switch(hash) {
-            case 0: return x + z;
-            case 1: return -x + z;
-            case 2: return x - z;
-            case 3: return -x - z;
-            default: return 0.0;
-        }
-    };
-    
-    // Calculate gradients at corners
-    double g1 = grad(hash(xi, zi), xf, zf);
-    double g2 = grad(hash(xi + 1, zi), xf - 1, zf);
-    double g3 = grad(hash(xi, zi + 1), xf, zf - 1);
-    double g4 = grad(hash(xi + 1, zi + 1), xf - 1, zf - 1);
-    
-    // Interpolate
-    double lerp1 = g1 + u * (g2 - g1);
-    double lerp2 = g3 + u * (g4 - g3);
-    
-    return lerp1 + v * (lerp2 - lerp1);
+    return riverValue > 0.85f;
 }
 
 void BiomeSystem::GetGrassColor(BiomeType biome, float& r, float& g, float& b) {
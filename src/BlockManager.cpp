@@ -1,11 +1,28 @@
 #include "BlockManager.h"
 #include "Debug.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
+#include <tuple>
+
+namespace {
+    bool IsLeafBlock(BlockType blockType) {
+        return blockType == BlockType::ACACIA_LEAVES ||
+               blockType == BlockType::AZALEA_LEAVES ||
+               blockType == BlockType::BIRCH_LEAVES ||
+               blockType == BlockType::CHERRY_LEAVES ||
+               blockType == BlockType::JUNGLE_LEAVES ||
+               blockType == BlockType::MANGROVE_LEAVES ||
+               blockType == BlockType::SPRUCE_LEAVES ||
+               blockType == static_cast<BlockType>(235); // OAK_LEAVES
+    }
+}
 
 BlockManager::BlockManager() {
     InitializeDefaultBlocks();
+    AssignTextureLayers();
 }
 
 BlockManager::~BlockManager() {
@@ -114,7 +131,80 @@ bool BlockManager::LoadBlockDefinitions(const std::string& jsonPath) {
                         std::istreambuf_iterator<char>());
     file.close();
     
-    return ParseJsonContent(content);
+    bool parsed = ParseJsonContent(content);
+    AssignTextureLayers();
+    return parsed;
+}
+
+void BlockManager::AssignTextureLayers() {
+    m_textureLayerSources.clear();
+    m_textureLayers.clear();
+    
+    // Blocks sharing a texture file (and tint) share its layer
+    std::map<std::tuple<std::string, float, float, float>, uint16_t> layerByTexture;
+    auto acquireLayer = [&](const TextureLayerSource& source) -> uint16_t {
+        if (source.file.empty()) {
+            return 0;
+        }
+        auto key = std::make_tuple(source.file, source.tintR, source.tintG, source.tintB);
+        auto it = layerByTexture.find(key);
+        if (it != layerByTexture.end()) {
+            return it->second;
+        }
+        uint16_t layer = static_cast<uint16_t>(m_textureLayerSources.size());
+        m_textureLayerSources.push_back(source);
+        layerByTexture.emplace(key, layer);
+        return layer;
+    };
+    
+    // Assign in BlockType order so layer numbers do not depend on hash map iteration
+    std::vector<BlockType> blockTypes = GetAllBlockTypes();
+    std::sort(blockTypes.begin(), blockTypes.end());
+    if (!blockTypes.empty()) {
+        m_textureLayers.resize(static_cast<size_t>(blockTypes.back()) + 1);
+    }
+    
+    for (BlockType blockType : blockTypes) {
+        if (blockType == BlockType::AIR) {
+            continue;
+        }
+        const BlockTextureInfo& info = GetTextureInfo(blockType);
+        BlockTextureLayers& layers = m_textureLayers[static_cast<size_t>(blockType)];
+        
+        // Grass tints its top and the side overlay (the bottom is plain dirt); leaves tint every face.
+        // Biome-tinted blocks take their colour from the biome alone, as the old per-block draws did.
+        bool biomeTinted = true;
+        if (blockType == BlockType::GRASS) {
+            layers.topTint = BiomeTint::GRASS;
+            layers.sideTint = BiomeTint::GRASS;
+        } else if (IsLeafBlock(blockType)) {
+            layers.topTint = layers.bottomTint = layers.sideTint = BiomeTint::FOLIAGE;
+        } else {
+            biomeTinted = false;
+        }
+        auto source = [&](const std::string& file) -> TextureLayerSource {
+            if (biomeTinted) {
+                return {file, 1.0f, 1.0f, 1.0f};
+            }
+            return {file, info.tintR, info.tintG, info.tintB};
+        };
+        
+        // Each face uses its own texture when one is given, otherwise the shared one
+        const std::string& fallback = !info.all.empty() ? info.all : info.sides;
+        if (!info.overlay.empty()) {
+            // The overlay has to sit right after its base layer, so this pair is never shared
+            layers.side = static_cast<uint16_t>(m_textureLayerSources.size());
+            m_textureLayerSources.push_back(source(info.sides.empty() ? fallback : info.sides));
+            m_textureLayerSources.push_back(source(info.overlay));
+            layers.sideOverlay = true;
+        } else {
+            layers.side = acquireLayer(source(info.sides.empty() ? fallback : info.sides));
+        }
+        layers.top = acquireLayer(source(info.top.empty() ? fallback : info.top));
+        layers.bottom = acquireLayer(source(info.bottom.empty() ? fallback : info.bottom));
+    }
+    
+    DEBUG_TEXTURE("Assigned " << m_textureLayerSources.size() << " texture array layers for " << blockTypes.size() << " block types");
 }
 
 bool BlockManager::ParseJsonContent(const std::string& jsonContent) {
@@ -1,16 +1,26 @@
 #include "Chunk.h"
-#include "World.h"
+#include "ChunkMesher.h"
 #include "BiomeSystem.h"
+#include "Debug.h"
+#include "GenerationRandom.h"
+#include "PerlinNoise.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 
+Chunk::MeshingMode Chunk::s_meshingMode = Chunk::MeshingMode::GREEDY;
+Chunk::MeshPools* Chunk::s_meshPools = nullptr;
+
 Chunk::Chunk() : m_chunkX(0), m_chunkZ(0), m_meshGenerated(false) {
     Clear();
+    m_sectionVisibility.fill(SECTION_VISIBILITY_ALL);
 }
 
 Chunk::Chunk(int chunkX, int chunkZ) : m_chunkX(chunkX), m_chunkZ(chunkZ), m_meshGenerated(false) {
     Clear();
+    m_sectionVisibility.fill(SECTION_VISIBILITY_ALL);
 }
 
 Chunk::~Chunk() {
@@ -21,14 +31,14 @@ Block Chunk::GetBlock(int x, int y, int z) const {
     if (!IsValidPosition(x, y, z)) {
         return Block(BlockType::AIR);
     }
-    return m_blocks[x][y][z];
+    return Block(GetTypeAt(x, y, z));
 }
 
 void Chunk::SetBlock(int x, int y, int z, BlockType type) {
     if (!IsValidPosition(x, y, z)) {
         return;
     }
-    m_blocks[x][y][z].SetType(type);
+    SetTypeAt(x, y, z, type);
     // Mark mesh as dirty when blocks change
     m_meshGenerated = false;
 }
@@ -37,7 +47,7 @@ void Chunk::SetBlock(int x, int y, int z, const Block& block) {
     if (!IsValidPosition(x, y, z)) {
         return;
     }
-    m_blocks[x][y][z] = block;
+    SetTypeAt(x, y, z, block.GetType());
     // Mark mesh as dirty when blocks change
     m_meshGenerated = false;
 }
@@ -49,245 +59,305 @@ bool Chunk::IsValidPosition(int x, int y, int z) const {
 }
 
 void Chunk::Fill(BlockType type) {
-    for (int x = 0; x < CHUNK_WIDTH; ++x) {
-        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
-            for (int z = 0; z < CHUNK_DEPTH; ++z) {
-                m_blocks[x][y][z].SetType(type);
-            }
-        }
+    // Uniform sections collapse to a single palette entry, so a fill is one write per section
+    for (ChunkSection& section : m_sections) {
+        section.Fill(type);
+    }
+    for (int heightmap = 0; heightmap < static_cast<int>(HeightmapType::COUNT); ++heightmap) {
+        int16_t height = MatchesHeightmap(type, static_cast<HeightmapType>(heightmap)) ? CHUNK_HEIGHT - 1 : -1;
+        m_heightmaps[heightmap].fill(height);
     }
     m_meshGenerated = false;
 }
 
-void Chunk::Clear() {
-    Fill(BlockType::AIR);
+void Chunk::SetBlockManager(const BlockManager* blockManager) {
+    if (blockManager == m_blockManager) {
+        return;
+    }
+    // Categories decide which heightmaps a block counts towards, so reclassify every column
+    m_blockManager = blockManager;
+    RebuildHeightmaps();
 }
 
-void Chunk::ClearMesh() {
-    for (auto& pair : m_blockMeshes) {
-        BlockMesh& mesh = pair.second;
-        if (mesh.VAO) {
-            glDeleteVertexArrays(1, &mesh.VAO);
-            mesh.VAO = 0;
+bool Chunk::MatchesHeightmap(BlockType type, HeightmapType heightmap) const {
+    switch (heightmap) {
+        case HeightmapType::NON_AIR:
+            return type != BlockType::AIR;
+        case HeightmapType::SOLID:
+            // Same rule as player collision: ground plants are walked through
+            return type != BlockType::AIR && !(m_blockManager && m_blockManager->IsGround(type));
+        case HeightmapType::LIGHT_BLOCKING:
+            return IsOpaqueForCulling(type, m_blockManager);
+        default:
+            return false;
+    }
+}
+
+void Chunk::UpdateHeightmaps(int x, int y, int z, BlockType type) {
+    const int column = z * CHUNK_WIDTH + x;
+    for (int heightmap = 0; heightmap < static_cast<int>(HeightmapType::COUNT); ++heightmap) {
+        int16_t& height = m_heightmaps[heightmap][column];
+        if (MatchesHeightmap(type, static_cast<HeightmapType>(heightmap))) {
+            if (y > height) {
+                height = static_cast<int16_t>(y);
+            }
+        } else if (y == height) {
+            // The top block of this column was removed, find the next one down
+            height = static_cast<int16_t>(ScanColumnDown(x, z, y - 1, static_cast<HeightmapType>(heightmap)));
         }
-        if (mesh.VBO) {
-            glDeleteBuffers(1, &mesh.VBO);
-            mesh.VBO = 0;
+    }
+}
+
+int Chunk::ScanColumnDown(int x, int z, int startY, HeightmapType type) const {
+    int y = std::min(startY, CHUNK_HEIGHT - 1);
+    while (y >= 0) {
+        int sectionY = y >> 4;
+        if (m_sections[sectionY].IsEmpty()) {
+            // Nothing in an empty section can match, jump to the top of the one below
+            y = sectionY * SECTION_SIZE - 1;
+            continue;
+        }
+        if (MatchesHeightmap(GetTypeAt(x, y, z), type)) {
+            return y;
         }
-        mesh.vertexCount = 0;
+        --y;
     }
-    m_blockMeshes.clear();
-    
-    // Clear grass face meshes too
-    for (auto& pair : m_grassFaceMeshes) {
-        BlockMesh& mesh = pair.second;
-        if (mesh.VAO) {
-            glDeleteVertexArrays(1, &mesh.VAO);
-            mesh.VAO = 0;
+    return -1;
+}
+
+void Chunk::RebuildHeightmaps() {
+    for (int z = 0; z < CHUNK_DEPTH; ++z) {
+        for (int x = 0; x < CHUNK_WIDTH; ++x) {
+            for (int heightmap = 0; heightmap < static_cast<int>(HeightmapType::COUNT); ++heightmap) {
+                m_heightmaps[heightmap][z * CHUNK_WIDTH + x] =
+                    static_cast<int16_t>(ScanColumnDown(x, z, CHUNK_HEIGHT - 1, static_cast<HeightmapType>(heightmap)));
+            }
+        }
+    }
+}
+
+int Chunk::FindHighestBlockBelow(int x, int z, int maxY, HeightmapType type) const {
+    if (x < 0 || x >= CHUNK_WIDTH || z < 0 || z >= CHUNK_DEPTH || maxY < 0) {
+        return -1;
+    }
+    int height = GetHeight(x, z, type);
+    if (height <= maxY) {
+        return height; // Common case: nothing overhangs the query point
+    }
+    return ScanColumnDown(x, z, maxY, type);
+}
+
+bool Chunk::GetOccupiedYRange(int& minY, int& maxY) const {
+    // The top comes straight from the heightmaps; the bottom is the first occupancy row with a block in it
+    maxY = -1;
+    for (int16_t height : m_heightmaps[static_cast<int>(HeightmapType::NON_AIR)]) {
+        maxY = std::max(maxY, static_cast<int>(height));
+    }
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT && maxY >= 0; ++sectionY) {
+        if (m_sections[sectionY].IsEmpty()) {
+            continue;
         }
-        if (mesh.VBO) {
-            glDeleteBuffers(1, &mesh.VBO);
-            mesh.VBO = 0;
+        for (int y = 0; y < SECTION_SIZE; ++y) {
+            for (int z = 0; z < CHUNK_DEPTH; ++z) {
+                if (m_sections[sectionY].GetOccupancyRow(y, z) != 0) {
+                    minY = sectionY * SECTION_SIZE + y;
+                    return true;
+                }
+            }
         }
-        mesh.vertexCount = 0;
     }
-    m_grassFaceMeshes.clear();
-    
-    // Clear log face meshes too
-    for (auto& pair : m_logFaceMeshes) {
-        BlockMesh& mesh = pair.second;
-        if (mesh.VAO) {
-            glDeleteVertexArrays(1, &mesh.VAO);
-            mesh.VAO = 0;
+    return false;
+}
+
+int Chunk::FindSurfaceBlock(int x, int z, BlockType surfaceType) const {
+    // Start at the top of the column instead of the top of the world; usually the
+    // top block is the surface itself, otherwise (e.g. under leaves) scan the short gap below it
+    for (int y = GetHeight(x, z, HeightmapType::NON_AIR); y >= 0; --y) {
+        if (GetTypeAt(x, y, z) == surfaceType) {
+            return y;
         }
-        if (mesh.VBO) {
-            glDeleteBuffers(1, &mesh.VBO);
-            mesh.VBO = 0;
+    }
+    return -1;
+}
+
+void Chunk::Clear() {
+    Fill(BlockType::AIR);
+}
+
+size_t Chunk::GetMemoryUsage() const {
+    size_t total = 0;
+    for (const ChunkSection& section : m_sections) {
+        total += section.GetMemoryUsage();
+    }
+    return total;
+}
+
+void Chunk::CompactStorage() {
+    for (ChunkSection& section : m_sections) {
+        section.Compact();
+    }
+}
+
+void Chunk::ClearMesh() {
+    for (int pass = 0; pass < MESH_PASS_COUNT; ++pass) {
+        PassMesh& mesh = m_passMeshes[pass];
+        if (s_meshPools) {
+            for (ChunkMeshPool::Range& range : mesh.sectionRanges) {
+                (*s_meshPools)[pass].Free(range);
+            }
         }
-        mesh.vertexCount = 0;
+        mesh = PassMesh();
     }
-    m_logFaceMeshes.clear();
     
+    m_meshMinY = m_meshMaxY = -1;
+    m_sectionVisibility.fill(SECTION_VISIBILITY_ALL);
     m_meshGenerated = false;
 }
 
+bool Chunk::HasMesh() const {
+    for (const PassMesh& mesh : m_passMeshes) {
+        if (mesh.vertexCount > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void Chunk::GenerateMesh(const World* world, const BlockManager* blockManager) {
-    // Clear existing meshes
-    ClearMesh();
-    
-    // Group vertices by block type
-    std::unordered_map<BlockType, std::vector<float>> blockVertices;
+    if (blockManager) {
+        SetBlockManager(blockManager);
+    }
     
-    // Separate vertex groups for grass faces
-    std::unordered_map<GrassFaceType, std::vector<float>> grassFaceVertices;
+    // Synchronous path: snapshot, build and upload on the calling thread.
+    // The World normally runs the build step on its mesh workers instead (see World::RequestChunkMesh)
+    std::unique_ptr<ChunkMeshSnapshot> snapshot = std::make_unique<ChunkMeshSnapshot>(); // Too large for the stack
+    ChunkMesher::CaptureSnapshot(*snapshot, *this, world, blockManager);
     
-    // Separate vertex groups for log faces (similar to grass)
-    std::unordered_map<GrassFaceType, std::vector<float>> logFaceVertices;
+    ChunkMeshData meshData;
+    ChunkMesher(*snapshot, blockManager).Build(meshData);
+    ApplyMesh(meshData);
+}
+
+void Chunk::ApplyMesh(const ChunkMeshData& meshData) {
+    // A full build replaces every mesh; a partial one only rewrites its sections' ranges
+    if (meshData.sectionMask == ALL_SECTIONS_MASK) {
+        ClearMesh();
+    }
     
-    // Generate mesh data for all non-air blocks, grouped by type
-    for (int x = 0; x < CHUNK_WIDTH; ++x) {
-        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
-            for (int z = 0; z < CHUNK_DEPTH; ++z) {
-                BlockType blockType = m_blocks[x][y][z].GetType();
-                if (blockType != BlockType::AIR) {
-                    // Check if this is a ground block (should render as cross)
-                    if (blockManager && blockManager->IsGround(blockType)) {
-                        // Render ground blocks as diagonal cross sprites
-                        AddCrossToMesh(blockVertices[blockType], x, y, z, world);
-                    } else {
-                        // Check each face for visibility (standard cube rendering)
-                        for (int face = 0; face < 6; ++face) {
-                            if (ShouldRenderFace(x, y, z, face, world, blockManager)) {
-                            // Handle grass blocks specially
-                            if (blockType == BlockType::GRASS) {
-                                // Group grass faces by face type for different textures
-                                if (face == FACE_TOP) {
-                                    AddFaceToMesh(grassFaceVertices[GRASS_TOP], x, y, z, face, world, blockManager);
-                                } else if (face == FACE_BOTTOM) {
-                                    AddFaceToMesh(grassFaceVertices[GRASS_BOTTOM], x, y, z, face, world, blockManager);
-                                } else {
-                                    // Side faces (FRONT, BACK, LEFT, RIGHT) - flip texture vertically  
-                                    AddFaceToMesh(grassFaceVertices[GRASS_SIDE], x, y, z, face, world, blockManager, true);
-                                }
-                            } else if (blockType == BlockType::OAK_LOG || blockType == BlockType::BIRCH_LOG || blockType == BlockType::DARK_OAK_LOG) {
-                                // Handle log blocks - top/bottom use different texture than sides
-                                if (face == FACE_TOP || face == FACE_BOTTOM) {
-                                    // Top and bottom faces use log_top texture
-                                    AddFaceToMesh(logFaceVertices[GRASS_TOP], x, y, z, face, world, blockManager);
-                                } else {
-                                    // Side faces (FRONT, BACK, LEFT, RIGHT) use log side texture
-                                    AddFaceToMesh(logFaceVertices[GRASS_SIDE], x, y, z, face, world, blockManager);
-                                }
-                            } else {
-                                // Add face vertices to the appropriate block type group
-                                AddFaceToMesh(blockVertices[blockType], x, y, z, face, world, blockManager);
-                            }
-                        }
-                    }
-                    } // end else (standard cube rendering)
-                }
-            }
+    if (!s_meshPools) {
+        return; // No renderer to upload to
+    }
+    for (int pass = 0; pass < MESH_PASS_COUNT; ++pass) {
+        UpdateMeshSections(m_passMeshes[pass], (*s_meshPools)[pass], meshData.passVertices[pass], meshData.sectionMask);
+    }
+    m_meshMinY = meshData.minOccupiedY;
+    m_meshMaxY = meshData.maxOccupiedY;
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        if ((meshData.sectionMask >> sectionY) & 1) {
+            m_sectionVisibility[sectionY] = meshData.sectionVisibility[sectionY];
         }
     }
     
-    // Create OpenGL meshes for each block type that has vertices
-    for (auto& pair : blockVertices) {
-        BlockType blockType = pair.first;
-        std::vector<float>& vertices = pair.second;
-        
-        if (vertices.empty()) {
+    m_meshGenerated = true;
+}
+
+void Chunk::UpdateMeshSections(PassMesh& mesh, ChunkMeshPool& pool, const ChunkSectionVertices& sections, uint16_t sectionMask) {
+    auto rebuilt = [&](int sectionY) { return ((sectionMask >> sectionY) & 1) != 0; };
+    bool fullRebuild = sectionMask == ALL_SECTIONS_MASK;
+    
+    // Rebuilt sections are written in place when they still fit their range. The others are
+    // released first, so a full rebuild gets its sections back as one contiguous run where possible
+    std::array<bool, CHUNK_SECTION_COUNT> reallocate = {};
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        if (!rebuilt(sectionY)) {
             continue;
         }
-        
-        BlockMesh& mesh = m_blockMeshes[blockType];
-        
-        // Create OpenGL mesh
-        glGenVertexArrays(1, &mesh.VAO);
-        glBindVertexArray(mesh.VAO);
-        
-        glGenBuffers(1, &mesh.VBO);
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-        
-        // Position attribute (x, y, z) - location 0
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        
-        // Ambient occlusion attribute (ao) - location 1
-        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        
-        // Texture coordinate attribute (u, v) - location 2
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(4 * sizeof(float)));
-        glEnableVertexAttribArray(2);
-        
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        
-        mesh.vertexCount = vertices.size() / 6; // 6 floats per vertex
+        int count = static_cast<int>(sections[sectionY].size());
+        reallocate[sectionY] = fullRebuild || count == 0 || count > mesh.sectionRanges[sectionY].capacity;
+        if (reallocate[sectionY]) {
+            pool.Free(mesh.sectionRanges[sectionY]);
+        }
     }
     
-    // Create OpenGL meshes for grass faces that have vertices
-    for (auto& pair : grassFaceVertices) {
-        GrassFaceType faceType = pair.first;
-        std::vector<float>& vertices = pair.second;
-        
-        if (vertices.empty()) {
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        if (!rebuilt(sectionY)) {
             continue;
         }
-        
-        BlockMesh& mesh = m_grassFaceMeshes[faceType];
-        
-        // Create OpenGL mesh
-        glGenVertexArrays(1, &mesh.VAO);
-        glBindVertexArray(mesh.VAO);
-        
-        glGenBuffers(1, &mesh.VBO);
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-        
-        // Position attribute (x, y, z) - location 0
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        
-        // Ambient occlusion attribute (ao) - location 1
-        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        
-        // Texture coordinate attribute (u, v) - location 2
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(4 * sizeof(float)));
-        glEnableVertexAttribArray(2);
-        
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        
-        mesh.vertexCount = vertices.size() / 6; // 6 floats per vertex
+        const std::vector<ChunkVertex>& vertices = sections[sectionY];
+        int count = static_cast<int>(vertices.size());
+        if (reallocate[sectionY]) {
+            // Edited sections get slack, as an edit is likely to be followed by more
+            int capacity = (fullRebuild || count == 0) ? count : ((count + count / 4 + SECTION_SLACK_VERTICES) & ~3);
+            mesh.sectionRanges[sectionY] = pool.Allocate(capacity);
+        }
+        pool.Upload(mesh.sectionRanges[sectionY], vertices);
+        mesh.sectionCount[sectionY] = count;
     }
     
-    // Create OpenGL meshes for log faces that have vertices
-    for (auto& pair : logFaceVertices) {
-        GrassFaceType faceType = pair.first;
-        std::vector<float>& vertices = pair.second;
-        
-        if (vertices.empty()) {
+    mesh.vertexCount = 0;
+    for (int count : mesh.sectionCount) {
+        mesh.vertexCount += count;
+    }
+}
+
+void Chunk::QueueMeshPass(MeshPass pass, uint16_t sectionMask) const {
+    if (!s_meshPools) {
+        return;
+    }
+    const PassMesh& mesh = m_passMeshes[pass];
+    ChunkMeshPool& pool = (*s_meshPools)[pass];
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        if (!((sectionMask >> sectionY) & 1)) {
             continue;
         }
-        
-        BlockMesh& mesh = m_logFaceMeshes[faceType];
-        
-        // Create OpenGL mesh
-        glGenVertexArrays(1, &mesh.VAO);
-        glBindVertexArray(mesh.VAO);
-        
-        glGenBuffers(1, &mesh.VBO);
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-        
-        // Position attribute (x, y, z) - location 0
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-        
-        // Ambient occlusion attribute (ao) - location 1
-        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        
-        // Texture coordinate attribute (u, v) - location 2
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(4 * sizeof(float)));
-        glEnableVertexAttribArray(2);
-        
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
-        
-        mesh.vertexCount = vertices.size() / 6; // 6 floats per vertex
+        pool.AddCommand(mesh.sectionRanges[sectionY], mesh.sectionCount[sectionY]);
     }
-    
-    m_meshGenerated = true;
+}
+
+uint16_t Chunk::GetMeshSectionMask() const {
+    uint16_t mask = 0;
+    for (const PassMesh& mesh : m_passMeshes) {
+        for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+            if (mesh.sectionCount[sectionY] > 0) {
+                mask |= static_cast<uint16_t>(1u << sectionY);
+            }
+        }
+    }
+    return mask;
+}
+
+int Chunk::GetVertexCount() const {
+    int total = 0;
+    for (const PassMesh& mesh : m_passMeshes) {
+        total += mesh.vertexCount;
+    }
+    return total;
 }
 
 void Chunk::UpdateBlockMesh(int x, int y, int z, const World* world, const BlockManager* blockManager) {
-    // For now, fall back to full mesh regeneration
-    // TODO: Implement truly incremental mesh updates
-    GenerateMesh(world, blockManager);
+    // Rebuild only the sections whose faces or ambient occlusion can see the edited block
+    if (blockManager) {
+        SetBlockManager(blockManager);
+    }
+    
+    std::unique_ptr<ChunkMeshSnapshot> snapshot = std::make_unique<ChunkMeshSnapshot>();
+    ChunkMesher::CaptureSnapshot(*snapshot, *this, world, blockManager, GetEditSectionMask(y));
+    
+    ChunkMeshData meshData;
+    ChunkMesher(*snapshot, blockManager).Build(meshData);
+    ApplyMesh(meshData);
+}
+
+uint16_t Chunk::GetEditSectionMask(int y) {
+    // The blocks above and below sample the edited one as well, so an edit on a section
+    // border also touches the section across it
+    uint16_t mask = 0;
+    for (int sampleY = y - 1; sampleY <= y + 1; ++sampleY) {
+        if (sampleY >= 0 && sampleY < CHUNK_HEIGHT) {
+            mask |= static_cast<uint16_t>(1u << (sampleY >> 4));
+        }
+    }
+    return mask;
 }
 
 void Chunk::BatchBlockUpdate(int x, int y, int z, BlockType oldType, BlockType newType) {
@@ -313,7 +383,7 @@ void Chunk::ProcessBatchedUpdates(const World* world, const BlockManager* blockM
     // Apply all pending updates to the chunk
     for (const auto& update : m_pendingUpdates) {
         if (IsValidPosition(update.x, update.y, update.z)) {
-            m_blocks[update.x][update.y][update.z].SetType(update.newType);
+            SetTypeAt(update.x, update.y, update.z, update.newType);
         }
     }
     
@@ -327,331 +397,26 @@ void Chunk::ProcessBatchedUpdates(const World* world, const BlockManager* blockM
     std::cout << "[CHUNK] Completed batched mesh update for chunk (" << m_chunkX << ", " << m_chunkZ << ")" << std::endl;
 }
 
-void Chunk::RenderMesh() const {
-    // This method now renders all block types - but we'll change this approach
-    for (const auto& pair : m_blockMeshes) {
-        const BlockMesh& mesh = pair.second;
-        if (mesh.VAO != 0 && mesh.vertexCount > 0) {
-            glBindVertexArray(mesh.VAO);
-            glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
-            glBindVertexArray(0);
-        }
-    }
-}
-
-void Chunk::RenderMeshForBlockType(BlockType blockType) const {
-    auto it = m_blockMeshes.find(blockType);
-    if (it != m_blockMeshes.end()) {
-        const BlockMesh& mesh = it->second;
-        if (mesh.VAO != 0 && mesh.vertexCount > 0) {
-            glBindVertexArray(mesh.VAO);
-            glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
-            glBindVertexArray(0);
-        }
-    }
-}
-
-void Chunk::RenderGrassMesh(GrassFaceType faceType) const {
-    auto it = m_grassFaceMeshes.find(faceType);
-    if (it != m_grassFaceMeshes.end()) {
-        const BlockMesh& mesh = it->second;
-        if (mesh.VAO != 0 && mesh.vertexCount > 0) {
-            glBindVertexArray(mesh.VAO);
-            glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
-            glBindVertexArray(0);
-        }
-    }
-}
-
-void Chunk::RenderLogMesh(GrassFaceType faceType) const {
-    auto it = m_logFaceMeshes.find(faceType);
-    if (it != m_logFaceMeshes.end()) {
-        const BlockMesh& mesh = it->second;
-        if (mesh.VAO != 0 && mesh.vertexCount > 0) {
-            glBindVertexArray(mesh.VAO);
-            glDrawArrays(GL_TRIANGLES, 0, mesh.vertexCount);
-            glBindVertexArray(0);
-        }
-    }
-}
-
-std::vector<BlockType> Chunk::GetBlockTypesInChunk() const {
-    std::vector<BlockType> blockTypes;
-    for (const auto& pair : m_blockMeshes) {
-        if (pair.second.vertexCount > 0) {
-            blockTypes.push_back(pair.first);
-        }
-    }
-    return blockTypes;
-}
-
-bool Chunk::ShouldRenderFace(int x, int y, int z, int faceDirection, const World* world, const BlockManager* blockManager) const {
-    Block neighbor = GetNeighborBlock(x, y, z, faceDirection, world);
-    BlockType currentBlockType = m_blocks[x][y][z].GetType();
-    
-    // Always show faces adjacent to air
-    if (neighbor.IsAir()) {
-        return true;
-    }
-    
-    // Special handling for water blocks
-    if (currentBlockType == BlockType::WATER_STILL || currentBlockType == BlockType::WATER_FLOW) {
-        BlockType neighborType = neighbor.GetType();
-        // For water: only render faces that are NOT adjacent to other water blocks
-        return neighborType != BlockType::WATER_STILL && neighborType != BlockType::WATER_FLOW;
+bool Chunk::IsOpaqueForCulling(BlockType type, const BlockManager* blockManager) {
+    // Mirrors ChunkMesher::ShouldRenderFace: a neighbour of this type hides the faces of non-water blocks
+    if (type == BlockType::AIR || type == BlockType::WATER_STILL || type == BlockType::WATER_FLOW) {
+        return false;
     }
-    
-    // If we have a BlockManager, also show faces adjacent to transparent or ground blocks
     if (blockManager) {
-        BlockType neighborType = neighbor.GetType();
-        
-        // Special case: always render faces adjacent to water blocks (regardless of transparency detection)
-        if (neighborType == BlockType::WATER_STILL || neighborType == BlockType::WATER_FLOW) {
-            return true;
-        }
-        
-        return blockManager->IsTransparent(neighborType) || blockManager->IsGround(neighborType);
+        return !blockManager->IsTransparent(type) && !blockManager->IsGround(type);
     }
-    
-    // Fallback to original behavior if no BlockManager
-    return false;
+    return true;
 }
 
-Block Chunk::GetNeighborBlock(int x, int y, int z, int faceDirection, const World* world) const {
-    int neighborX = x;
-    int neighborY = y;
-    int neighborZ = z;
-    
-    // Calculate neighbor position based on face direction
-    switch (faceDirection) {
-        case FACE_FRONT:  neighborZ++; break;  // +Z
-        case FACE_BACK:   neighborZ--; break;  // -Z
-        case FACE_LEFT:   neighborX--; break;  // -X
-        case FACE_RIGHT:  neighborX++; break;  // +X
-        case FACE_BOTTOM: neighborY--; break;  // -Y
-        case FACE_TOP:    neighborY++; break;  // +Y
-    }
-    
-    // If neighbor is within this chunk, get it directly
-    if (IsValidPosition(neighborX, neighborY, neighborZ)) {
-        return m_blocks[neighborX][neighborY][neighborZ];
-    }
-    
-    // Neighbor is outside this chunk - convert to world coordinates and query world
-    if (world) {
-        int worldX = m_chunkX * CHUNK_WIDTH + neighborX;
-        int worldY = neighborY;
-        int worldZ = m_chunkZ * CHUNK_DEPTH + neighborZ;
-        
-        return world->GetBlock(worldX, worldY, worldZ);
-    }
-    
-    // No world access - assume air (this shouldn't happen in normal usage)
-    return Block(BlockType::AIR);
-}
-
-void Chunk::AddFaceToMesh(std::vector<float>& vertices, int x, int y, int z, int faceDirection, const World* world, const BlockManager* blockManager, bool flipTextureV) const {
-    BlockType currentBlockType = m_blocks[x][y][z].GetType();
-    // Convert local chunk coordinates to world position for rendering
-    float worldX = static_cast<float>(m_chunkX * CHUNK_WIDTH + x);
-    float worldY = static_cast<float>(y);
-    float worldZ = static_cast<float>(m_chunkZ * CHUNK_DEPTH + z);
-    
-    // Calculate texture coordinates for top and bottom based on flip setting
-    float vBottom = flipTextureV ? 1.0f : 0.0f;
-    float vTop = flipTextureV ? 0.0f : 1.0f;
-    
-    // Face vertices with position (3), AO (1), and texture coordinates (2) 
-    // Each vertex: x, y, z, ao_value, u, v (6 floats per vertex)
-    
-    switch (faceDirection) {
-        case FACE_FRONT: { // +Z face
-            // Calculate AO for each vertex of the front face
-            float ao0 = CalculateVertexAO(x, y, z, FACE_FRONT, 0, world, blockManager); // Bottom-left
-            float ao1 = CalculateVertexAO(x, y, z, FACE_FRONT, 1, world, blockManager); // Bottom-right  
-            float ao2 = CalculateVertexAO(x, y, z, FACE_FRONT, 2, world, blockManager); // Top-right
-            float ao3 = CalculateVertexAO(x, y, z, FACE_FRONT, 3, world, blockManager); // Top-left
-            
-            float frontVertices[] = {
-                // Triangle 1: x, y, z, ao, u, v
-                worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao0, 0.0f, vBottom, // Bottom-left
-                worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f, ao1, 1.0f, vBottom, // Bottom-right
-                worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao2, 1.0f, vTop, // Top-right
-                // Triangle 2  
-                worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao2, 1.0f, vTop, // Top-right
-                worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f, ao3, 0.0f, vTop, // Top-left
-                worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao0, 0.0f, vBottom  // Bottom-left
-            };
-            vertices.insert(vertices.end(), frontVertices, frontVertices + 36);
-            break;
-        }
-        case FACE_BACK: { // -Z face
-            float ao0 = CalculateVertexAO(x, y, z, FACE_BACK, 0, world, blockManager);
-            float ao1 = CalculateVertexAO(x, y, z, FACE_BACK, 1, world, blockManager);
-            float ao2 = CalculateVertexAO(x, y, z, FACE_BACK, 2, world, blockManager);
-            float ao3 = CalculateVertexAO(x, y, z, FACE_BACK, 3, world, blockManager);
-            
-            float backVertices[] = {
-                worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 1.0f, vBottom,
-                worldX - 0.5f, worldY + 0.5f, worldZ - 0.5f, ao3, 1.0f, vTop,
-                worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f, ao2, 0.0f, vTop,
-                worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f, ao2, 0.0f, vTop,
-                worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f, ao1, 0.0f, vBottom,
-                worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 1.0f, vBottom
-            };
-            vertices.insert(vertices.end(), backVertices, backVertices + 36);
-            break;
-        }
-        case FACE_LEFT: { // -X face
-            float ao0 = CalculateVertexAO(x, y, z, FACE_LEFT, 0, world, blockManager);
-            float ao1 = CalculateVertexAO(x, y, z, FACE_LEFT, 1, world, blockManager);
-            float ao2 = CalculateVertexAO(x, y, z, FACE_LEFT, 2, world, blockManager);
-            float ao3 = CalculateVertexAO(x, y, z, FACE_LEFT, 3, world, blockManager);
-            
-            float leftVertices[] = {
-                worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 0.0f, vBottom,
-                worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao1, 1.0f, vBottom,
-                worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f, ao2, 1.0f, vTop,
-                worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f, ao2, 1.0f, vTop,
-                worldX - 0.5f, worldY + 0.5f, worldZ - 0.5f, ao3, 0.0f, vTop,
-                worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 0.0f, vBottom
-            };
-            vertices.insert(vertices.end(), leftVertices, leftVertices + 36);
-            break;
-        }
-        case FACE_RIGHT: { // +X face
-            float ao0 = CalculateVertexAO(x, y, z, FACE_RIGHT, 0, world, blockManager);
-            float ao1 = CalculateVertexAO(x, y, z, FACE_RIGHT, 1, world, blockManager);
-            float ao2 = CalculateVertexAO(x, y, z, FACE_RIGHT, 2, world, blockManager);
-            float ao3 = CalculateVertexAO(x, y, z, FACE_RIGHT, 3, world, blockManager);
-            
-            float rightVertices[] = {
-                worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 1.0f, vBottom,
-                worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f, ao3, 1.0f, vTop,
-                worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao2, 0.0f, vTop,
-                worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao2, 0.0f, vTop,
-                worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f, ao1, 0.0f, vBottom,
-                worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 1.0f, vBottom
-            };
-            vertices.insert(vertices.end(), rightVertices, rightVertices + 36);
-            break;
-        }
-        case FACE_BOTTOM: { // -Y face
-            float ao0 = CalculateVertexAO(x, y, z, FACE_BOTTOM, 0, world, blockManager);
-            float ao1 = CalculateVertexAO(x, y, z, FACE_BOTTOM, 1, world, blockManager);
-            float ao2 = CalculateVertexAO(x, y, z, FACE_BOTTOM, 2, world, blockManager);
-            float ao3 = CalculateVertexAO(x, y, z, FACE_BOTTOM, 3, world, blockManager);
-            
-            float bottomVertices[] = {
-                worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 0.0f, 0.0f,
-                worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f, ao1, 1.0f, 0.0f,
-                worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f, ao2, 1.0f, 1.0f,
-                worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f, ao2, 1.0f, 1.0f,
-                worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao3, 0.0f, 1.0f,
-                worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao0, 0.0f, 0.0f
-            };
-            vertices.insert(vertices.end(), bottomVertices, bottomVertices + 36);
-            break;
-        }
-        case FACE_TOP: { // +Y face
-            float ao0 = CalculateVertexAO(x, y, z, FACE_TOP, 0, world, blockManager);
-            float ao1 = CalculateVertexAO(x, y, z, FACE_TOP, 1, world, blockManager);
-            float ao2 = CalculateVertexAO(x, y, z, FACE_TOP, 2, world, blockManager);
-            float ao3 = CalculateVertexAO(x, y, z, FACE_TOP, 3, world, blockManager);
-            
-            // Water blocks have lowered surface at 15/16 height (0.9375)
-            float topY = worldY + 0.5f;
-            if (currentBlockType == BlockType::WATER_STILL || currentBlockType == BlockType::WATER_FLOW) {
-                topY = worldY - 0.5f + 0.9375f; // 15/16 height from block bottom
-            }
-            
-            float topVertices[] = {
-                worldX - 0.5f, topY, worldZ - 0.5f, ao0, 0.0f, 0.0f,
-                worldX - 0.5f, topY, worldZ + 0.5f, ao3, 1.0f, 0.0f,
-                worldX + 0.5f, topY, worldZ + 0.5f, ao2, 1.0f, 1.0f,
-                worldX + 0.5f, topY, worldZ + 0.5f, ao2, 1.0f, 1.0f,
-                worldX + 0.5f, topY, worldZ - 0.5f, ao1, 0.0f, 1.0f,
-                worldX - 0.5f, topY, worldZ - 0.5f, ao0, 0.0f, 0.0f
-            };
-            vertices.insert(vertices.end(), topVertices, topVertices + 36);
-            break;
-        }
-    }
-}
-
-void Chunk::AddCrossToMesh(std::vector<float>& vertices, int x, int y, int z, const World* world) const {
-    // Convert local chunk coordinates to world position for rendering
-    float worldX = static_cast<float>(m_chunkX * CHUNK_WIDTH + x);
-    float worldY = static_cast<float>(y);
-    float worldZ = static_cast<float>(m_chunkZ * CHUNK_DEPTH + z);
-    
-    // For cross sprites, we don't need complex AO calculation, use a simple value
-    float ao = 1.0f; // Full brightness for plants
-    
-    // Create four quads (two diagonal planes, each with front and back faces) to form a cross
-    // Each plane shows the full texture (0,0) to (1,1)
-    
-    // First diagonal plane FRONT FACE: from bottom-left-back to top-right-front
-    float plane1FrontVertices[] = {
-        // Triangle 1: x, y, z, ao, u, v
-        worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao, 0.0f, 1.0f, // Bottom-left-back
-        worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f, ao, 1.0f, 1.0f, // Bottom-right-front
-        worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao, 1.0f, 0.0f, // Top-right-front
-        // Triangle 2
-        worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao, 1.0f, 0.0f, // Top-right-front
-        worldX - 0.5f, worldY + 0.5f, worldZ - 0.5f, ao, 0.0f, 0.0f, // Top-left-back
-        worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao, 0.0f, 1.0f  // Bottom-left-back
-    };
-    
-    // First diagonal plane BACK FACE: reverse winding order for backface culling
-    float plane1BackVertices[] = {
-        // Triangle 1: x, y, z, ao, u, v (reversed winding)
-        worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao, 0.0f, 1.0f, // Bottom-left-back
-        worldX - 0.5f, worldY + 0.5f, worldZ - 0.5f, ao, 0.0f, 0.0f, // Top-left-back
-        worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao, 1.0f, 0.0f, // Top-right-front
-        // Triangle 2
-        worldX + 0.5f, worldY + 0.5f, worldZ + 0.5f, ao, 1.0f, 0.0f, // Top-right-front
-        worldX + 0.5f, worldY - 0.5f, worldZ + 0.5f, ao, 1.0f, 1.0f, // Bottom-right-front
-        worldX - 0.5f, worldY - 0.5f, worldZ - 0.5f, ao, 0.0f, 1.0f  // Bottom-left-back
-    };
-    
-    // Second diagonal plane FRONT FACE: from bottom-left-front to top-right-back
-    float plane2FrontVertices[] = {
-        // Triangle 1: x, y, z, ao, u, v
-        worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao, 0.0f, 1.0f, // Bottom-left-front
-        worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f, ao, 0.0f, 0.0f, // Top-left-front
-        worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f, ao, 1.0f, 0.0f, // Top-right-back
-        // Triangle 2
-        worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f, ao, 1.0f, 0.0f, // Top-right-back
-        worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f, ao, 1.0f, 1.0f, // Bottom-right-back
-        worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao, 0.0f, 1.0f  // Bottom-left-front
-    };
-    
-    // Second diagonal plane BACK FACE: reverse winding order for backface culling
-    float plane2BackVertices[] = {
-        // Triangle 1: x, y, z, ao, u, v (reversed winding)
-        worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao, 0.0f, 1.0f, // Bottom-left-front
-        worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f, ao, 1.0f, 0.0f, // Top-right-back
-        worldX - 0.5f, worldY + 0.5f, worldZ + 0.5f, ao, 0.0f, 0.0f, // Top-left-front
-        // Triangle 2
-        worldX + 0.5f, worldY + 0.5f, worldZ - 0.5f, ao, 1.0f, 0.0f, // Top-right-back
-        worldX - 0.5f, worldY - 0.5f, worldZ + 0.5f, ao, 0.0f, 1.0f, // Bottom-left-front
-        worldX + 0.5f, worldY - 0.5f, worldZ - 0.5f, ao, 1.0f, 1.0f  // Bottom-right-back
-    };
-    
-    // Add all four quads to the vertex buffer
-    vertices.insert(vertices.end(), plane1FrontVertices, plane1FrontVertices + 36); // 6 vertices * 6 floats each
-    vertices.insert(vertices.end(), plane1BackVertices, plane1BackVertices + 36);   // 6 vertices * 6 floats each
-    vertices.insert(vertices.end(), plane2FrontVertices, plane2FrontVertices + 36); // 6 vertices * 6 floats each
-    vertices.insert(vertices.end(), plane2BackVertices, plane2BackVertices + 36);   // 6 vertices * 6 floats each
+bool Chunk::IsSectionFullyOpaque(int sectionY, const BlockManager* blockManager) const {
+    const ChunkSection& section = m_sections[sectionY];
+    return section.IsUniform() && IsOpaqueForCulling(section.GetUniformType(), blockManager);
 }
 
 void Chunk::Generate(int seed, const BlockManager* blockManager) {
     // Fill all blocks with air first
     Clear();
-    
-    // Set up random number generator for block selection
-    std::mt19937 rng(seed + m_chunkX * 1000 + m_chunkZ);
+    SetBlockManager(blockManager);
     
     // Get available surface blocks (only blocks that have textures)
     std::vector<BlockType> surfaceBlocks;
@@ -696,26 +461,33 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
         surfaceBlocks = {BlockType::GRASS, BlockType::STONE, BlockType::DIRT};
     }
     
+    // Biomes of every column, shared by the terrain, tree and vegetation passes below
+    BiomeSystem::ComputeBiomeMap(m_chunkX, m_chunkZ, seed, m_biomeMap);
+    
+    // Sample every noise octave of the chunk up front, a row of 16 columns per batch
+    const int chunkWorldX = m_chunkX * CHUNK_WIDTH;
+    const int chunkWorldZ = m_chunkZ * CHUNK_DEPTH;
+    static_assert(CHUNK_WIDTH == PerlinNoise::BATCH_WIDTH && CHUNK_DEPTH == PerlinNoise::BATCH_WIDTH,
+                  "Terrain noise is sampled in 16x16 grids");
+    float coarseNoise[CHUNK_WIDTH * CHUNK_DEPTH];
+    float mediumNoise[CHUNK_WIDTH * CHUNK_DEPTH];
+    float fineNoise[CHUNK_WIDTH * CHUNK_DEPTH];
+    using Random = GenerationRandom;
+    PerlinNoise(Random::DeriveSeed(seed, Random::FEATURE_TERRAIN_NOISE, 0)).SampleGrid(chunkWorldX, chunkWorldZ, NOISE_SCALE_COARSE, coarseNoise);
+    PerlinNoise(Random::DeriveSeed(seed, Random::FEATURE_TERRAIN_NOISE, 1)).SampleGrid(chunkWorldX, chunkWorldZ, NOISE_SCALE, mediumNoise);
+    PerlinNoise(Random::DeriveSeed(seed, Random::FEATURE_TERRAIN_NOISE, 2)).SampleGrid(chunkWorldX, chunkWorldZ, NOISE_SCALE_FINE, fineNoise);
+    
     // Generate terrain using multiple octaves of noise for varied geography
     for (int x = 0; x < CHUNK_WIDTH; ++x) {
         for (int z = 0; z < CHUNK_DEPTH; ++z) {
-            // Convert local chunk coordinates to world coordinates
-            int worldX = m_chunkX * CHUNK_WIDTH + x;
-            int worldZ = m_chunkZ * CHUNK_DEPTH + z;
-            
-            // Get biome for this position using the new BiomeSystem
-            BiomeType biomeType = BiomeSystem::GetBiomeType(worldX, worldZ, seed);
-            
-            // Generate height using multiple noise octaves for varied terrain
-            double coarseNoise = Perlin(worldX * NOISE_SCALE_COARSE, worldZ * NOISE_SCALE_COARSE, seed);
-            double mediumNoise = Perlin(worldX * NOISE_SCALE, worldZ * NOISE_SCALE, seed + 1000);
-            double fineNoise = Perlin(worldX * NOISE_SCALE_FINE, worldZ * NOISE_SCALE_FINE, seed + 2000);
+            int column = z * CHUNK_WIDTH + x;
+            BiomeType biomeType = m_biomeMap.GetBiome(x, z);
             
             // Combine noise octaves with different weights for varied terrain
-            double combinedNoise = coarseNoise * 0.6 + mediumNoise * 0.3 + fineNoise * 0.1;
+            float combinedNoise = coarseNoise[column] * 0.6f + mediumNoise[column] * 0.3f + fineNoise[column] * 0.1f;
             
             // Map noise from [-1, 1] to [0, 1] and scale to height variation
-            double normalizedNoise = (combinedNoise + 1.0) * 0.5;
+            float normalizedNoise = (combinedNoise + 1.0f) * 0.5f;
             int terrainHeight = BASE_HEIGHT + static_cast<int>(normalizedNoise * MAX_HEIGHT_VARIATION);
             
             // Ensure terrain doesn't generate underwater - enforce minimum height above sea level
@@ -757,13 +529,13 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
                             break;
                     }
                     
-                    m_blocks[x][y][z].SetType(surfaceBlock);
+                    SetTypeAt(x, y, z, surfaceBlock);
                 } else if (y >= terrainHeight - 3) {
                     // Dirt layer (3 blocks deep)
-                    m_blocks[x][y][z].SetType(BlockType::DIRT);
+                    SetTypeAt(x, y, z, BlockType::DIRT);
                 } else {
                     // Stone layer below
-                    m_blocks[x][y][z].SetType(BlockType::STONE);
+                    SetTypeAt(x, y, z, BlockType::STONE);
                 }
             }
         }
@@ -771,24 +543,21 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
     
     // Generate cave tunnels using "cave worms" that create long stringy passages
     int caveBlocksCarved = 0;
-    std::mt19937 caveRng(seed + m_chunkX * 7841 + m_chunkZ * 9973);
+    GenerationRandom caveRng(seed, GenerationRandom::FEATURE_CAVES, m_chunkX, m_chunkZ);
     
     // Generate multiple cave worms per chunk
-    int numWorms = 2 + (caveRng() % 4); // 2-5 worms per chunk
+    int numWorms = 2 + caveRng.NextInt(4); // 2-5 worms per chunk
     
     for (int worm = 0; worm < numWorms; worm++) {
+        // Each worm draws from its own stream, so worms do not depend on how far earlier ones got
+        GenerationRandom wormRng = caveRng.Substream(worm);
+        
         // Start position for this worm (can be anywhere in chunk)
-        float startX = static_cast<float>(caveRng() % CHUNK_WIDTH);
-        float startZ = static_cast<float>(caveRng() % CHUNK_DEPTH);
+        float startX = static_cast<float>(wormRng.NextInt(CHUNK_WIDTH));
+        float startZ = static_cast<float>(wormRng.NextInt(CHUNK_DEPTH));
         
         // Find surface height at start position
-        int surfaceY = 0;
-        for (int y = CHUNK_HEIGHT - 1; y >= 0; y--) {
-            if (m_blocks[static_cast<int>(startX)][y][static_cast<int>(startZ)].GetType() != BlockType::AIR) {
-                surfaceY = y;
-                break;
-            }
-        }
+        int surfaceY = std::max(0, GetHeight(static_cast<int>(startX), static_cast<int>(startZ), HeightmapType::NON_AIR));
         
         // Start from surface and burrow down
         float currentX = startX;
@@ -796,13 +565,13 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
         float currentZ = startZ;
         
         // Random direction for this worm
-        float dirX = (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 0.8f;
-        float dirY = -0.3f - (static_cast<float>(caveRng()) / RAND_MAX) * 0.4f; // Generally downward
-        float dirZ = (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 0.8f;
+        float dirX = (wormRng.NextFloat() - 0.5f) * 0.8f;
+        float dirY = -0.3f - (wormRng.NextFloat()) * 0.4f; // Generally downward
+        float dirZ = (wormRng.NextFloat() - 0.5f) * 0.8f;
         
         // Worm length
-        int wormLength = 40 + (caveRng() % 80); // 40-120 blocks long
-        float radius = 1.2f + (static_cast<float>(caveRng()) / RAND_MAX) * 1.0f; // Variable radius
+        int wormLength = 40 + wormRng.NextInt(80); // 40-120 blocks long
+        float radius = 1.2f + (wormRng.NextFloat()) * 1.0f; // Variable radius
         
         for (int step = 0; step < wormLength; step++) {
             // Carve out blocks in a sphere around current position
@@ -823,9 +592,9 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
                         float distanceSquared = dx*dx + dy*dy + dz*dz;
                         
                         if (distanceSquared <= radius * radius) {
-                            BlockType currentType = m_blocks[x][y][z].GetType();
+                            BlockType currentType = GetTypeAt(x, y, z);
                             if (currentType == BlockType::STONE || currentType == BlockType::DIRT || currentType == BlockType::GRASS) {
-                                m_blocks[x][y][z].SetType(BlockType::AIR);
+                                SetTypeAt(x, y, z, BlockType::AIR);
                                 caveBlocksCarved++;
                             }
                         }
@@ -839,9 +608,9 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
             currentZ += dirZ;
             
             // Add some randomness to direction (winding tunnels)
-            dirX += (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 0.2f;
-            dirY += (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 0.1f;
-            dirZ += (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 0.2f;
+            dirX += (wormRng.NextFloat() - 0.5f) * 0.2f;
+            dirY += (wormRng.NextFloat() - 0.5f) * 0.1f;
+            dirZ += (wormRng.NextFloat() - 0.5f) * 0.2f;
             
             // Normalize direction to prevent it from getting too extreme
             float dirLength = std::sqrt(dirX*dirX + dirY*dirY + dirZ*dirZ);
@@ -852,9 +621,9 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
             }
             
             // Occasionally change direction more dramatically (branching)
-            if (caveRng() % 15 == 0) {
-                dirX += (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 1.0f;
-                dirZ += (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 1.0f;
+            if (wormRng.NextInt(15) == 0) {
+                dirX += (wormRng.NextFloat() - 0.5f) * 1.0f;
+                dirZ += (wormRng.NextFloat() - 0.5f) * 1.0f;
             }
             
             // Stop if worm goes out of chunk bounds or too deep
@@ -865,15 +634,15 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
             }
             
             // Vary radius slightly as we go
-            radius += (static_cast<float>(caveRng()) / RAND_MAX - 0.5f) * 0.1f;
+            radius += (wormRng.NextFloat() - 0.5f) * 0.1f;
             radius = std::max(0.8f, std::min(2.5f, radius));
         }
     }
     
-    // Debug output to verify caves are being generated
+    // Debug output to verify caves are being generated (verbose builds only; every chunk reports)
     if (caveBlocksCarved > 0) {
-        std::cout << "Chunk (" << m_chunkX << "," << m_chunkZ << ") carved " << 
-                     caveBlocksCarved << " cave blocks with " << numWorms << " worms" << std::endl;
+        DEBUG_VERBOSE("Chunk (" << m_chunkX << "," << m_chunkZ << ") carved " << caveBlocksCarved
+                      << " cave blocks with " << numWorms << " worms");
     }
     
     // Generate water bodies (fill areas below sea level with water)
@@ -881,8 +650,8 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
         for (int z = 0; z < CHUNK_DEPTH; ++z) {
             for (int y = 0; y < SEA_LEVEL; ++y) {
                 // If there's air below sea level, fill with water
-                if (m_blocks[x][y][z].GetType() == BlockType::AIR) {
-                    m_blocks[x][y][z].SetType(BlockType::WATER_STILL);
+                if (GetTypeAt(x, y, z) == BlockType::AIR) {
+                    SetTypeAt(x, y, z, BlockType::WATER_STILL);
                 }
             }
         }
@@ -898,8 +667,7 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
             int worldX = m_chunkX * CHUNK_WIDTH + x;
             int worldZ = m_chunkZ * CHUNK_DEPTH + z;
             
-            // Get biome for this position
-            BiomeType biomeType = BiomeSystem::GetBiomeType(worldX, worldZ, seed);
+            BiomeType biomeType = m_biomeMap.GetBiome(x, z);
             
             // Generate trees in forest, taiga, jungle, and swamp biomes
             bool shouldGenerateTree = false;
@@ -930,8 +698,8 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
             
             if (shouldGenerateTree) {
                 // Random chance for tree generation
-                std::mt19937 treeRng(seed + worldX * 1000 + worldZ);
-                if (static_cast<int>(treeRng() % 10) < treeChance) {
+                GenerationRandom treeRng(seed, GenerationRandom::FEATURE_TREES, worldX, worldZ);
+                if (treeRng.NextInt(10) < treeChance) {
                     GenerateTree(x, z, treeRng, blockManager);
                 }
             }
@@ -945,32 +713,25 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
             int worldX = m_chunkX * CHUNK_WIDTH + x;
             int worldZ = m_chunkZ * CHUNK_DEPTH + z;
             
-            // Get biome for this position
-            BiomeType biomeType = BiomeSystem::GetBiomeType(worldX, worldZ, seed);
+            BiomeType biomeType = m_biomeMap.GetBiome(x, z);
             
             // Only generate vegetation in forest biomes
             if (biomeType == BiomeType::FOREST) {
                 // Find the surface height at this position
-                int surfaceY = -1;
-                for (int y = CHUNK_HEIGHT - 1; y >= 0; y--) {
-                    if (IsValidPosition(x, y, z) && m_blocks[x][y][z].GetType() == BlockType::GRASS) {
-                        surfaceY = y;
-                        break;
-                    }
-                }
+                int surfaceY = FindSurfaceBlock(x, z, BlockType::GRASS);
                 
                 if (surfaceY != -1 && surfaceY + 1 < CHUNK_HEIGHT) {
-                    std::mt19937 vegRng(seed + worldX * 7919 + worldZ * 4441); // Different seed offset for vegetation
+                    GenerationRandom vegRng(seed, GenerationRandom::FEATURE_VEGETATION, worldX, worldZ);
                     
                     // Check if there's air above the grass surface
-                    if (m_blocks[x][surfaceY + 1][z].GetType() == BlockType::AIR) {
-                        int vegChance = vegRng() % 100;
+                    if (GetTypeAt(x, surfaceY + 1, z) == BlockType::AIR) {
+                        int vegChance = vegRng.NextInt(100);
                         
                         if (vegChance < 25) { // 25% chance for tall grass
                             if (blockManager) {
                                 BlockType tallGrassType = blockManager->GetBlockTypeByKey("tall_grass");
                                 if (tallGrassType != BlockType::AIR) {
-                                    m_blocks[x][surfaceY + 1][z].SetType(tallGrassType);
+                                    SetTypeAt(x, surfaceY + 1, z, tallGrassType);
                                 }
                             }
                         } else if (vegChance < 30) { // 5% chance for flowers (rare)
@@ -982,10 +743,10 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
                                 };
                                 
                                 if (!flowerTypes.empty()) {
-                                    std::string chosenFlower = flowerTypes[vegRng() % flowerTypes.size()];
+                                    std::string chosenFlower = flowerTypes[vegRng.NextInt(static_cast<int>(flowerTypes.size()))];
                                     BlockType flowerType = blockManager->GetBlockTypeByKey(chosenFlower);
                                     if (flowerType != BlockType::AIR) {
-                                        m_blocks[x][surfaceY + 1][z].SetType(flowerType);
+                                        SetTypeAt(x, surfaceY + 1, z, flowerType);
                                     }
                                 }
                             }
@@ -996,370 +757,71 @@ void Chunk::Generate(int seed, const BlockManager* blockManager) {
         }
     }
     
-    // Mark mesh as needing regeneration
-    m_meshGenerated = false;
-}
-
-void Chunk::ApplyServerData(const uint16_t* blockData) {
-    // Clear existing blocks
-    Clear();
-    
-    // Deserialize block data from server
-    for (int x = 0; x < CHUNK_WIDTH; ++x) {
-        for (int y = 0; y < CHUNK_HEIGHT; ++y) {
-            for (int z = 0; z < CHUNK_DEPTH; ++z) {
-                int index = x + (y * 16) + (z * 16 * 256);
-                BlockType blockType = static_cast<BlockType>(blockData[index]);
-                m_blocks[x][y][z].SetType(blockType);
-            }
-        }
-    }
+    // Generation overwrites blocks in several passes; release palette entries it left behind
+    CompactStorage();
     
     // Mark mesh as needing regeneration
     m_meshGenerated = false;
-    
-    std::cout << "Applied server data to chunk (" << m_chunkX << ", " << m_chunkZ << ")" << std::endl;
-}
-
-// Perlin noise implementation
-double Chunk::Perlin(double x, double z, int seed) const {
-    // Simple 2D Perlin noise implementation
-    std::hash<int> hasher;
-    
-    // Get integer and fractional parts
-    int xi = static_cast<int>(std::floor(x)) & 255;
-    int zi = static_cast<int>(std::floor(z)) & 255;
-    double xf = x - std::floor(x);
-    double zf = z - std::floor(z);
-    
-    // Fade curves
-    double u = Fade(xf);
-    double v = Fade(zf);
-    
-    // Hash coordinates with seed
-    int aa = hasher(xi + hasher(zi + seed));
-    int ab = hasher(xi + hasher(zi + 1 + seed));
-    int ba = hasher(xi + 1 + hasher(zi + seed));
-    int bb = hasher(xi + 1 + hasher(zi + 1 + seed));
-    
-    // Interpolate
-    double x1 = Lerp(u, Grad(aa, xf, zf), Grad(ba, xf - 1, zf));
-    double x2 = Lerp(u, Grad(ab, xf, zf - 1), Grad(bb, xf - 1, zf - 1));
-    
-    return Lerp(v, x1, x2);
-}
-
-double Chunk::Fade(double t) const {
-    // Smooth fade function: 6t^5 - 15t^4 + 10t^3
-    return t * t * t * (t * (t * 6 - 15) + 10);
-}
-
-double Chunk::Lerp(double t, double a, double b) const {
-    return a + t * (b - a);
 }
 
-double Chunk::Grad(int hash, double x, double z) const {
-    // Simple gradient function for 2D noise
-    int h = hash & 3;
-    double u = h < 2 ? x : z;
-    double v = h < 2 ? z : x;
-    return ((h & 1) ? -u : u) + ((h & 2) ? -2.0 * v : 2.0 * v);
-}
-
-// 3D Perlin noise implementation for cave generation
-double Chunk::Perlin3D(double x, double y, double z, int seed) const {
-    std::hash<int> hasher;
-    
-    // Get integer and fractional parts
-    int xi = static_cast<int>(std::floor(x)) & 255;
-    int yi = static_cast<int>(std::floor(y)) & 255;
-    int zi = static_cast<int>(std::floor(z)) & 255;
-    double xf = x - std::floor(x);
-    double yf = y - std::floor(y);
-    double zf = z - std::floor(z);
-    
-    // Fade curves
-    double u = Fade(xf);
-    double v = Fade(yf);
-    double w = Fade(zf);
-    
-    // Hash coordinates with seed
-    int aaa = hasher(xi + hasher(yi + hasher(zi + seed)));
-    int aba = hasher(xi + hasher(yi + 1 + hasher(zi + seed)));
-    int aab = hasher(xi + hasher(yi + hasher(zi + 1 + seed)));
-    int abb = hasher(xi + hasher(yi + 1 + hasher(zi + 1 + seed)));
-    int baa = hasher(xi + 1 + hasher(yi + hasher(zi + seed)));
-    int bba = hasher(xi + 1 + hasher(yi + 1 + hasher(zi + seed)));
-    int bab = hasher(xi + 1 + hasher(yi + hasher(zi + 1 + seed)));
-    int bbb = hasher(xi + 1 + hasher(yi + 1 + hasher(zi + 1 + seed)));
-    
-    // 3D gradient function
-    auto grad3d = [](int hash, double x, double y, double z) -> double {
-        int h = hash & 15;
-        double u = h < 8 ? x : y;
-        double v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
-        return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
-    };
-    
-    // Interpolate
-    double x1 = Lerp(u, grad3d(aaa, xf, yf, zf), grad3d(baa, xf - 1, yf, zf));
-    double x2 = Lerp(u, grad3d(aba, xf, yf - 1, zf), grad3d(bba, xf - 1, yf - 1, zf));
-    double y1 = Lerp(v, x1, x2);
-    
-    x1 = Lerp(u, grad3d(aab, xf, yf, zf - 1), grad3d(bab, xf - 1, yf, zf - 1));
-    x2 = Lerp(u, grad3d(abb, xf, yf - 1, zf - 1), grad3d(bbb, xf - 1, yf - 1, zf - 1));
-    double y2 = Lerp(v, x1, x2);
-    
-    return Lerp(w, y1, y2);
-} 
-
-// Helper method to get a block at an arbitrary offset from the current position
-// Handles cross-chunk boundaries properly
-Block Chunk::GetBlockAtOffset(int x, int y, int z, int dx, int dy, int dz, const World* world) const {
-    int targetX = x + dx;
-    int targetY = y + dy;
-    int targetZ = z + dz;
-    
-    // If target is within this chunk, get it directly
-    if (IsValidPosition(targetX, targetY, targetZ)) {
-        return m_blocks[targetX][targetY][targetZ];
+void Chunk::ApplyServerData(const uint16_t* blockData, const ChunkBiomeMap& biomeMap, const BlockManager* blockManager) {
+    if (blockManager) {
+        m_blockManager = blockManager; // Heightmaps are rebuilt below anyway
     }
-    
-    // Target is outside this chunk - convert to world coordinates and query world
-    if (world) {
-        int worldX = m_chunkX * CHUNK_WIDTH + targetX;
-        int worldY = targetY;
-        int worldZ = m_chunkZ * CHUNK_DEPTH + targetZ;
+    m_biomeMap = biomeMap;
+    
+    // Deserialize block data from server one section at a time.
+    // Sections that arrive as a single block type (usually all air above the terrain)
+    // are filled directly instead of being written cell by cell.
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        ChunkSection& section = m_sections[sectionY];
+        int baseY = sectionY * SECTION_SIZE;
         
-        return world->GetBlock(worldX, worldY, worldZ);
-    }
-    
-    // No world access - assume air
-    return Block(BlockType::AIR);
-}
-
-// Calculate ambient occlusion for a specific vertex of a face
-// Simplified version - just samples blocks that would block ambient light to this vertex
-float Chunk::CalculateVertexAO(int x, int y, int z, int faceDirection, int vertexIndex, const World* world, const BlockManager* blockManager) const {
-    // Key insight: we need to sample blocks that are adjacent to where the vertex will be positioned
-    // For a TOP face, vertices are on the top surface, so we sample blocks ABOVE that position
-    // For a FRONT face, vertices are on the front surface, so we sample blocks IN FRONT of that position
-    
-    int side1_dx = 0, side1_dy = 0, side1_dz = 0;
-    int side2_dx = 0, side2_dy = 0, side2_dz = 0;
-    int corner_dx = 0, corner_dy = 0, corner_dz = 0;
-    
-    // The sampling pattern depends on the face and vertex position
-    switch (faceDirection) {
-        case FACE_TOP: { // Top face - sample blocks above
-            // All samples are 1 block above the current block
-            switch (vertexIndex) {
-                case 0: // (-0.5, +0.5, -0.5) vertex
-                    side1_dx = -1; side1_dy = 1; side1_dz = 0;   // Left-above
-                    side2_dx = 0; side2_dy = 1; side2_dz = -1;   // Front-above
-                    corner_dx = -1; corner_dy = 1; corner_dz = -1; // Corner-above
-                    break;
-                case 1: // (+0.5, +0.5, -0.5) vertex
-                    side1_dx = 1; side1_dy = 1; side1_dz = 0;    // Right-above
-                    side2_dx = 0; side2_dy = 1; side2_dz = -1;   // Front-above
-                    corner_dx = 1; corner_dy = 1; corner_dz = -1; // Corner-above
-                    break;
-                case 2: // (+0.5, +0.5, +0.5) vertex
-                    side1_dx = 1; side1_dy = 1; side1_dz = 0;    // Right-above
-                    side2_dx = 0; side2_dy = 1; side2_dz = 1;    // Back-above
-                    corner_dx = 1; corner_dy = 1; corner_dz = 1;  // Corner-above
-                    break;
-                case 3: // (-0.5, +0.5, +0.5) vertex
-                    side1_dx = -1; side1_dy = 1; side1_dz = 0;   // Left-above
-                    side2_dx = 0; side2_dy = 1; side2_dz = 1;    // Back-above
-                    corner_dx = -1; corner_dy = 1; corner_dz = 1; // Corner-above
-                    break;
-            }
-            break;
-        }
-        case FACE_BOTTOM: { // Bottom face - sample blocks below
-            switch (vertexIndex) {
-                case 0: 
-                    side1_dx = -1; side1_dy = -1; side1_dz = 0;
-                    side2_dx = 0; side2_dy = -1; side2_dz = -1;
-                    corner_dx = -1; corner_dy = -1; corner_dz = -1;
-                    break;
-                case 1:
-                    side1_dx = 1; side1_dy = -1; side1_dz = 0;
-                    side2_dx = 0; side2_dy = -1; side2_dz = -1;
-                    corner_dx = 1; corner_dy = -1; corner_dz = -1;
-                    break;
-                case 2:
-                    side1_dx = 1; side1_dy = -1; side1_dz = 0;
-                    side2_dx = 0; side2_dy = -1; side2_dz = 1;
-                    corner_dx = 1; corner_dy = -1; corner_dz = 1;
-                    break;
-                case 3:
-                    side1_dx = -1; side1_dy = -1; side1_dz = 0;
-                    side2_dx = 0; side2_dy = -1; side2_dz = 1;
-                    corner_dx = -1; corner_dy = -1; corner_dz = 1;
-                    break;
-            }
-            break;
-        }
-        case FACE_FRONT: { // Front face - sample blocks in front (+Z)
-            switch (vertexIndex) {
-                case 0:
-                    side1_dx = -1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = 0; side2_dy = -1; side2_dz = 1;
-                    corner_dx = -1; corner_dy = -1; corner_dz = 1;
-                    break;
-                case 1:
-                    side1_dx = 1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = 0; side2_dy = -1; side2_dz = 1;
-                    corner_dx = 1; corner_dy = -1; corner_dz = 1;
-                    break;
-                case 2:
-                    side1_dx = 1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = 0; side2_dy = 1; side2_dz = 1;
-                    corner_dx = 1; corner_dy = 1; corner_dz = 1;
-                    break;
-                case 3:
-                    side1_dx = -1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = 0; side2_dy = 1; side2_dz = 1;
-                    corner_dx = -1; corner_dy = 1; corner_dz = 1;
-                    break;
-            }
-            break;
-        }
-        case FACE_BACK: { // Back face - sample blocks behind (-Z)
-            switch (vertexIndex) {
-                case 0:
-                    side1_dx = -1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = 0; side2_dy = -1; side2_dz = -1;
-                    corner_dx = -1; corner_dy = -1; corner_dz = -1;
-                    break;
-                case 1:
-                    side1_dx = 1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = 0; side2_dy = -1; side2_dz = -1;
-                    corner_dx = 1; corner_dy = -1; corner_dz = -1;
-                    break;
-                case 2:
-                    side1_dx = 1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = 0; side2_dy = 1; side2_dz = -1;
-                    corner_dx = 1; corner_dy = 1; corner_dz = -1;
-                    break;
-                case 3:
-                    side1_dx = -1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = 0; side2_dy = 1; side2_dz = -1;
-                    corner_dx = -1; corner_dy = 1; corner_dz = -1;
-                    break;
+        uint16_t firstValue = blockData[baseY * 16];
+        bool uniform = true;
+        for (int z = 0; z < CHUNK_DEPTH && uniform; ++z) {
+            for (int localY = 0; localY < SECTION_SIZE && uniform; ++localY) {
+                const uint16_t* row = blockData + (baseY + localY) * 16 + z * 16 * 256;
+                for (int x = 0; x < CHUNK_WIDTH; ++x) {
+                    if (row[x] != firstValue) {
+                        uniform = false;
+                        break;
+                    }
+                }
             }
-            break;
         }
-        case FACE_LEFT: { // Left face - sample blocks to the left (-X)
-            switch (vertexIndex) {
-                case 0:
-                    side1_dx = -1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = -1; side2_dy = -1; side2_dz = 0;
-                    corner_dx = -1; corner_dy = -1; corner_dz = -1;
-                    break;
-                case 1:
-                    side1_dx = -1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = -1; side2_dy = -1; side2_dz = 0;
-                    corner_dx = -1; corner_dy = -1; corner_dz = 1;
-                    break;
-                case 2:
-                    side1_dx = -1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = -1; side2_dy = 1; side2_dz = 0;
-                    corner_dx = -1; corner_dy = 1; corner_dz = 1;
-                    break;
-                case 3:
-                    side1_dx = -1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = -1; side2_dy = 1; side2_dz = 0;
-                    corner_dx = -1; corner_dy = 1; corner_dz = -1;
-                    break;
-            }
-            break;
+        
+        section.Fill(static_cast<BlockType>(firstValue));
+        if (uniform) {
+            continue;
         }
-        case FACE_RIGHT: { // Right face - sample blocks to the right (+X)
-            switch (vertexIndex) {
-                case 0:
-                    side1_dx = 1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = 1; side2_dy = -1; side2_dz = 0;
-                    corner_dx = 1; corner_dy = -1; corner_dz = -1;
-                    break;
-                case 1:
-                    side1_dx = 1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = 1; side2_dy = -1; side2_dz = 0;
-                    corner_dx = 1; corner_dy = -1; corner_dz = 1;
-                    break;
-                case 2:
-                    side1_dx = 1; side1_dy = 0; side1_dz = 1;
-                    side2_dx = 1; side2_dy = 1; side2_dz = 0;
-                    corner_dx = 1; corner_dy = 1; corner_dz = 1;
-                    break;
-                case 3:
-                    side1_dx = 1; side1_dy = 0; side1_dz = -1;
-                    side2_dx = 1; side2_dy = 1; side2_dz = 0;
-                    corner_dx = 1; corner_dy = 1; corner_dz = -1;
-                    break;
+        
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            for (int localY = 0; localY < SECTION_SIZE; ++localY) {
+                const uint16_t* row = blockData + (baseY + localY) * 16 + z * 16 * 256;
+                for (int x = 0; x < CHUNK_WIDTH; ++x) {
+                    section.Set(x, localY, z, static_cast<BlockType>(row[x]));
+                }
             }
-            break;
         }
     }
+    CompactStorage();
+    RebuildHeightmaps();
     
-    // Sample the 3 neighbor blocks
-    Block side1 = GetBlockAtOffset(x, y, z, side1_dx, side1_dy, side1_dz, world);
-    Block side2 = GetBlockAtOffset(x, y, z, side2_dx, side2_dy, side2_dz, world);
-    Block corner = GetBlockAtOffset(x, y, z, corner_dx, corner_dy, corner_dz, world);
-    
-    // Convert to boolean (solid = true, air = false)
-    // Ground blocks (flowers, saplings, etc.) should not contribute to ambient occlusion
-    bool s1 = !side1.IsAir() && (blockManager ? !blockManager->IsGround(side1.GetType()) : true);
-    bool s2 = !side2.IsAir() && (blockManager ? !blockManager->IsGround(side2.GetType()) : true);
-    bool c = !corner.IsAir() && (blockManager ? !blockManager->IsGround(corner.GetType()) : true);
-    
-    // Apply Minecraft's ambient occlusion formula
-    if (s1 && s2) {
-        return 0.25f;  // Fully occluded - but not completely black
-    }
-    
-    // Count number of occluding blocks and get base AO value
-    int occluded = (s1 ? 1 : 0) + (s2 ? 1 : 0) + (c ? 1 : 0);
-    float baseAO;
-    switch (occluded) {
-        case 0: baseAO = 1.0f; break;   // No occlusion - full brightness
-        case 1: baseAO = 0.8f; break;   // Light occlusion
-        case 2: baseAO = 0.6f; break;   // Medium occlusion  
-        case 3: baseAO = 0.4f; break;   // Heavy occlusion
-        default: baseAO = 1.0f; break;
-    }
-    
-    // Apply Minecraft-style directional face multipliers
-    float faceMultiplier;
-    switch (faceDirection) {
-        case FACE_TOP:    faceMultiplier = 1.0f; break;  // 100% - brightest (sky exposure)
-        case FACE_FRONT:  // North face
-        case FACE_BACK:   faceMultiplier = 0.8f; break;  // 80% - N/S faces  
-        case FACE_LEFT:   // West face
-        case FACE_RIGHT:  faceMultiplier = 0.6f; break;  // 60% - E/W faces
-        case FACE_BOTTOM: faceMultiplier = 0.5f; break;  // 50% - darkest (no sky)
-        default: faceMultiplier = 1.0f; break;
-    }
+    // Mark mesh as needing regeneration
+    m_meshGenerated = false;
     
-    return baseAO * faceMultiplier;
+    std::cout << "Applied server data to chunk (" << m_chunkX << ", " << m_chunkZ << ")" << std::endl;
 }
 
-void Chunk::GenerateTree(int x, int z, std::mt19937& rng, const BlockManager* blockManager) {
+void Chunk::GenerateTree(int x, int z, GenerationRandom& rng, const BlockManager* blockManager) {
     // Find the surface height at this position
-    int surfaceY = -1;
-    for (int y = CHUNK_HEIGHT - 1; y >= 0; y--) {
-        if (IsValidPosition(x, y, z) && m_blocks[x][y][z].GetType() == BlockType::GRASS) {
-            surfaceY = y;
-            break;
-        }
-    }
+    int surfaceY = FindSurfaceBlock(x, z, BlockType::GRASS);
     
     if (surfaceY == -1) return;  // No grass surface found
     
     // Choose tree type (50% oak, 50% birch)
-    bool isOak = (rng() % 2 == 0);
+    bool isOak = (rng.NextInt(2) == 0);
     
     if (isOak) {
         GenerateOakTree(x, z, surfaceY, rng, blockManager);
@@ -1368,16 +830,16 @@ void Chunk::GenerateTree(int x, int z, std::mt19937& rng, const BlockManager* bl
     }
 }
 
-void Chunk::GenerateOakTree(int x, int z, int surfaceY, std::mt19937& rng, const BlockManager* blockManager) {
+void Chunk::GenerateOakTree(int x, int z, int surfaceY, GenerationRandom& rng, const BlockManager* blockManager) {
     // Oak tree: 4-6 blocks tall trunk with dense, rounded canopy
-    int trunkHeight = 4 + (rng() % 3);  // 4-6 blocks tall
+    int trunkHeight = 4 + rng.NextInt(3);  // 4-6 blocks tall
     
     // Generate trunk
     for (int y = 1; y <= trunkHeight; y++) {
         int trunkY = surfaceY + y;
         if (trunkY < CHUNK_HEIGHT && IsValidPosition(x, trunkY, z)) {
             BlockType oakLogType = blockManager ? blockManager->GetBlockTypeByKey("oak_log") : BlockType::AIR;
-            m_blocks[x][trunkY][z].SetType(oakLogType);
+            SetTypeAt(x, trunkY, z, oakLogType);
         }
     }
     
@@ -1394,12 +856,12 @@ void Chunk::GenerateOakTree(int x, int z, int surfaceY, std::mt19937& rng, const
             if (IsValidPosition(leafX, leafY, leafZ) && leafY < CHUNK_HEIGHT) {
                 // Skip corners for more natural look
                 if (abs(dx) == 2 && abs(dz) == 2) {
-                    if (rng() % 3 == 0) continue;  // 66% chance to skip corners
+                    if (rng.NextInt(3) == 0) continue;  // 66% chance to skip corners
                 }
                 
-                if (m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                if (GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                     BlockType oakLeavesType = blockManager ? blockManager->GetBlockTypeByKey("oak_leaves") : BlockType::AIR;
-                    m_blocks[leafX][leafY][leafZ].SetType(oakLeavesType);
+                    SetTypeAt(leafX, leafY, leafZ, oakLeavesType);
                 }
             }
         }
@@ -1415,12 +877,12 @@ void Chunk::GenerateOakTree(int x, int z, int surfaceY, std::mt19937& rng, const
             if (IsValidPosition(leafX, leafY, leafZ) && leafY < CHUNK_HEIGHT) {
                 // More selective on edges
                 if (abs(dx) == 2 || abs(dz) == 2) {
-                    if (rng() % 2 == 0) continue;  // 50% chance for edges
+                    if (rng.NextInt(2) == 0) continue;  // 50% chance for edges
                 }
                 
-                if (m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                if (GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                     BlockType oakLeavesType = blockManager ? blockManager->GetBlockTypeByKey("oak_leaves") : BlockType::AIR;
-                    m_blocks[leafX][leafY][leafZ].SetType(oakLeavesType);
+                    SetTypeAt(leafX, leafY, leafZ, oakLeavesType);
                 }
             }
         }
@@ -1437,15 +899,15 @@ void Chunk::GenerateOakTree(int x, int z, int surfaceY, std::mt19937& rng, const
                 // Center and adjacent blocks
                 if (dx == 0 && dz == 0) {
                     // Always place center
-                                    if (m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                                    if (GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                     BlockType oakLeavesType = blockManager ? blockManager->GetBlockTypeByKey("oak_leaves") : BlockType::AIR;
-                    m_blocks[leafX][leafY][leafZ].SetType(oakLeavesType);
+                    SetTypeAt(leafX, leafY, leafZ, oakLeavesType);
                 }
                 } else if (abs(dx) + abs(dz) == 1) {
                     // 75% chance for adjacent blocks
-                                    if (rng() % 4 != 0 && m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                                    if (rng.NextInt(4) != 0 && GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                     BlockType oakLeavesType = blockManager ? blockManager->GetBlockTypeByKey("oak_leaves") : BlockType::AIR;
-                    m_blocks[leafX][leafY][leafZ].SetType(oakLeavesType);
+                    SetTypeAt(leafX, leafY, leafZ, oakLeavesType);
                 }
                 }
             }
@@ -1453,16 +915,16 @@ void Chunk::GenerateOakTree(int x, int z, int surfaceY, std::mt19937& rng, const
     }
 }
 
-void Chunk::GenerateBirchTree(int x, int z, int surfaceY, std::mt19937& rng, const BlockManager* blockManager) {
+void Chunk::GenerateBirchTree(int x, int z, int surfaceY, GenerationRandom& rng, const BlockManager* blockManager) {
     // Birch tree: now using oak tree structure (dense, rounded canopy)
-    int trunkHeight = 4 + (rng() % 3);  // 4-6 blocks tall (same as oak)
+    int trunkHeight = 4 + rng.NextInt(3);  // 4-6 blocks tall (same as oak)
     
     // Generate trunk (using birch log but oak structure)
     for (int y = 1; y <= trunkHeight; y++) {
         int trunkY = surfaceY + y;
         if (trunkY < CHUNK_HEIGHT && IsValidPosition(x, trunkY, z)) {
             BlockType birchLogType = blockManager ? blockManager->GetBlockTypeByKey("birch_log") : BlockType::AIR;
-            m_blocks[x][trunkY][z].SetType(birchLogType);
+            SetTypeAt(x, trunkY, z, birchLogType);
         }
     }
     
@@ -1479,12 +941,12 @@ void Chunk::GenerateBirchTree(int x, int z, int surfaceY, std::mt19937& rng, con
             if (IsValidPosition(leafX, leafY, leafZ) && leafY < CHUNK_HEIGHT) {
                 // Skip corners for more natural look
                 if (abs(dx) == 2 && abs(dz) == 2) {
-                    if (rng() % 3 == 0) continue;  // 66% chance to skip corners
+                    if (rng.NextInt(3) == 0) continue;  // 66% chance to skip corners
                 }
                 
-                if (m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                if (GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                     BlockType birchLeavesType = blockManager ? blockManager->GetBlockTypeByKey("birch_leaves") : BlockType::AIR;
-                    m_blocks[leafX][leafY][leafZ].SetType(birchLeavesType);
+                    SetTypeAt(leafX, leafY, leafZ, birchLeavesType);
                 }
             }
         }
@@ -1500,12 +962,12 @@ void Chunk::GenerateBirchTree(int x, int z, int surfaceY, std::mt19937& rng, con
             if (IsValidPosition(leafX, leafY, leafZ) && leafY < CHUNK_HEIGHT) {
                 // More selective on edges
                 if (abs(dx) == 2 || abs(dz) == 2) {
-                    if (rng() % 2 == 0) continue;  // 50% chance for edges
+                    if (rng.NextInt(2) == 0) continue;  // 50% chance for edges
                 }
                 
-                if (m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                if (GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                     BlockType birchLeavesType = blockManager ? blockManager->GetBlockTypeByKey("birch_leaves") : BlockType::AIR;
-                    m_blocks[leafX][leafY][leafZ].SetType(birchLeavesType);
+                    SetTypeAt(leafX, leafY, leafZ, birchLeavesType);
                 }
             }
         }
@@ -1522,15 +984,15 @@ void Chunk::GenerateBirchTree(int x, int z, int surfaceY, std::mt19937& rng, con
                 // Center and adjacent blocks
                 if (dx == 0 && dz == 0) {
                     // Always place center
-                    if (m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                    if (GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                         BlockType birchLeavesType = blockManager ? blockManager->GetBlockTypeByKey("birch_leaves") : BlockType::AIR;
-                        m_blocks[leafX][leafY][leafZ].SetType(birchLeavesType);
+                        SetTypeAt(leafX, leafY, leafZ, birchLeavesType);
                     }
                 } else if (abs(dx) + abs(dz) == 1) {
                     // 75% chance for adjacent blocks
-                    if (rng() % 4 != 0 && m_blocks[leafX][leafY][leafZ].GetType() == BlockType::AIR) {
+                    if (rng.NextInt(4) != 0 && GetTypeAt(leafX, leafY, leafZ) == BlockType::AIR) {
                         BlockType birchLeavesType = blockManager ? blockManager->GetBlockTypeByKey("birch_leaves") : BlockType::AIR;
-                        m_blocks[leafX][leafY][leafZ].SetType(birchLeavesType);
+                        SetTypeAt(leafX, leafY, leafZ, birchLeavesType);
                     }
                 }
             }
@@ -1539,144 +1001,178 @@ void Chunk::GenerateBirchTree(int x, int z, int surfaceY, std::mt19937& rng, con
 }
 
 void Chunk::GenerateOreVeins(int seed) {
-    // Set up random number generator for ore generation
-    std::mt19937 oreRng(seed + m_chunkX * 2357 + m_chunkZ * 3331); // Different seed offset for ores
+    // Random numbers for ore generation; each ore type and each vein reads its own substream
+    GenerationRandom oresRng(seed, GenerationRandom::FEATURE_ORES, m_chunkX, m_chunkZ);
     
     // Define ore properties: {oreType, minY, maxY, rarity (higher = rarer), veinSize, noiseScale}
     struct OreConfig {
         BlockType oreType;
         int minY;
         int maxY;
-        int rarity;      // 1 in rarity chance per block
-        int veinSize;    // Maximum connected ore blocks
-        double noiseScale;
+        int rarity;      // Scales down the height factor's effect on the threshold
+        int veinSize;    // Ore blocks per vein
+        float noiseScale;
     };
     
-    std::vector<OreConfig> oreConfigs = {
+    static const std::vector<OreConfig> oreConfigs = {
         // Coal ore - common, higher levels
-        {BlockType::COAL_ORE, 5, 128, 8, 6, 0.15},
+        {BlockType::COAL_ORE, 5, 128, 8, 6, 0.15f},
         
         // Iron ore - common, mid levels  
-        {BlockType::IRON_ORE, 0, 64, 10, 8, 0.12},
+        {BlockType::IRON_ORE, 0, 64, 10, 8, 0.12f},
         
         // Copper ore - common, mid levels
-        {BlockType::COPPER_ORE, 0, 96, 12, 7, 0.13},
+        {BlockType::COPPER_ORE, 0, 96, 12, 7, 0.13f},
         
         // Gold ore - rare, lower levels
-        {BlockType::GOLD_ORE, 0, 32, 35, 4, 0.08},
+        {BlockType::GOLD_ORE, 0, 32, 35, 4, 0.08f},
         
         // Diamond ore - very rare, deep levels
-        {BlockType::DIAMOND_ORE, 0, 16, 80, 3, 0.06},
+        {BlockType::DIAMOND_ORE, 0, 16, 80, 3, 0.06f},
         
         // Emerald ore - very rare, higher levels (mountains)
-        {BlockType::EMERALD_ORE, 32, 96, 120, 2, 0.05}
+        {BlockType::EMERALD_ORE, 32, 96, 120, 2, 0.05f}
     };
     
-    // Generate ores for each configuration
-    for (const auto& config : oreConfigs) {
-        for (int x = 0; x < CHUNK_WIDTH; ++x) {
-            for (int z = 0; z < CHUNK_DEPTH; ++z) {
-                for (int y = config.minY; y <= config.maxY && y < CHUNK_HEIGHT; ++y) {
-                    // Only replace stone blocks with ore
-                    if (m_blocks[x][y][z].GetType() != BlockType::STONE) {
-                        continue;
-                    }
-                    
-                    // Convert local coordinates to world coordinates for noise
-                    int worldX = m_chunkX * CHUNK_WIDTH + x;
-                    int worldZ = m_chunkZ * CHUNK_DEPTH + z;
-                    
-                    // Use 3D Perlin noise for more natural ore distribution
-                    // Each ore type gets its own noise pattern
-                    double oreNoise = Perlin(worldX * config.noiseScale, worldZ * config.noiseScale, 
-                                           seed + static_cast<int>(config.oreType) * 1000);
-                    
-                    // Add vertical variation
-                    double verticalNoise = sin(y * 0.3) * 0.3; // Gentle vertical waves
-                    double combinedNoise = oreNoise + verticalNoise;
-                    
-                    // Height-based probability modifier
-                    double heightFactor = 1.0;
-                    if (config.oreType == BlockType::COAL_ORE) {
-                        // Coal is more common at higher elevations
-                        heightFactor = 0.5 + 0.5 * (static_cast<double>(y - config.minY) / (config.maxY - config.minY));
-                    } else if (config.oreType == BlockType::DIAMOND_ORE) {
-                        // Diamond is most common at low levels
-                        heightFactor = 1.0 - 0.4 * (static_cast<double>(y - config.minY) / (config.maxY - config.minY));
-                    } else if (config.oreType == BlockType::GOLD_ORE) {
-                        // Gold has a peak around y=8-16
-                        double midPoint = (config.minY + config.maxY) * 0.5;
-                        double distance = abs(y - midPoint) / (config.maxY - config.minY);
-                        heightFactor = 1.0 - 0.5 * distance;
-                    }
-                    
-                    // Combine noise threshold with height factor and rarity
-                    double threshold = 0.6 - (0.3 * heightFactor / config.rarity);
-                    
-                    if (combinedNoise > threshold) {
-                        // Basic ore placement
-                        m_blocks[x][y][z].SetType(config.oreType);
-                        
-                        // Generate small ore veins for larger ore types
-                        if (config.veinSize > 3 && oreRng() % 3 == 0) {
-                            GenerateOreVein(x, y, z, config.oreType, config.veinSize, oreRng);
-                        }
-                    }
+    // A column holds ore at height y when its ore noise exceeds thresholds[y - minY]. The height factor,
+    // rarity and vertical waves only depend on y, so they are folded into one table per ore, built once
+    static const std::vector<std::vector<float>> oreThresholds = [] {
+        std::vector<std::vector<float>> tables;
+        for (const OreConfig& config : oreConfigs) {
+            std::vector<float> thresholds;
+            for (int y = config.minY; y <= config.maxY && y < CHUNK_HEIGHT; ++y) {
+                // Height-based probability modifier
+                double heightFactor = 1.0;
+                if (config.oreType == BlockType::COAL_ORE) {
+                    // Coal is more common at higher elevations
+                    heightFactor = 0.5 + 0.5 * (static_cast<double>(y - config.minY) / (config.maxY - config.minY));
+                } else if (config.oreType == BlockType::DIAMOND_ORE) {
+                    // Diamond is most common at low levels
+                    heightFactor = 1.0 - 0.4 * (static_cast<double>(y - config.minY) / (config.maxY - config.minY));
+                } else if (config.oreType == BlockType::GOLD_ORE) {
+                    // Gold has a peak around y=8-16
+                    double midPoint = (config.minY + config.maxY) * 0.5;
+                    double distance = std::abs(y - midPoint) / (config.maxY - config.minY);
+                    heightFactor = 1.0 - 0.5 * distance;
                 }
+                
+                // Combine noise threshold with height factor and rarity, less the gentle vertical waves
+                double threshold = 0.6 - (0.3 * heightFactor / config.rarity);
+                double verticalNoise = std::sin(y * 0.3) * 0.3;
+                thresholds.push_back(static_cast<float>((threshold - verticalNoise) / ORE_NOISE_AMPLITUDE));
             }
+            tables.push_back(std::move(thresholds));
+        }
+        return tables;
+    }();
+    
+    // Rather than testing every cell, place veins: each ore gets one vein per veinSize cells that pass
+    // its threshold, started at a random passing cell. This keeps the amount of ore, its height profile
+    // and its clustering in high-noise columns, at the cost of a sorted column list per ore
+    constexpr int COLUMNS = CHUNK_WIDTH * CHUNK_DEPTH;
+    float oreNoiseGrid[COLUMNS];
+    std::array<uint8_t, COLUMNS> columnOrder;
+    std::array<float, COLUMNS> sortedNoise;
+    std::vector<int> passingCells; // Running total of passing cells up to each height
+    for (size_t oreIndex = 0; oreIndex < oreConfigs.size(); ++oreIndex) {
+        const OreConfig& config = oreConfigs[oreIndex];
+        const std::vector<float>& thresholds = oreThresholds[oreIndex];
+        
+        // The noise only depends on the column, so each ore type samples its own pattern once per column
+        PerlinNoise(GenerationRandom::DeriveSeed(seed, GenerationRandom::FEATURE_ORE_NOISE, static_cast<int>(config.oreType)))
+            .SampleGrid(m_chunkX * CHUNK_WIDTH, m_chunkZ * CHUNK_DEPTH, config.noiseScale, oreNoiseGrid);
+        
+        // Columns by ascending noise (ties by index), so the columns passing a threshold are a suffix
+        for (int column = 0; column < COLUMNS; ++column) {
+            columnOrder[column] = static_cast<uint8_t>(column);
+        }
+        std::sort(columnOrder.begin(), columnOrder.end(), [&](uint8_t a, uint8_t b) {
+            return oreNoiseGrid[a] < oreNoiseGrid[b] || (oreNoiseGrid[a] == oreNoiseGrid[b] && a < b);
+        });
+        for (int i = 0; i < COLUMNS; ++i) {
+            sortedNoise[i] = oreNoiseGrid[columnOrder[i]];
+        }
+        
+        passingCells.clear();
+        int totalCells = 0;
+        for (float threshold : thresholds) {
+            totalCells += static_cast<int>(sortedNoise.end() - std::upper_bound(sortedNoise.begin(), sortedNoise.end(), threshold));
+            passingCells.push_back(totalCells);
+        }
+        if (totalCells == 0) {
+            continue;
+        }
+        
+        // One vein per veinSize passing cells; the remainder becomes a vein with matching probability
+        GenerationRandom oreRng = oresRng.Substream(static_cast<uint64_t>(config.oreType));
+        int veinCount = totalCells / config.veinSize;
+        if (oreRng.NextInt(config.veinSize) < totalCells % config.veinSize) {
+            ++veinCount;
+        }
+        
+        for (int vein = 0; vein < veinCount; ++vein) {
+            // Pick a passing cell uniformly: first its height, then one of the columns passing there
+            GenerationRandom veinRng = oreRng.Substream(vein);
+            int cell = veinRng.NextInt(totalCells);
+            int heightIndex = static_cast<int>(std::upper_bound(passingCells.begin(), passingCells.end(), cell) - passingCells.begin());
+            int columnsPassing = passingCells[heightIndex] - (heightIndex > 0 ? passingCells[heightIndex - 1] : 0);
+            int column = columnOrder[COLUMNS - 1 - veinRng.NextInt(columnsPassing)];
+            
+            // Veins only grow through stone, so cells in air, water or caves place nothing, as before.
+            // A cell an earlier vein of this ore already filled extends that vein instead
+            GenerateOreVein(column % CHUNK_WIDTH, config.minY + heightIndex, column / CHUNK_WIDTH, config.oreType, config.veinSize, veinRng);
         }
     }
 }
 
-void Chunk::GenerateOreVein(int startX, int startY, int startZ, BlockType oreType, int maxSize, std::mt19937& rng) {
-    // Generate a small connected vein of ore blocks
-    std::vector<std::array<int, 3>> veinBlocks;
-    std::vector<std::array<int, 3>> candidates;
+void Chunk::GenerateOreVein(int startX, int startY, int startZ, BlockType oreType, int maxSize, GenerationRandom& rng) {
+    // Generate a small connected vein of ore blocks, growing from a random frontier cell each step.
+    // Every placed block adds at most 6 candidates, so the frontier fits a fixed array
+    maxSize = std::min(maxSize, MAX_ORE_VEIN_SIZE);
+    std::array<std::array<int, 3>, MAX_ORE_VEIN_SIZE * 6 + 6> candidates;
+    int candidateCount = 0;
+    
+    // Added to the candidates when it is stone, so a vein grows from any position
+    auto addCandidate = [&](int x, int y, int z) {
+        if (IsValidPosition(x, y, z) && GetTypeAt(x, y, z) == BlockType::STONE) {
+            candidates[candidateCount++] = {x, y, z};
+        }
+    };
+    auto addNeighbors = [&](int x, int y, int z) {
+        addCandidate(x + 1, y, z);
+        addCandidate(x - 1, y, z);
+        addCandidate(x, y + 1, z);
+        addCandidate(x, y - 1, z);
+        addCandidate(x, y, z + 1);
+        addCandidate(x, y, z - 1);
+    };
     
-    candidates.push_back({startX, startY, startZ});
+    // Starting inside the same ore continues that vein from its stone neighbours
+    if (IsValidPosition(startX, startY, startZ) && GetTypeAt(startX, startY, startZ) == oreType) {
+        addNeighbors(startX, startY, startZ);
+    } else {
+        addCandidate(startX, startY, startZ);
+    }
     
     int placedBlocks = 0;
-    while (!candidates.empty() && placedBlocks < maxSize) {
-        // Pick a random candidate
-        int idx = rng() % candidates.size();
-        auto pos = candidates[idx];
-        candidates.erase(candidates.begin() + idx);
+    while (candidateCount > 0 && placedBlocks < maxSize) {
+        // Pick a random candidate; the last one takes its slot
+        int idx = rng.NextInt(candidateCount);
+        std::array<int, 3> pos = candidates[idx];
+        candidates[idx] = candidates[--candidateCount];
         
         int x = pos[0], y = pos[1], z = pos[2];
         
-        // Check if position is valid and contains stone
-        if (!IsValidPosition(x, y, z) || m_blocks[x][y][z].GetType() != BlockType::STONE) {
+        // Candidates were stone when queued; a cell queued twice is ore by its second turn
+        if (GetTypeAt(x, y, z) != BlockType::STONE) {
             continue;
         }
         
         // Place ore block
-        m_blocks[x][y][z].SetType(oreType);
+        SetTypeAt(x, y, z, oreType);
         placedBlocks++;
         
-        // Add neighboring stone blocks as candidates (50% chance each)
-        std::array<std::array<int, 3>, 6> neighbors = {{
-            {x+1, y, z}, {x-1, y, z},
-            {x, y+1, z}, {x, y-1, z}, 
-            {x, y, z+1}, {x, y, z-1}
-        }};
-        
-        for (const auto& neighbor : neighbors) {
-            if (rng() % 2 == 0) { // 50% chance
-                int nx = neighbor[0], ny = neighbor[1], nz = neighbor[2];
-                if (IsValidPosition(nx, ny, nz) && m_blocks[nx][ny][nz].GetType() == BlockType::STONE) {
-                    // Check if not already in candidates
-                    bool alreadyCandidate = false;
-                    for (const auto& candidate : candidates) {
-                        if (candidate[0] == nx && candidate[1] == ny && candidate[2] == nz) {
-                            alreadyCandidate = true;
-                            break;
-                        }
-                    }
-                    if (!alreadyCandidate) {
-                        candidates.push_back({nx, ny, nz});
-                    }
-                }
-            }
-        }
+        // Add neighboring stone blocks as candidates
+        addNeighbors(x, y, z);
     }
 }  
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include "ChunkMeshPool.h"
+#include "GLStateCache.h"
+#include "GpuProfiler.h"
+#include <algorithm>
+#include <iostream>
+
+ChunkMeshPool::Range ChunkMeshPool::Allocate(int vertexCount) {
+    Range range;
+    if (vertexCount <= 0) {
+        return range;
+    }
+    if (vertexCount > PAGE_VERTICES) {
+        std::cerr << "[MESH] Range of " << vertexCount << " vertices does not fit a mesh pool page" << std::endl;
+        return range;
+    }
+
+    auto fits = [vertexCount](const std::pair<const int, int>& freeRun) { return freeRun.second >= vertexCount; };
+    int pageIndex = 0;
+    std::map<int, int>::iterator run;
+    for (; pageIndex < static_cast<int>(m_pages.size()); ++pageIndex) {
+        std::map<int, int>& freeRuns = m_pages[pageIndex].freeRuns;
+        run = std::find_if(freeRuns.begin(), freeRuns.end(), fits);
+        if (run != freeRuns.end()) {
+            break;
+        }
+    }
+    if (pageIndex == static_cast<int>(m_pages.size())) {
+        if (!AddPage()) {
+            return range;
+        }
+        run = m_pages.back().freeRuns.begin();
+    }
+
+    // Take the front of the run and keep the remainder free
+    Page& page = m_pages[pageIndex];
+    range.page = pageIndex;
+    range.first = run->first;
+    range.capacity = vertexCount;
+    int remaining = run->second - vertexCount;
+    page.freeRuns.erase(run);
+    if (remaining > 0) {
+        page.freeRuns.emplace(range.first + vertexCount, remaining);
+    }
+
+    m_reservedVertices += vertexCount;
+    m_maxRangeVertices = std::max(m_maxRangeVertices, vertexCount);
+    return range;
+}
+
+void ChunkMeshPool::Free(Range& range) {
+    if (range.capacity > 0 && range.page < static_cast<int>(m_pages.size())) {
+        AddFreeRun(m_pages[range.page], range.first, range.capacity);
+        m_reservedVertices -= range.capacity;
+    }
+    range = Range();
+}
+
+void ChunkMeshPool::AddFreeRun(Page& page, int first, int length) {
+    std::map<int, int>& freeRuns = page.freeRuns;
+    auto next = freeRuns.lower_bound(first);
+
+    // Merge with the run that ends where this one starts, then with the run that starts where it ends
+    if (next != freeRuns.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == first) {
+            first = previous->first;
+            length += previous->second;
+            freeRuns.erase(previous);
+        }
+    }
+    if (next != freeRuns.end() && first + length == next->first) {
+        length += next->second;
+        freeRuns.erase(next);
+    }
+
+    freeRuns.emplace(first, length);
+}
+
+void ChunkMeshPool::Upload(const Range& range, const std::vector<ChunkVertex>& vertices) {
+    if (vertices.empty() || range.capacity == 0) {
+        return;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, m_pages[range.page].vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, range.first * sizeof(ChunkVertex), vertices.size() * sizeof(ChunkVertex), vertices.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GpuProfiler::CountUpload(vertices.size() * sizeof(ChunkVertex));
+}
+
+bool ChunkMeshPool::AddPage() {
+    Page page;
+    glGenBuffers(1, &page.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, page.vbo);
+    glBufferData(GL_ARRAY_BUFFER, PAGE_VERTICES * sizeof(ChunkVertex), nullptr, GL_DYNAMIC_DRAW);
+    if (glGetError() == GL_OUT_OF_MEMORY) {
+        std::cerr << "[MESH] Out of GPU memory for another mesh pool page" << std::endl;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glDeleteBuffers(1, &page.vbo);
+        return false;
+    }
+
+    glGenVertexArrays(1, &page.vao);
+    GLStateCache::BindVertexArray(page.vao);
+
+    // Packed position and face - location 0
+    glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)offsetof(ChunkVertex, position));
+    glEnableVertexAttribArray(0);
+
+    // Packed AO level, corner, flags, texture layer and tint - location 1
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)offsetof(ChunkVertex, attributes));
+    glEnableVertexAttribArray(1);
+
+    GLStateCache::BindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    page.freeRuns.emplace(0, PAGE_VERTICES);
+    m_pages.push_back(std::move(page));
+    return true;
+}
+
+void ChunkMeshPool::Release() {
+    for (Page& page : m_pages) {
+        glDeleteVertexArrays(1, &page.vao);
+        glDeleteBuffers(1, &page.vbo);
+    }
+    m_pages.clear();
+    if (m_indirectBuffer) {
+        glDeleteBuffers(1, &m_indirectBuffer);
+        m_indirectBuffer = 0;
+    }
+    m_reservedVertices = 0;
+    m_maxRangeVertices = 0;
+}
+
+void ChunkMeshPool::BeginCommands() {
+    for (Page& page : m_pages) {
+        page.commands.clear();
+    }
+}
+
+void ChunkMeshPool::AddCommand(const Range& range, int vertexCount) {
+    if (vertexCount <= 0 || range.capacity == 0) {
+        return;
+    }
+    auto toIndexCount = [](int vertices) {
+        return static_cast<GLuint>(vertices / QuadIndexBuffer::VERTICES_PER_QUAD * QuadIndexBuffer::INDICES_PER_QUAD);
+    };
+    std::vector<DrawElementsIndirectCommand>& commands = m_pages[range.page].commands;
+
+    // Quad indices are continuous, so a range that starts right where the previous one ended extends it,
+    // as long as the merged range stays within the index buffer (sized for the largest single range)
+    if (!commands.empty()) {
+        DrawElementsIndirectCommand& previous = commands.back();
+        int previousVertices = static_cast<int>(previous.count) / QuadIndexBuffer::INDICES_PER_QUAD * QuadIndexBuffer::VERTICES_PER_QUAD;
+        if (previous.baseVertex + previousVertices == range.first && previousVertices + vertexCount <= m_maxRangeVertices) {
+            previous.count = toIndexCount(previousVertices + vertexCount);
+            return;
+        }
+    }
+    commands.push_back({toIndexCount(vertexCount), 1, 0, range.first, 0});
+}
+
+int ChunkMeshPool::GetCommandCount() const {
+    int count = 0;
+    for (const Page& page : m_pages) {
+        count += static_cast<int>(page.commands.size());
+    }
+    return count;
+}
+
+int ChunkMeshPool::GetSubmissionCount() const {
+    int count = 0;
+    for (const Page& page : m_pages) {
+        count += page.commands.empty() ? 0 : 1;
+    }
+    return count;
+}
+
+void ChunkMeshPool::SubmitCommands() {
+    int commandCount = GetCommandCount();
+    if (commandCount == 0) {
+        return;
+    }
+
+    // Every command starts at the first quad, so the index buffer only has to cover the largest range
+    GLuint indexBuffer = QuadIndexBuffer::Acquire(static_cast<size_t>(m_maxRangeVertices / QuadIndexBuffer::VERTICES_PER_QUAD));
+
+#ifndef __APPLE__
+    if (SupportsIndirectDraw()) {
+        // One upload for every page's commands; each page then draws its slice
+        m_indirectCommands.clear();
+        for (const Page& page : m_pages) {
+            m_indirectCommands.insert(m_indirectCommands.end(), page.commands.begin(), page.commands.end());
+        }
+        if (m_indirectBuffer == 0) {
+            glGenBuffers(1, &m_indirectBuffer);
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+        // Orphan last frame's commands instead of waiting for the GPU to finish reading them
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, m_indirectCommands.size() * sizeof(DrawElementsIndirectCommand),
+                     m_indirectCommands.data(), GL_STREAM_DRAW);
+        GpuProfiler::CountUpload(m_indirectCommands.size() * sizeof(DrawElementsIndirectCommand));
+
+        size_t offset = 0;
+        for (const Page& page : m_pages) {
+            if (page.commands.empty()) {
+                continue;
+            }
+            GLStateCache::BindVertexArray(page.vao);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const void*)(offset * sizeof(DrawElementsIndirectCommand)),
+                                        static_cast<GLsizei>(page.commands.size()), 0);
+            GpuProfiler::CountDraw(GetPageVertexCount(page));
+            offset += page.commands.size();
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        return;
+    }
+#endif
+
+    for (const Page& page : m_pages) {
+        if (page.commands.empty()) {
+            continue;
+        }
+        size_t count = page.commands.size();
+        m_fallbackCounts.resize(count);
+        m_fallbackBaseVertices.resize(count);
+        m_fallbackOffsets.assign(count, nullptr);
+        for (size_t i = 0; i < count; ++i) {
+            m_fallbackCounts[i] = static_cast<GLsizei>(page.commands[i].count);
+            m_fallbackBaseVertices[i] = page.commands[i].baseVertex;
+        }
+        GLStateCache::BindVertexArray(page.vao);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_fallbackCounts.data(), GL_UNSIGNED_INT, m_fallbackOffsets.data(),
+                                      static_cast<GLsizei>(count), m_fallbackBaseVertices.data());
+        GpuProfiler::CountDraw(GetPageVertexCount(page));
+    }
+}
+
+int64_t ChunkMeshPool::GetPageVertexCount(const Page& page) {
+    int64_t indices = 0;
+    for (const DrawElementsIndirectCommand& command : page.commands) {
+        indices += command.count;
+    }
+    return indices / QuadIndexBuffer::INDICES_PER_QUAD * QuadIndexBuffer::VERTICES_PER_QUAD;
+}
+
+bool ChunkMeshPool::SupportsIndirectDraw() {
+#ifdef __APPLE__
+    return false; // macOS stops at OpenGL 4.1
+#else
+    static const bool supported = epoxy_gl_version() >= 43 || epoxy_has_gl_extension("GL_ARB_multi_draw_indirect");
+    return supported;
+#endif
+}
@@ -0,0 +1,724 @@
+#include "ChunkMesher.h"
+#include "BiomeSystem.h"
+#include "World.h"
+#include <algorithm>
+
+namespace {
+    // In-plane layout of each cube face, used to emit quads of any extent.
+    // Corner i of every face sits at (a, b) = (0,0), (1,0), (1,1), (0,1) along (uAxis, vAxis),
+    // which is also the order CalculateFaceAOLevels returns the corner AO levels in.
+    struct FaceLayout {
+        int normalAxis;      // 0 = X, 1 = Y, 2 = Z
+        bool positive;       // Face lies on the +normal side of the block
+        int uAxis;           // First in-plane axis
+        int vAxis;           // Second in-plane axis
+        bool sideFace;       // Texture can be flipped vertically (grass sides)
+        int order[4];        // Corner emission order; the shared index buffer draws (0,1,2) and (2,3,0)
+    };
+    
+    const FaceLayout FACE_LAYOUTS[6] = {
+        {2, true,  0, 1, true,  {0, 1, 2, 3}}, // FRONT  (+Z)
+        {2, false, 0, 1, true,  {0, 3, 2, 1}}, // BACK   (-Z)
+        {0, false, 2, 1, true,  {0, 1, 2, 3}}, // LEFT   (-X)
+        {0, true,  2, 1, true,  {0, 3, 2, 1}}, // RIGHT  (+X)
+        {1, false, 0, 2, false, {0, 1, 2, 3}}, // BOTTOM (-Y)
+        {1, true,  0, 2, false, {0, 3, 2, 1}}, // TOP    (+Y)
+    };
+    
+    // Texture layer and biome tint of one face of a block type (face 4 is the bottom, 5 the top)
+    int GetFaceLayer(const BlockTextureLayers& layers, int face) {
+        return face == 5 ? layers.top : (face == 4 ? layers.bottom : layers.side);
+    }
+    BiomeTint GetFaceTint(const BlockTextureLayers& layers, int face) {
+        return face == 5 ? layers.topTint : (face == 4 ? layers.bottomTint : layers.sideTint);
+    }
+    
+    const int CORNER_A[4] = {0, 1, 1, 0};
+    const int CORNER_B[4] = {0, 0, 1, 1};
+    
+    // AO ring: the 3x3 blocks in front of a face, bit (dv + 1) * 3 + (du + 1) for offsets du, dv
+    // along the face's u and v axes. The centre bit (the block the face looks at) is never sampled.
+    // Each entry packs the four corner AO levels, one per byte in corner order.
+    constexpr int AO_RING_COMBINATIONS = 1 << 9;
+    
+    std::array<uint32_t, AO_RING_COMBINATIONS> BuildAORingLevels() {
+        std::array<uint32_t, AO_RING_COMBINATIONS> table = {};
+        for (int ring = 0; ring < AO_RING_COMBINATIONS; ++ring) {
+            auto occluded = [ring](int du, int dv) { return ((ring >> ((dv + 1) * 3 + du + 1)) & 1) != 0; };
+            uint32_t packed = 0;
+            for (int corner = 0; corner < 4; ++corner) {
+                // Each corner samples the two edge neighbours towards it and the diagonal between them
+                int du = CORNER_A[corner] ? 1 : -1;
+                int dv = CORNER_B[corner] ? 1 : -1;
+                bool side1 = occluded(du, 0);
+                bool side2 = occluded(0, dv);
+                bool diagonal = occluded(du, dv);
+                
+                // Minecraft's formula: both sides blocked is fully occluded (the diagonal cannot show through),
+                // otherwise one level per occluding block. The shader maps the level to 1.0 / 0.8 / 0.6 / 0.4
+                // (0.25 when fully occluded) and applies the directional face shade.
+                int level = (side1 && side2) ? AO_LEVEL_FULLY_OCCLUDED : (side1 ? 1 : 0) + (side2 ? 1 : 0) + (diagonal ? 1 : 0);
+                packed |= static_cast<uint32_t>(level) << (corner * 8);
+            }
+            table[ring] = packed;
+        }
+        return table;
+    }
+    
+    const std::array<uint32_t, AO_RING_COMBINATIONS> AO_RING_LEVELS = BuildAORingLevels();
+}
+
+ChunkMesher::ChunkMesher(const ChunkMeshSnapshot& snapshot, const BlockManager* blockManager)
+    : m_snapshot(snapshot), m_blockManager(blockManager),
+      m_originX((snapshot.chunkX - WORLD_MIN_CHUNK) * CHUNK_WIDTH),
+      m_originZ((snapshot.chunkZ - WORLD_MIN_CHUNK) * CHUNK_DEPTH) {
+    m_typeFlags.fill(0);
+}
+
+void ChunkMesher::CaptureSnapshot(ChunkMeshSnapshot& snapshot, const Chunk& chunk, const World* world, const BlockManager* blockManager,
+                                  uint16_t sectionMask) {
+    snapshot.chunkX = chunk.GetChunkX();
+    snapshot.chunkZ = chunk.GetChunkZ();
+    snapshot.meshingMode = Chunk::GetMeshingMode();
+    snapshot.sectionMask = sectionMask;
+    
+    // Biomes of the tint grid points come from the chunks that own them; the colours are blended
+    // by the mesh worker
+    snapshot.seed = world ? world->GetSeed() : 0;
+    for (int j = 0; j < BIOME_TINT_POINTS; ++j) {
+        for (int i = 0; i < BIOME_TINT_POINTS; ++i) {
+            int x = (i - 1) * BIOME_TINT_SPACING;
+            int z = (j - 1) * BIOME_TINT_SPACING;
+            int offsetX = x < 0 ? -1 : x / CHUNK_WIDTH;
+            int offsetZ = z < 0 ? -1 : z / CHUNK_DEPTH;
+            const Chunk* owner = &chunk;
+            if (offsetX != 0 || offsetZ != 0) {
+                owner = world ? world->GetChunk(snapshot.chunkX + offsetX, snapshot.chunkZ + offsetZ) : nullptr;
+            }
+            snapshot.tintBiomes[j * BIOME_TINT_POINTS + i] =
+                owner ? owner->GetBiome(x - offsetX * CHUNK_WIDTH, z - offsetZ * CHUNK_DEPTH) : BiomeType::COUNT;
+        }
+    }
+    
+    // Sections are palette-compressed, so copying them is cheap next to building the mesh
+    snapshot.opaqueSections = 0;
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        snapshot.sections[sectionY] = chunk.GetSection(sectionY);
+        if (chunk.IsSectionFullyOpaque(sectionY, blockManager)) {
+            snapshot.opaqueSections |= static_cast<uint16_t>(1u << sectionY);
+        }
+    }
+    
+    static const int neighborOffsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    for (int i = 0; i < 4; ++i) {
+        const Chunk* neighbor = world ? world->GetChunk(snapshot.chunkX + neighborOffsets[i][0], snapshot.chunkZ + neighborOffsets[i][1]) : nullptr;
+        uint16_t opaqueSections = 0;
+        for (int sectionY = 0; neighbor && sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+            if (neighbor->IsSectionFullyOpaque(sectionY, blockManager)) {
+                opaqueSections |= static_cast<uint16_t>(1u << sectionY);
+            }
+        }
+        snapshot.neighborOpaqueSections[i] = opaqueSections;
+    }
+    
+    if (!chunk.GetOccupiedYRange(snapshot.minOccupiedY, snapshot.maxOccupiedY)) {
+        snapshot.minOccupiedY = snapshot.maxOccupiedY = -1;
+    }
+    
+    // Copy one block column from the neighbour that owns local column (x, z); without a world or
+    // neighbour the column stays air, matching what World::GetBlock returns outside the world
+    auto captureColumn = [&](int x, int z) {
+        std::array<BlockType, CHUNK_HEIGHT>& column = snapshot.borderColumns[ChunkMeshSnapshot::BorderColumnIndex(x, z)];
+        int offsetX = x < 0 ? -1 : (x >= CHUNK_WIDTH ? 1 : 0);
+        int offsetZ = z < 0 ? -1 : (z >= CHUNK_DEPTH ? 1 : 0);
+        const Chunk* neighbor = world ? world->GetChunk(snapshot.chunkX + offsetX, snapshot.chunkZ + offsetZ) : nullptr;
+        if (!neighbor) {
+            column.fill(BlockType::AIR);
+            return;
+        }
+        
+        int localX = x - offsetX * CHUNK_WIDTH;
+        int localZ = z - offsetZ * CHUNK_DEPTH;
+        for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+            const ChunkSection& section = neighbor->GetSection(sectionY);
+            BlockType* out = &column[sectionY * SECTION_SIZE];
+            if (section.IsUniform()) {
+                std::fill(out, out + SECTION_SIZE, section.GetUniformType());
+                continue;
+            }
+            for (int y = 0; y < SECTION_SIZE; ++y) {
+                out[y] = section.Get(localX, y, localZ);
+            }
+        }
+    };
+    
+    for (int x = -1; x <= CHUNK_WIDTH; ++x) {
+        captureColumn(x, -1);
+        captureColumn(x, CHUNK_DEPTH);
+    }
+    for (int z = 0; z < CHUNK_DEPTH; ++z) {
+        captureColumn(-1, z);
+        captureColumn(CHUNK_WIDTH, z);
+    }
+}
+
+void ChunkMesher::Build(ChunkMeshData& meshData) {
+    meshData.sectionMask = m_snapshot.sectionMask;
+    meshData.minOccupiedY = m_snapshot.minOccupiedY;
+    meshData.maxOccupiedY = m_snapshot.maxOccupiedY;
+    ComputeBiomeTints();
+    
+    // Generate mesh data for all non-air blocks, grouped by type, one section at a time
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        if (!((m_snapshot.sectionMask >> sectionY) & 1)) {
+            continue; // Not requested; the uploaded section stays as it is
+        }
+        
+        // Empty sections have no geometry of their own and let the view through in every direction
+        if (m_snapshot.sections[sectionY].IsEmpty()) {
+            meshData.sectionVisibility[sectionY] = SECTION_VISIBILITY_ALL;
+            continue;
+        }
+        
+        // A uniform opaque section can only expose faces on its outer shell,
+        // and none at all when every neighbouring section is opaque as well
+        bool fullyOpaque = IsSectionFullyOpaque(sectionY);
+        if (fullyOpaque) {
+            meshData.sectionVisibility[sectionY] = 0;
+            if (AreSectionNeighborsOpaque(sectionY)) {
+                continue;
+            }
+        }
+        
+        FillPaddedSection(sectionY);
+        if (!fullyOpaque) {
+            meshData.sectionVisibility[sectionY] = ComputeSectionVisibility();
+        }
+        if (m_snapshot.meshingMode == Chunk::MeshingMode::GREEDY) {
+            AddSectionGreedy(meshData, sectionY, fullyOpaque);
+        } else {
+            AddSectionPerFace(meshData, sectionY, fullyOpaque);
+        }
+    }
+}
+
+void ChunkMesher::FillPaddedSection(int sectionY) {
+    m_paddedBaseY = sectionY * SECTION_SIZE;
+    
+    // Border cells above and below the world, and around missing neighbours, come back as AIR
+    for (int localY = -1; localY <= SECTION_SIZE; ++localY) {
+        int y = m_paddedBaseY + localY;
+        for (int z = -1; z <= CHUNK_DEPTH; ++z) {
+            BlockType* row = &m_padded[PaddedIndex(-1, localY, z)];
+            uint32_t occluders = 0, seeThrough = 0, water = 0;
+            for (int x = -1; x <= CHUNK_WIDTH; ++x) {
+                row[x + 1] = m_snapshot.GetType(x, y, z);
+                uint32_t flags = GetTypeFlags(row[x + 1]);
+                uint32_t bit = 1u << (x + 1);
+                occluders |= (flags & BLOCK_FLAG_CUBE) ? bit : 0;
+                seeThrough |= (flags & BLOCK_FLAG_SEE_THROUGH) ? bit : 0;
+                water |= (flags & BLOCK_FLAG_WATER) ? bit : 0;
+            }
+            int rowIndex = OccluderRowIndex(localY, z);
+            m_occluderRows[rowIndex] = occluders;
+            m_seeThroughRows[rowIndex] = seeThrough;
+            m_waterRows[rowIndex] = water;
+        }
+    }
+    
+    BuildFaceRows();
+}
+
+void ChunkMesher::BuildFaceRows() {
+    // A cube face is visible when water meets anything but water, or when any other cube
+    // meets a see-through neighbour. Whole rows are resolved at once: the X neighbours are
+    // the same row shifted by one bit, the Y and Z neighbours are the adjacent rows.
+    for (int localY = 0; localY < SECTION_SIZE; ++localY) {
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            int rowIndex = OccluderRowIndex(localY, z);
+            uint32_t cubes = m_occluderRows[rowIndex];
+            uint32_t water = m_waterRows[rowIndex];
+            
+            auto visibleAgainst = [&](int neighborRow, int shift) {
+                uint32_t neighborSeeThrough = m_seeThroughRows[neighborRow];
+                uint32_t neighborWater = m_waterRows[neighborRow];
+                if (shift > 0) {
+                    neighborSeeThrough >>= shift;
+                    neighborWater >>= shift;
+                } else if (shift < 0) {
+                    neighborSeeThrough <<= -shift;
+                    neighborWater <<= -shift;
+                }
+                uint32_t visible = cubes & ((water & ~neighborWater) | (~water & neighborSeeThrough));
+                return static_cast<uint16_t>(visible >> 1); // Drop the padding bit so bit x is cell x
+            };
+            
+            int cell = localY * SECTION_SIZE + z;
+            m_faceRows[FACE_FRONT][cell] = visibleAgainst(OccluderRowIndex(localY, z + 1), 0);
+            m_faceRows[FACE_BACK][cell] = visibleAgainst(OccluderRowIndex(localY, z - 1), 0);
+            m_faceRows[FACE_LEFT][cell] = visibleAgainst(rowIndex, -1);
+            m_faceRows[FACE_RIGHT][cell] = visibleAgainst(rowIndex, 1);
+            m_faceRows[FACE_BOTTOM][cell] = visibleAgainst(OccluderRowIndex(localY - 1, z), 0);
+            m_faceRows[FACE_TOP][cell] = visibleAgainst(OccluderRowIndex(localY + 1, z), 0);
+        }
+    }
+}
+
+SectionVisibility ChunkMesher::ComputeSectionVisibility() {
+    // Cells the view passes through: everything but cubes that hide their neighbours' faces
+    int openCells = 0;
+    for (int localY = 0; localY < SECTION_SIZE; ++localY) {
+        for (int z = 0; z < CHUNK_DEPTH; ++z) {
+            int rowIndex = OccluderRowIndex(localY, z);
+            uint32_t opaque = m_occluderRows[rowIndex] & ~m_seeThroughRows[rowIndex];
+            uint16_t open = static_cast<uint16_t>(~(opaque >> 1));
+            m_unvisitedRows[localY * SECTION_SIZE + z] = open;
+            for (uint16_t bits = open; bits != 0; bits &= bits - 1) {
+                ++openCells;
+            }
+        }
+    }
+    if (openCells == 0) {
+        return 0;
+    }
+    if (openCells == SECTION_SIZE * SECTION_SIZE * SECTION_SIZE) {
+        return SECTION_VISIBILITY_ALL;
+    }
+    
+    // Each connected region of open cells joins every section face it touches
+    SectionVisibility visibility = 0;
+    for (int row = 0; row < SECTION_SIZE * SECTION_SIZE; ++row) {
+        while (m_unvisitedRows[row] != 0) {
+            int seedX = 0;
+            while (!((m_unvisitedRows[row] >> seedX) & 1)) {
+                ++seedX;
+            }
+            m_unvisitedRows[row] &= static_cast<uint16_t>(~(1u << seedX));
+            int stackSize = 0;
+            m_floodStack[stackSize++] = static_cast<uint16_t>(row * SECTION_SIZE + seedX);
+            
+            uint32_t faces = 0;
+            while (stackSize > 0) {
+                int cell = m_floodStack[--stackSize];
+                int x = cell & 15, z = (cell >> 4) & 15, localY = cell >> 8;
+                if (x == 0) faces |= 1u << FACE_LEFT;
+                if (x == SECTION_SIZE - 1) faces |= 1u << FACE_RIGHT;
+                if (z == 0) faces |= 1u << FACE_BACK;
+                if (z == SECTION_SIZE - 1) faces |= 1u << FACE_FRONT;
+                if (localY == 0) faces |= 1u << FACE_BOTTOM;
+                if (localY == SECTION_SIZE - 1) faces |= 1u << FACE_TOP;
+                
+                auto visit = [&](int nx, int nLocalY, int nz) {
+                    if (nx < 0 || nx >= SECTION_SIZE || nz < 0 || nz >= SECTION_SIZE || nLocalY < 0 || nLocalY >= SECTION_SIZE) {
+                        return;
+                    }
+                    uint16_t& rowBits = m_unvisitedRows[nLocalY * SECTION_SIZE + nz];
+                    if ((rowBits >> nx) & 1) {
+                        rowBits &= static_cast<uint16_t>(~(1u << nx));
+                        m_floodStack[stackSize++] = static_cast<uint16_t>((nLocalY * SECTION_SIZE + nz) * SECTION_SIZE + nx);
+                    }
+                };
+                visit(x - 1, localY, z);
+                visit(x + 1, localY, z);
+                visit(x, localY, z - 1);
+                visit(x, localY, z + 1);
+                visit(x, localY - 1, z);
+                visit(x, localY + 1, z);
+            }
+            
+            for (int face = 0; face < SECTION_FACE_COUNT; ++face) {
+                if ((faces >> face) & 1) {
+                    visibility |= static_cast<SectionVisibility>(faces) << (face * SECTION_FACE_COUNT);
+                }
+            }
+        }
+    }
+    return visibility;
+}
+
+uint8_t ChunkMesher::GetTypeFlags(BlockType blockType) {
+    size_t typeIndex = static_cast<size_t>(blockType);
+    if (typeIndex >= m_typeFlags.size()) {
+        return ClassifyType(blockType); // Ids past the cache (possible from server data) are not cached
+    }
+    if (m_typeFlags[typeIndex] == 0) {
+        m_typeFlags[typeIndex] = ClassifyType(blockType);
+    }
+    return m_typeFlags[typeIndex];
+}
+
+uint8_t ChunkMesher::ClassifyType(BlockType blockType) const {
+    bool isAir = blockType == BlockType::AIR;
+    bool isWater = blockType == BlockType::WATER_STILL || blockType == BlockType::WATER_FLOW;
+    // Ground blocks (flowers, saplings, etc.) render as cross sprites and do not contribute to ambient occlusion
+    bool isGround = m_blockManager && m_blockManager->IsGround(blockType);
+    
+    uint8_t flags = BLOCK_FLAG_KNOWN;
+    if (!isAir && !isGround) {
+        flags |= BLOCK_FLAG_CUBE;
+    }
+    if (isWater) {
+        flags |= BLOCK_FLAG_WATER;
+    } else if (m_blockManager && (isGround || m_blockManager->IsTransparent(blockType))) {
+        flags |= BLOCK_FLAG_CUTOUT;
+    }
+    // Faces next to air are always shown; with a BlockManager, water, transparent and ground
+    // neighbours show them as well
+    if (isAir || (m_blockManager && (isWater || isGround || m_blockManager->IsTransparent(blockType)))) {
+        flags |= BLOCK_FLAG_SEE_THROUGH;
+    }
+    return flags;
+}
+
+std::vector<ChunkVertex>& ChunkMesher::SelectPassVertices(ChunkMeshData& meshData, int sectionY, BlockType blockType) const {
+    // Every block in the section was classified while filling the padded buffer, except ids past the cache
+    size_t typeIndex = static_cast<size_t>(blockType);
+    uint8_t flags = typeIndex < m_typeFlags.size() ? m_typeFlags[typeIndex] : ClassifyType(blockType);
+    Chunk::MeshPass pass = Chunk::MESH_PASS_SOLID;
+    if (flags & BLOCK_FLAG_WATER) {
+        pass = Chunk::MESH_PASS_WATER;
+    } else if (flags & BLOCK_FLAG_CUTOUT) {
+        pass = Chunk::MESH_PASS_CUTOUT;
+    }
+    return meshData.passVertices[pass][sectionY];
+}
+
+void ChunkMesher::ComputeBiomeTints() {
+    // Grid points from one cell before the chunk to one cell after it, so every point the columns
+    // interpolate between has all 8 neighbours for the average
+    constexpr int POINTS = BIOME_TINT_POINTS;
+    float grass[POINTS][POINTS][3];
+    float foliage[POINTS][POINTS][3];
+    int baseX = m_snapshot.chunkX * CHUNK_WIDTH - BIOME_TINT_SPACING;
+    int baseZ = m_snapshot.chunkZ * CHUNK_DEPTH - BIOME_TINT_SPACING;
+    for (int i = 0; i < POINTS; ++i) {
+        for (int j = 0; j < POINTS; ++j) {
+            BiomeType biome = m_snapshot.tintBiomes[j * POINTS + i];
+            if (biome == BiomeType::COUNT) {
+                biome = BiomeSystem::GetBiomeType(baseX + i * BIOME_TINT_SPACING, baseZ + j * BIOME_TINT_SPACING, m_snapshot.seed);
+            }
+            BiomeSystem::GetGrassColor(biome, grass[i][j][0], grass[i][j][1], grass[i][j][2]);
+            BiomeSystem::GetFoliageColor(biome, foliage[i][j][0], foliage[i][j][1], foliage[i][j][2]);
+        }
+    }
+    
+    // 3x3 average around each interpolated point (grid indices 1 to BIOME_TINT_CELLS + 1)
+    constexpr int BLENDED = BIOME_TINT_CELLS + 1;
+    float blendedGrass[BLENDED][BLENDED][3] = {};
+    float blendedFoliage[BLENDED][BLENDED][3] = {};
+    for (int i = 0; i < BLENDED; ++i) {
+        for (int j = 0; j < BLENDED; ++j) {
+            for (int di = 0; di < 3; ++di) {
+                for (int dj = 0; dj < 3; ++dj) {
+                    for (int c = 0; c < 3; ++c) {
+                        blendedGrass[i][j][c] += grass[i + di][j + dj][c] / 9.0f;
+                        blendedFoliage[i][j][c] += foliage[i + di][j + dj][c] / 9.0f;
+                    }
+                }
+            }
+        }
+    }
+    
+    for (int z = 0; z < CHUNK_DEPTH; ++z) {
+        int j = z / BIOME_TINT_SPACING;
+        float tz = static_cast<float>(z % BIOME_TINT_SPACING) / BIOME_TINT_SPACING;
+        for (int x = 0; x < CHUNK_WIDTH; ++x) {
+            int i = x / BIOME_TINT_SPACING;
+            float tx = static_cast<float>(x % BIOME_TINT_SPACING) / BIOME_TINT_SPACING;
+            auto interpolate = [&](const float (&points)[BLENDED][BLENDED][3], int c) {
+                float row0 = points[i][j][c] + (points[i + 1][j][c] - points[i][j][c]) * tx;
+                float row1 = points[i][j + 1][c] + (points[i + 1][j + 1][c] - points[i][j + 1][c]) * tx;
+                return row0 + (row1 - row0) * tz;
+            };
+            m_grassTints[z * CHUNK_WIDTH + x] = static_cast<uint16_t>(
+                ChunkVertex::PackTintColor(interpolate(blendedGrass, 0), interpolate(blendedGrass, 1), interpolate(blendedGrass, 2)));
+            m_foliageTints[z * CHUNK_WIDTH + x] = static_cast<uint16_t>(
+                ChunkVertex::PackTintColor(interpolate(blendedFoliage, 0), interpolate(blendedFoliage, 1), interpolate(blendedFoliage, 2)));
+        }
+    }
+}
+
+uint32_t ChunkMesher::GetTintColor(BiomeTint tint, int x, int z) const {
+    switch (tint) {
+        case BiomeTint::GRASS: return m_grassTints[z * CHUNK_WIDTH + x];
+        case BiomeTint::FOLIAGE: return m_foliageTints[z * CHUNK_WIDTH + x];
+        default: return CHUNK_VERTEX_TINT_WHITE;
+    }
+}
+
+void ChunkMesher::AddSectionPerFace(ChunkMeshData& meshData, int sectionY, bool fullyOpaque) const {
+    int baseY = sectionY * SECTION_SIZE;
+    for (int x = 0; x < CHUNK_WIDTH; ++x) {
+        for (int localY = 0; localY < SECTION_SIZE; ++localY) {
+            int y = baseY + localY;
+            bool interiorRow = fullyOpaque && x > 0 && x < CHUNK_WIDTH - 1 && localY > 0 && localY < SECTION_SIZE - 1;
+            // Interior rows of an opaque section only need their two end cells
+            for (int z = 0; z < CHUNK_DEPTH; z += (interiorRow && z == 0) ? CHUNK_DEPTH - 1 : 1) {
+                BlockType blockType = GetTypeAt(x, y, z);
+                if (blockType == BlockType::AIR) {
+                    continue;
+                }
+                
+                // Ground blocks render as diagonal cross sprites
+                std::vector<ChunkVertex>& vertices = SelectPassVertices(meshData, sectionY, blockType);
+                if (m_blockManager && m_blockManager->IsGround(blockType)) {
+                    AddCrossToMesh(vertices, x, y, z, blockType);
+                    continue;
+                }
+                
+                // Check each face for visibility (standard cube rendering)
+                for (int face = 0; face < 6; ++face) {
+                    if (IsFaceVisible(x, localY, z, face)) {
+                        AddFaceToMesh(vertices, x, y, z, face, blockType);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChunkMesher::AddSectionGreedy(ChunkMeshData& meshData, int sectionY, bool fullyOpaque) const {
+    int baseY = sectionY * SECTION_SIZE;
+    
+    // Ground plants are never merged and keep their per-block cross sprites
+    if (m_blockManager && !fullyOpaque) {
+        for (int y = baseY; y < baseY + SECTION_SIZE; ++y) {
+            for (int z = 0; z < CHUNK_DEPTH; ++z) {
+                for (int x = 0; x < CHUNK_WIDTH; ++x) {
+                    BlockType blockType = GetTypeAt(x, y, z);
+                    if (blockType != BlockType::AIR && m_blockManager->IsGround(blockType)) {
+                        AddCrossToMesh(SelectPassVertices(meshData, sectionY, blockType), x, y, z, blockType);
+                    }
+                }
+            }
+        }
+    }
+    
+    // One visible face per mask cell; faces only merge when block type, biome tint and all four AO values match
+    struct MaskCell {
+        bool visible;
+        BlockType type;
+        uint16_t tintColor;
+        uint8_t aoLevel[4];
+    };
+    MaskCell mask[SECTION_SIZE * SECTION_SIZE];
+    auto canMerge = [](const MaskCell& a, const MaskCell& b) {
+        return b.visible && a.type == b.type && a.tintColor == b.tintColor &&
+               a.aoLevel[0] == b.aoLevel[0] && a.aoLevel[1] == b.aoLevel[1] &&
+               a.aoLevel[2] == b.aoLevel[2] && a.aoLevel[3] == b.aoLevel[3];
+    };
+    
+    for (int face = 0; face < 6; ++face) {
+        const FaceLayout& layout = FACE_LAYOUTS[face];
+        
+        for (int slice = 0; slice < SECTION_SIZE; ++slice) {
+            // An opaque section can only expose the faces of its outermost slice in this direction
+            if (fullyOpaque && slice != (layout.positive ? SECTION_SIZE - 1 : 0)) {
+                continue;
+            }
+            
+            // Build the visibility mask for this slice, indexed [v * 16 + u]
+            int visibleCount = 0;
+            for (int v = 0; v < SECTION_SIZE; ++v) {
+                for (int u = 0; u < SECTION_SIZE; ++u) {
+                    int cell[3];
+                    cell[layout.normalAxis] = slice;
+                    cell[layout.uAxis] = u;
+                    cell[layout.vAxis] = v;
+                    int x = cell[0], y = baseY + cell[1], z = cell[2];
+                    
+                    MaskCell& maskCell = mask[v * SECTION_SIZE + u];
+                    maskCell.visible = false;
+                    
+                    // Only cubes (not air, not ground plants) ever have visible faces
+                    if (!IsFaceVisible(x, cell[1], z, face)) {
+                        continue;
+                    }
+                    
+                    maskCell.visible = true;
+                    maskCell.type = GetTypeAt(x, y, z);
+                    maskCell.tintColor = static_cast<uint16_t>(
+                        m_blockManager ? GetTintColor(GetFaceTint(m_blockManager->GetTextureLayers(maskCell.type), face), x, z) : CHUNK_VERTEX_TINT_WHITE);
+                    CalculateFaceAOLevels(x, y, z, face, maskCell.aoLevel);
+                    ++visibleCount;
+                }
+            }
+            if (visibleCount == 0) {
+                continue;
+            }
+            
+            // Sweep the mask, growing each rectangle along u first and then along v
+            for (int v = 0; v < SECTION_SIZE; ++v) {
+                for (int u = 0; u < SECTION_SIZE; ++u) {
+                    const MaskCell start = mask[v * SECTION_SIZE + u];
+                    if (!start.visible) {
+                        continue;
+                    }
+                    
+                    // AO is interpolated across the merged quad, so only grow along an axis
+                    // where the AO does not vary; otherwise the shading gradient would stretch
+                    bool flatAlongU = start.aoLevel[0] == start.aoLevel[1] && start.aoLevel[3] == start.aoLevel[2];
+                    bool flatAlongV = start.aoLevel[0] == start.aoLevel[3] && start.aoLevel[1] == start.aoLevel[2];
+                    
+                    int width = 1;
+                    while (flatAlongU && u + width < SECTION_SIZE && canMerge(start, mask[v * SECTION_SIZE + u + width])) {
+                        ++width;
+                    }
+                    
+                    int height = 1;
+                    while (flatAlongV && v + height < SECTION_SIZE) {
+                        bool rowMatches = true;
+                        for (int k = 0; k < width && rowMatches; ++k) {
+                            rowMatches = canMerge(start, mask[(v + height) * SECTION_SIZE + u + k]);
+                        }
+                        if (!rowMatches) {
+                            break;
+                        }
+                        ++height;
+                    }
+                    
+                    for (int dv = 0; dv < height; ++dv) {
+                        for (int du = 0; du < width; ++du) {
+                            mask[(v + dv) * SECTION_SIZE + u + du].visible = false;
+                        }
+                    }
+                    
+                    int cell[3];
+                    cell[layout.normalAxis] = slice;
+                    cell[layout.uAxis] = u;
+                    cell[layout.vAxis] = v;
+                    int extent[3] = {1, 1, 1};
+                    extent[layout.uAxis] = width;
+                    extent[layout.vAxis] = height;
+                    
+                    std::vector<ChunkVertex>& vertices = SelectPassVertices(meshData, sectionY, start.type);
+                    AddQuadToMesh(vertices, cell[0], baseY + cell[1], cell[2], face, extent, start.aoLevel, start.type);
+                }
+            }
+        }
+    }
+}
+
+bool ChunkMesher::AreSectionNeighborsOpaque(int sectionY) const {
+    // Faces at the top and bottom of the world are never hidden by a neighbour
+    if (sectionY == 0 || sectionY == CHUNK_SECTION_COUNT - 1) {
+        return false;
+    }
+    if (!IsSectionFullyOpaque(sectionY - 1) || !IsSectionFullyOpaque(sectionY + 1)) {
+        return false;
+    }
+    
+    // Missing neighbours were captured with no opaque sections
+    for (uint16_t neighborSections : m_snapshot.neighborOpaqueSections) {
+        if (!((neighborSections >> sectionY) & 1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ChunkMesher::AddFaceToMesh(std::vector<ChunkVertex>& vertices, int x, int y, int z, int faceDirection, BlockType blockType) const {
+    uint8_t aoLevels[4];
+    CalculateFaceAOLevels(x, y, z, faceDirection, aoLevels);
+    
+    const int extent[3] = {1, 1, 1};
+    AddQuadToMesh(vertices, x, y, z, faceDirection, extent, aoLevels, blockType);
+}
+
+void ChunkMesher::AddQuadToMesh(std::vector<ChunkVertex>& vertices, int x, int y, int z, int faceDirection, const int extent[3], const uint8_t aoLevels[4], BlockType blockType) const {
+    const FaceLayout& layout = FACE_LAYOUTS[faceDirection];
+    static const BlockTextureLayers noTextureLayers;
+    const BlockTextureLayers& layers = m_blockManager ? m_blockManager->GetTextureLayers(blockType) : noTextureLayers;
+    
+    int layer = GetFaceLayer(layers, faceDirection);
+    uint32_t tintColor = GetTintColor(GetFaceTint(layers, faceDirection), x, z); // Merged quads share one tint (see AddSectionGreedy)
+    
+    uint32_t flags = 0;
+    if (faceDirection == FACE_TOP && (blockType == BlockType::WATER_STILL || blockType == BlockType::WATER_FLOW)) {
+        flags |= CHUNK_VERTEX_FLAG_LOWERED_TOP; // Water surface at 15/16 height
+    }
+    if (layout.sideFace && blockType == BlockType::GRASS) {
+        flags |= CHUNK_VERTEX_FLAG_FLIP_V; // Grass sides keep the green edge at the top
+    }
+    if (layout.sideFace && layers.sideOverlay) {
+        flags |= CHUNK_VERTEX_FLAG_OVERLAY;
+    }
+    
+    // Vertices store block-corner coordinates: the quad spans from the first cell's min corner
+    // to the last cell's max corner along each in-plane axis
+    for (int i = 0; i < 4; ++i) {
+        int corner = layout.order[i];
+        int step[3] = {0, 0, 0};
+        step[layout.normalAxis] = layout.positive ? 1 : 0;
+        step[layout.uAxis] = CORNER_A[corner] ? extent[layout.uAxis] : 0;
+        step[layout.vAxis] = CORNER_B[corner] ? extent[layout.vAxis] : 0;
+        vertices.push_back(ChunkVertex::Pack(m_originX + x + step[0], y + step[1], m_originZ + z + step[2], faceDirection, aoLevels[corner], corner, flags,
+                                             layer, tintColor));
+    }
+}
+
+void ChunkMesher::AddCrossToMesh(std::vector<ChunkVertex>& vertices, int x, int y, int z, BlockType blockType) const {
+    // Two diagonal planes, each emitted twice with opposite winding so backface culling keeps one side.
+    // Corners follow the cube faces: 0 bottom-left, 1 bottom-right, 2 top-right, 3 top-left, and the
+    // shader maps them to the full texture. Plants use AO level 0 (full brightness).
+    struct CrossPlane {
+        int face;
+        int leftDz, rightDz;   // z offset of the plane's left (x) and right (x + 1) edges
+        int orders[2][4];      // Front then back corner order
+    };
+    static const CrossPlane planes[2] = {
+        {CHUNK_VERTEX_FACE_CROSS_A, 0, 1, {{0, 1, 2, 3}, {0, 3, 2, 1}}},
+        {CHUNK_VERTEX_FACE_CROSS_B, 1, 0, {{0, 3, 2, 1}, {0, 1, 2, 3}}},
+    };
+    
+    static const BlockTextureLayers noTextureLayers;
+    const BlockTextureLayers& layers = m_blockManager ? m_blockManager->GetTextureLayers(blockType) : noTextureLayers;
+    uint32_t tintColor = GetTintColor(layers.sideTint, x, z);
+    
+    for (const CrossPlane& plane : planes) {
+        for (const auto& order : plane.orders) {
+            for (int i = 0; i < 4; ++i) {
+                int corner = order[i];
+                bool right = CORNER_A[corner] != 0;
+                int cornerX = m_originX + x + (right ? 1 : 0);
+                int cornerY = y + CORNER_B[corner];
+                int cornerZ = m_originZ + z + (right ? plane.rightDz : plane.leftDz);
+                vertices.push_back(ChunkVertex::Pack(cornerX, cornerY, cornerZ, plane.face, 0, corner, 0,
+                                                     layers.side, tintColor));
+            }
+        }
+    }
+}
+
+// A few occluder row reads and one table load per visible face; this is a negligible part of a mesh
+// build next to face emission, so it works face by face rather than vectorising whole rows
+void ChunkMesher::CalculateFaceAOLevels(int x, int y, int z, int faceDirection, uint8_t aoLevels[4]) const {
+    const FaceLayout& layout = FACE_LAYOUTS[faceDirection];
+    int localY = y - m_paddedBaseY;
+    int ring = 0;
+    
+    if (layout.uAxis == 0) {
+        // u runs along X, so each v row of the ring is three adjacent bits of one occluder row
+        for (int dv = -1; dv <= 1; ++dv) {
+            int cell[3] = {x, localY, z};
+            cell[layout.normalAxis] += layout.positive ? 1 : -1;
+            cell[layout.vAxis] += dv;
+            uint32_t row = m_occluderRows[OccluderRowIndex(cell[1], cell[2])];
+            ring |= static_cast<int>((row >> x) & 7u) << ((dv + 1) * 3);
+        }
+    } else {
+        // LEFT / RIGHT: the ring lies in a Y-Z plane, one bit per occluder row
+        int sampleX = x + (layout.positive ? 1 : -1);
+        for (int dv = -1; dv <= 1; ++dv) {
+            for (int du = -1; du <= 1; ++du) {
+                uint32_t row = m_occluderRows[OccluderRowIndex(localY + dv, z + du)];
+                ring |= static_cast<int>((row >> (sampleX + 1)) & 1u) << ((dv + 1) * 3 + du + 1);
+            }
+        }
+    }
+    
+    uint32_t packed = AO_RING_LEVELS[ring];
+    for (int corner = 0; corner < 4; ++corner) {
+        aoLevels[corner] = static_cast<uint8_t>(packed >> (corner * 8));
+    }
+}
@@ -0,0 +1,191 @@
+#include "ChunkSection.h"
+#include <array>
+
+ChunkSection::ChunkSection() : ChunkSection(BlockType::AIR) {
+}
+
+ChunkSection::ChunkSection(BlockType fillType)
+    : m_bitsPerEntry(0), m_entriesPerWordShift(0), m_bitShift(0), m_nonAirCount(0) {
+    Fill(fillType);
+}
+
+BlockType ChunkSection::GetByIndex(int index) const {
+    if (m_bitsPerEntry == 0) {
+        return m_palette[0];
+    }
+    return m_palette[GetPaletteIndex(index)];
+}
+
+void ChunkSection::SetByIndex(int index, BlockType type) {
+    if (m_bitsPerEntry == 0 && m_palette[0] == type) {
+        return; // Uniform section already holds this type
+    }
+    if (m_bitsPerEntry == 0) {
+        // Leaving the single-entry state: materialise the occupancy bits the uniform type implied
+        m_occupancy.assign(SECTION_VOLUME / 64, m_palette[0] != BlockType::AIR ? ~uint64_t(0) : 0);
+    }
+
+    uint32_t newIndex = FindOrAddPaletteEntry(type);
+    uint32_t oldIndex = GetPaletteIndex(index);
+    if (oldIndex == newIndex) {
+        return;
+    }
+
+    SetPaletteIndex(index, newIndex);
+    --m_paletteCounts[oldIndex];
+    ++m_paletteCounts[newIndex];
+    
+    if (m_palette[oldIndex] == BlockType::AIR) {
+        ++m_nonAirCount;
+        m_occupancy[index >> 6] |= uint64_t(1) << (index & 63);
+    } else if (type == BlockType::AIR) {
+        --m_nonAirCount;
+        m_occupancy[index >> 6] &= ~(uint64_t(1) << (index & 63));
+    }
+
+    // Collapse back to a single entry once one type covers the whole section
+    if (m_paletteCounts[newIndex] == SECTION_VOLUME) {
+        Fill(type);
+    }
+}
+
+void ChunkSection::Fill(BlockType type) {
+    m_palette.assign(1, type);
+    m_paletteCounts.assign(1, static_cast<uint16_t>(SECTION_VOLUME));
+    m_data.clear();
+    m_data.shrink_to_fit();
+    m_bitsPerEntry = 0;
+    m_entriesPerWordShift = 0;
+    m_bitShift = 0;
+    m_nonAirCount = (type == BlockType::AIR) ? 0 : SECTION_VOLUME;
+    m_occupancy.clear();
+    m_occupancy.shrink_to_fit();
+}
+
+void ChunkSection::Compact() {
+    if (m_bitsPerEntry == 0) {
+        return;
+    }
+
+    // Build a remap table from old palette indices to the surviving entries
+    std::vector<uint32_t> remap(m_palette.size(), 0);
+    std::vector<BlockType> newPalette;
+    std::vector<uint16_t> newCounts;
+    for (size_t i = 0; i < m_palette.size(); ++i) {
+        if (m_paletteCounts[i] > 0) {
+            remap[i] = static_cast<uint32_t>(newPalette.size());
+            newPalette.push_back(m_palette[i]);
+            newCounts.push_back(m_paletteCounts[i]);
+        }
+    }
+
+    if (newPalette.size() == 1) {
+        Fill(newPalette[0]);
+        return;
+    }
+    if (newPalette.size() == m_palette.size()) {
+        return; // Nothing to drop
+    }
+
+    // Decode with the old layout, then re-encode with the (possibly narrower) new one
+    std::array<uint16_t, SECTION_VOLUME> indices;
+    for (int i = 0; i < SECTION_VOLUME; ++i) {
+        indices[i] = static_cast<uint16_t>(remap[GetPaletteIndex(i)]);
+    }
+
+    m_palette = std::move(newPalette);
+    m_paletteCounts = std::move(newCounts);
+    Repack(BitsForPaletteSize(m_palette.size()));
+    for (int i = 0; i < SECTION_VOLUME; ++i) {
+        SetPaletteIndex(i, indices[i]);
+    }
+}
+
+size_t ChunkSection::GetMemoryUsage() const {
+    return sizeof(ChunkSection) +
+           m_palette.capacity() * sizeof(BlockType) +
+           m_paletteCounts.capacity() * sizeof(uint16_t) +
+           m_data.capacity() * sizeof(uint64_t) +
+           m_occupancy.capacity() * sizeof(uint64_t);
+}
+
+uint32_t ChunkSection::GetPaletteIndex(int index) const {
+    if (m_bitsPerEntry == 0) {
+        return 0;
+    }
+    const uint64_t word = m_data[index >> m_entriesPerWordShift];
+    const int shift = (index & ((1 << m_entriesPerWordShift) - 1)) << m_bitShift;
+    const uint64_t mask = (uint64_t(1) << m_bitsPerEntry) - 1;
+    return static_cast<uint32_t>((word >> shift) & mask);
+}
+
+void ChunkSection::SetPaletteIndex(int index, uint32_t paletteIndex) {
+    uint64_t& word = m_data[index >> m_entriesPerWordShift];
+    const int shift = (index & ((1 << m_entriesPerWordShift) - 1)) << m_bitShift;
+    const uint64_t mask = ((uint64_t(1) << m_bitsPerEntry) - 1) << shift;
+    word = (word & ~mask) | ((uint64_t(paletteIndex) << shift) & mask);
+}
+
+uint32_t ChunkSection::FindOrAddPaletteEntry(BlockType type) {
+    // Palettes are small, so a linear search beats any map here
+    int freeSlot = -1;
+    for (size_t i = 0; i < m_palette.size(); ++i) {
+        if (m_palette[i] == type) {
+            return static_cast<uint32_t>(i);
+        }
+        if (freeSlot < 0 && m_paletteCounts[i] == 0) {
+            freeSlot = static_cast<int>(i);
+        }
+    }
+
+    // Reuse an entry whose last cell was overwritten before growing the palette
+    if (freeSlot >= 0) {
+        m_palette[freeSlot] = type;
+        return static_cast<uint32_t>(freeSlot);
+    }
+
+    m_palette.push_back(type);
+    m_paletteCounts.push_back(0);
+
+    int requiredBits = BitsForPaletteSize(m_palette.size());
+    if (requiredBits > m_bitsPerEntry) {
+        Repack(requiredBits);
+    }
+    return static_cast<uint32_t>(m_palette.size() - 1);
+}
+
+void ChunkSection::Repack(int newBitsPerEntry) {
+    std::vector<uint64_t> oldData;
+    oldData.swap(m_data);
+    const int oldBits = m_bitsPerEntry;
+    const int oldEntriesShift = m_entriesPerWordShift;
+    const int oldBitShift = m_bitShift;
+
+    m_bitsPerEntry = newBitsPerEntry;
+    m_bitShift = 0;
+    while ((1 << m_bitShift) < newBitsPerEntry) {
+        ++m_bitShift;
+    }
+    m_entriesPerWordShift = 6 - m_bitShift; // 64 bits per word
+    m_data.assign(SECTION_VOLUME >> m_entriesPerWordShift, 0);
+
+    if (oldBits == 0) {
+        return; // Every cell referenced palette entry 0, which is what zeroed data encodes
+    }
+
+    const uint64_t oldMask = (uint64_t(1) << oldBits) - 1;
+    for (int i = 0; i < SECTION_VOLUME; ++i) {
+        const uint64_t word = oldData[i >> oldEntriesShift];
+        const int shift = (i & ((1 << oldEntriesShift) - 1)) << oldBitShift;
+        SetPaletteIndex(i, static_cast<uint32_t>((word >> shift) & oldMask));
+    }
+}
+
+int ChunkSection::BitsForPaletteSize(size_t paletteSize) {
+    if (paletteSize <= 1) return 0;
+    if (paletteSize <= 2) return 1;
+    if (paletteSize <= 4) return 2;
+    if (paletteSize <= 16) return 4;
+    if (paletteSize <= 256) return 8;
+    return 16;
+}
@@ -0,0 +1,53 @@
+#include "ChunkVertex.h"
+#include "GpuProfiler.h"
+#include <vector>
+
+GLuint QuadIndexBuffer::s_buffer = 0;
+size_t QuadIndexBuffer::s_quadCapacity = 0;
+
+GLuint QuadIndexBuffer::Acquire(size_t quadCount) {
+    if (s_buffer != 0 && quadCount <= s_quadCapacity) {
+        return s_buffer;
+    }
+
+    // Grow geometrically so chunk rebuilds rarely reallocate
+    size_t newCapacity = s_quadCapacity > 0 ? s_quadCapacity : 4096;
+    while (newCapacity < quadCount) {
+        newCapacity *= 2;
+    }
+
+    std::vector<uint32_t> indices(newCapacity * INDICES_PER_QUAD);
+    for (size_t quad = 0; quad < newCapacity; ++quad) {
+        uint32_t base = static_cast<uint32_t>(quad * VERTICES_PER_QUAD);
+        uint32_t* out = &indices[quad * INDICES_PER_QUAD];
+        out[0] = base + 0;
+        out[1] = base + 1;
+        out[2] = base + 2;
+        out[3] = base + 2;
+        out[4] = base + 3;
+        out[5] = base + 0;
+    }
+
+    if (s_buffer == 0) {
+        glGenBuffers(1, &s_buffer);
+    }
+
+    // Bound through GL_ARRAY_BUFFER so the currently bound VAO's element binding is left untouched
+    GLint previousArrayBuffer = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousArrayBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, s_buffer);
+    glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(previousArrayBuffer));
+    GpuProfiler::CountUpload(indices.size() * sizeof(uint32_t));
+
+    s_quadCapacity = newCapacity;
+    return s_buffer;
+}
+
+void QuadIndexBuffer::Release() {
+    if (s_buffer != 0) {
+        glDeleteBuffers(1, &s_buffer);
+        s_buffer = 0;
+    }
+    s_quadCapacity = 0;
+}
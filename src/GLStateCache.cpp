@@ -0,0 +1,108 @@
+#include "GLStateCache.h"
+
+// Defaults of a new context: nothing bound, unit 0 active, all three capabilities off
+GLuint GLStateCache::s_program = 0;
+GLuint GLStateCache::s_vertexArray = 0;
+GLenum GLStateCache::s_activeTexture = GL_TEXTURE0;
+GLuint GLStateCache::s_textures[GLStateCache::TRACKED_TEXTURE_UNITS][GLStateCache::TRACKED_TARGET_COUNT] = {};
+int GLStateCache::s_capabilities[GLStateCache::TRACKED_CAPABILITY_COUNT] = {};
+GLenum GLStateCache::s_blendSource = GL_ONE;
+GLenum GLStateCache::s_blendDestination = GL_ZERO;
+int GLStateCache::s_depthMask = 1;
+GLStateCache::Stats GLStateCache::s_stats;
+
+void GLStateCache::UseProgram(GLuint program) {
+    if (Update(s_program, program)) {
+        glUseProgram(program);
+    }
+}
+
+void GLStateCache::BindVertexArray(GLuint vao) {
+    if (Update(s_vertexArray, vao)) {
+        glBindVertexArray(vao);
+    }
+}
+
+void GLStateCache::ActiveTexture(GLenum unit) {
+    if (Update(s_activeTexture, unit)) {
+        glActiveTexture(unit);
+    }
+}
+
+void GLStateCache::BindTexture(GLenum target, GLuint texture) {
+    int unit = s_activeTexture == UNKNOWN_NAME ? -1 : static_cast<int>(s_activeTexture - GL_TEXTURE0);
+    int targetIndex = TextureTargetIndex(target);
+    if (unit < 0 || unit >= TRACKED_TEXTURE_UNITS || targetIndex < 0) {
+        ++s_stats.issued;
+        glBindTexture(target, texture);
+        return;
+    }
+    if (Update(s_textures[unit][targetIndex], texture)) {
+        glBindTexture(target, texture);
+    }
+}
+
+void GLStateCache::SetEnabled(GLenum capability, bool enabled) {
+    int index = CapabilityIndex(capability);
+    if (index < 0) {
+        ++s_stats.issued;
+    } else if (!Update(s_capabilities[index], enabled ? 1 : 0)) {
+        return;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+void GLStateCache::BlendFunc(GLenum sourceFactor, GLenum destinationFactor) {
+    if (s_blendSource == sourceFactor && s_blendDestination == destinationFactor) {
+        ++s_stats.skipped;
+        return;
+    }
+    s_blendSource = sourceFactor;
+    s_blendDestination = destinationFactor;
+    ++s_stats.issued;
+    glBlendFunc(sourceFactor, destinationFactor);
+}
+
+void GLStateCache::DepthMask(bool writeDepth) {
+    if (Update(s_depthMask, writeDepth ? 1 : 0)) {
+        glDepthMask(writeDepth ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void GLStateCache::Invalidate() {
+    s_program = UNKNOWN_NAME;
+    s_vertexArray = UNKNOWN_NAME;
+    s_activeTexture = UNKNOWN_NAME;
+    for (auto& unitTextures : s_textures) {
+        for (GLuint& texture : unitTextures) {
+            texture = UNKNOWN_NAME;
+        }
+    }
+    for (int& capability : s_capabilities) {
+        capability = UNKNOWN_FLAG;
+    }
+    s_blendSource = UNKNOWN_NAME;
+    s_blendDestination = UNKNOWN_NAME;
+    s_depthMask = UNKNOWN_FLAG;
+}
+
+int GLStateCache::TextureTargetIndex(GLenum target) {
+    switch (target) {
+        case GL_TEXTURE_2D: return TRACKED_TEXTURE_2D;
+        case GL_TEXTURE_2D_ARRAY: return TRACKED_TEXTURE_2D_ARRAY;
+        default: return -1;
+    }
+}
+
+int GLStateCache::CapabilityIndex(GLenum capability) {
+    switch (capability) {
+        case GL_DEPTH_TEST: return TRACKED_DEPTH_TEST;
+        case GL_BLEND: return TRACKED_BLEND;
+        case GL_CULL_FACE: return TRACKED_CULL_FACE;
+        default: return -1;
+    }
+}
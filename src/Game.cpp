@@ -1,6 +1,7 @@
 #include "Game.h"
 #include "Debug.h"
 #include "Block.h"
+#include "GpuProfiler.h"
 #include <iostream>
 #include <ctime>
 #include <cstring>
@@ -61,7 +62,8 @@ Game::Game() :
     m_selectedHotbarSlot(0),
     m_placementPreviewPosition(0, 0, 0),
     m_showPlacementPreview(false),
-    m_showUI(true)
+    m_showUI(true),
+    m_showPerformanceWindow(false)
 {
     s_instance = this;
 }
@@ -212,6 +214,7 @@ void Game::Run() {
         }
 
         // Render
+        GpuProfiler::BeginFrame();
         m_renderer.Clear();
         
         switch (m_currentState) {
@@ -223,9 +226,25 @@ void Game::Run() {
                 break;
         }
 
+        if (m_showPerformanceWindow) {
+            RenderPerformanceWindow();
+        }
+
         // Render ImGui
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        ImDrawData* drawData = ImGui::GetDrawData();
+        GpuProfiler::BeginPass(GpuProfiler::PASS_IMGUI);
+        ImGui_ImplOpenGL3_RenderDrawData(drawData);
+        GpuProfiler::EndPass(GpuProfiler::PASS_IMGUI);
+        
+        // The backend uploads every draw list each frame and issues one draw per command
+        int imguiDraws = 0;
+        for (int i = 0; i < drawData->CmdListsCount; ++i) {
+            imguiDraws += drawData->CmdLists[i]->CmdBuffer.Size;
+        }
+        GpuProfiler::CountDraws(imguiDraws, drawData->TotalVtxCount);
+        GpuProfiler::CountUpload(static_cast<size_t>(drawData->TotalVtxCount) * sizeof(ImDrawVert) +
+                                 static_cast<size_t>(drawData->TotalIdxCount) * sizeof(ImDrawIdx));
 
         glfwSwapBuffers(m_window);
     }
@@ -566,7 +585,7 @@ void Game::UpdateGame() {
             // Apply block break to client world (if we have one)
             if (m_world) {
                 // Use the unified mesh update method for consistency
-                m_world->SetBlockWithMeshUpdate(x, y, z, BlockType::AIR, &(m_renderer.m_blockManager));
+                m_world->SetBlockWithMeshUpdate(x, y, z, BlockType::AIR);
             }
             m_pendingBlockBreaks.pop();
         }
@@ -582,7 +601,7 @@ void Game::UpdateGame() {
             if (m_world) {
                 try {
                     // Use efficient mesh update method
-                    m_world->SetBlockWithMeshUpdate(update.x, update.y, update.z, static_cast<BlockType>(update.blockType), &(m_renderer.m_blockManager));
+                    m_world->SetBlockWithMeshUpdate(update.x, update.y, update.z, static_cast<BlockType>(update.blockType));
                 } catch (const std::exception& e) {
                     std::cerr << "[CLIENT] Error processing block update: " << e.what() << std::endl;
                 }
@@ -609,10 +628,11 @@ void Game::UpdateGame() {
                 Chunk* chunk = m_world->GetChunk(chunkX, chunkZ);
                 if (chunk) {
                     // Apply server data to the chunk
-                    chunk->ApplyServerData(blockData.data());
+                    chunk->ApplyServerData(blockData.data(), chunkInfo.biomeMap, &(m_renderer.m_blockManager));
                     
-                    // Generate mesh for the updated chunk
-                    chunk->GenerateMesh(m_world.get(), &(m_renderer.m_blockManager));
+                    // Queue meshes for the updated chunk and the neighbours whose borders it changed;
+                    // they are built on the mesh workers and uploaded by ProcessMeshQueue
+                    m_world->RequestChunkMeshWithNeighbors(chunkX, chunkZ);
                     
                     std::cout << "[CLIENT] Updated chunk (" << chunkX << ", " << chunkZ << ") with server data" << std::endl;
                     
@@ -632,6 +652,11 @@ void Game::UpdateGame() {
             m_pendingChunkData.pop();
         }
     }
+    
+    // Start queued chunk meshes and upload finished ones within this frame's budget
+    if (m_world) {
+        m_world->ProcessMeshQueue(&(m_renderer.m_blockManager));
+    }
 }
 
 void Game::RenderMainMenu() {
@@ -747,11 +772,11 @@ void Game::RenderMainMenu() {
 void Game::RenderGame() {
     // 3D world rendering
     if (m_world && m_player) {
-        m_renderer.BeginFrame(*m_player);
+        m_renderer.BeginFrame(*m_player, m_gameTime);
         
         // Render sky first (background)
         if (m_gameTimeReceived) {
-            m_renderer.RenderSky(m_gameTime);
+            m_renderer.RenderSky();
         } else {
             static bool debugOnce = false;
             if (!debugOnce) {
@@ -760,7 +785,7 @@ void Game::RenderGame() {
             }
         }
         
-        m_renderer.RenderWorld(*m_world, m_gameTime);
+        m_renderer.RenderWorld(*m_world);
         
         // Render wireframe around target block
         if (m_targetBlock.hit) {
@@ -825,7 +850,7 @@ void Game::RenderGame() {
     // Show game UI
     if (m_showUI) {
         ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
-        ImGui::SetNextWindowSize(ImVec2(400, 250), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(400, 430), ImGuiCond_Always);
         
         if (ImGui::Begin("Minecraft Clone", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse)) {
         // Use large font for the header
@@ -860,6 +885,48 @@ void Game::RenderGame() {
         
         ImGui::Separator();
         
+        // Mesh statistics, used to compare the per-face and greedy meshers
+        if (m_world) {
+            ImGui::Text("Frame Time: %.2f ms (%.0f FPS)", m_deltaTime * 1000.0f, m_deltaTime > 0.0f ? 1.0f / m_deltaTime : 0.0f);
+            size_t totalVertices = m_world->GetTotalVertexCount();
+            ImGui::Text("Mesh Vertices: %zu (%.0f per chunk, %zu KB)", totalVertices,
+                        static_cast<double>(totalVertices) / (WORLD_SIZE * WORLD_SIZE),
+                        totalVertices * sizeof(ChunkVertex) / 1024);
+            if (m_player) {
+                Vec3 pos = m_player->GetPosition();
+                int chunkX = static_cast<int>(std::floor(pos.x / CHUNK_WIDTH));
+                int chunkZ = static_cast<int>(std::floor(pos.z / CHUNK_DEPTH));
+                if (const Chunk* chunk = m_world->GetChunk(chunkX, chunkZ)) {
+                    ImGui::Text("Current Chunk (%d, %d): %d vertices", chunkX, chunkZ, chunk->GetVertexCount());
+                }
+            }
+            ImGui::Text("Pending Chunk Meshes: %zu", m_world->GetPendingMeshCount());
+            ImGui::Text("Chunk Draws: %d submissions, %d ranges (%s)", m_renderer.GetChunkDrawSubmissions(),
+                        m_renderer.GetChunkDrawCommands(),
+                        ChunkMeshPool::SupportsIndirectDraw() ? "multi-draw indirect" : "multi-draw");
+            ImGui::Text("Sections: %d tested, %d culled (%d occluded), %d drawn", m_renderer.GetSectionsTested(),
+                        m_renderer.GetSectionsCulled(), m_renderer.GetSectionsOccluded(), m_renderer.GetSectionsDrawn());
+            const GpuProfiler::FrameStats& frameStats = GpuProfiler::GetLastFrame();
+            ImGui::Text("GL State Calls: %d issued, %d redundant skipped", frameStats.stateCalls, frameStats.stateCallsSkipped);
+            ImGui::Text("GPU Time: %.2f ms (F3 for details)", frameStats.GetGpuTotalMs());
+            ImGui::Checkbox("Frustum Culling (F1)", &m_renderer.m_enableFrustumCulling);
+            ImGui::SameLine();
+            ImGui::Checkbox("Cave Culling", &m_renderer.m_enableCaveCulling);
+            size_t meshAllocated = m_renderer.GetChunkMeshAllocatedBytes();
+            size_t meshReserved = m_renderer.GetChunkMeshReservedBytes();
+            ImGui::Text("Mesh GPU Memory: %.1f MB in %d pages, %.1f MB reserved (%.0f%%)",
+                        meshAllocated / (1024.0 * 1024.0), m_renderer.GetChunkMeshPageCount(), meshReserved / (1024.0 * 1024.0),
+                        meshAllocated > 0 ? 100.0 * meshReserved / meshAllocated : 0.0);
+            
+            bool greedy = Chunk::GetMeshingMode() == Chunk::MeshingMode::GREEDY;
+            if (ImGui::Checkbox("Greedy Meshing", &greedy)) {
+                Chunk::SetMeshingMode(greedy ? Chunk::MeshingMode::GREEDY : Chunk::MeshingMode::PER_FACE);
+                m_world->RequestAllChunkMeshes();
+            }
+            
+            ImGui::Separator();
+        }
+        
         // Show time information
         if (m_gameTimeReceived) {
             ImGui::Text("Game Time: %.1f seconds", m_gameTime);
@@ -1527,6 +1594,11 @@ void Game::KeyCallback(GLFWwindow* window, int key, int scancode, int action, in
             }
         }
         
+        // Toggle the performance window with F3
+        if (key == GLFW_KEY_F3 && action == GLFW_PRESS) {
+            s_instance->m_showPerformanceWindow = !s_instance->m_showPerformanceWindow;
+        }
+        
         // Toggle UI visibility with ] key
         if (key == GLFW_KEY_RIGHT_BRACKET && action == GLFW_PRESS) {
             if (s_instance->m_currentState == GameState::GAME) {
@@ -1626,7 +1698,7 @@ void Game::MouseButtonCallback(GLFWwindow* window, int button, int action, int m
                 std::cout << "Breaking block at (" << blockX << ", " << blockY << ", " << blockZ << ")" << std::endl;
                 
                 // Break the block immediately on client (client prediction) with efficient mesh update
-                s_instance->m_world->SetBlockWithMeshUpdate(blockX, blockY, blockZ, BlockType::AIR, &(s_instance->m_renderer.m_blockManager));
+                s_instance->m_world->SetBlockWithMeshUpdate(blockX, blockY, blockZ, BlockType::AIR);
                 
                 // Send to server for synchronization with other clients using the new streaming system
                 if (s_instance->m_networkClient && s_instance->m_networkClient->IsConnected()) {
@@ -1663,7 +1735,7 @@ void Game::MouseButtonCallback(GLFWwindow* window, int button, int action, int m
                         std::cout << "Placing " << itemKey << " block at (" << placeX << ", " << placeY << ", " << placeZ << ")" << std::endl;
                         
                         // Place the block in the world with efficient mesh update
-                        s_instance->m_world->SetBlockWithMeshUpdate(placeX, placeY, placeZ, blockTypeToPlace, &(s_instance->m_renderer.m_blockManager));
+                        s_instance->m_world->SetBlockWithMeshUpdate(placeX, placeY, placeZ, blockTypeToPlace);
                         
                         // Remove one item from inventory
                         s_instance->m_player->GetInventory().getHotbarSlot(s_instance->m_selectedHotbarSlot).removeItems(1);
@@ -1814,9 +1886,9 @@ void Game::StartHost() {
             }
         });
         
-        m_networkClient->SetChunkDataCallback([this](int32_t chunkX, int32_t chunkZ, const uint16_t* blockData) {
+        m_networkClient->SetChunkDataCallback([this](int32_t chunkX, int32_t chunkZ, const uint16_t* blockData, const ChunkBiomeMap& biomeMap) {
             try {
-                OnChunkDataReceived(chunkX, chunkZ, blockData);
+                OnChunkDataReceived(chunkX, chunkZ, blockData, biomeMap);
             } catch (const std::exception& e) {
                 std::cerr << "ERROR in OnChunkDataReceived: " << e.what() << std::endl;
             }
@@ -1926,9 +1998,9 @@ void Game::JoinServer(const std::string& serverIP) {
             }
         });
         
-        m_networkClient->SetChunkDataCallback([this](int32_t chunkX, int32_t chunkZ, const uint16_t* blockData) {
+        m_networkClient->SetChunkDataCallback([this](int32_t chunkX, int32_t chunkZ, const uint16_t* blockData, const ChunkBiomeMap& biomeMap) {
             try {
-                OnChunkDataReceived(chunkX, chunkZ, blockData);
+                OnChunkDataReceived(chunkX, chunkZ, blockData, biomeMap);
             } catch (const std::exception& e) {
                 std::cerr << "ERROR in OnChunkDataReceived: " << e.what() << std::endl;
             }
@@ -2156,7 +2228,7 @@ void Game::OnBlockBreakReceived(uint32_t playerId, int32_t x, int32_t y, int32_t
     if (m_world) {
         try {
             // Use efficient mesh update method
-            m_world->SetBlockWithMeshUpdate(x, y, z, BlockType::AIR, &(m_renderer.m_blockManager));
+            m_world->SetBlockWithMeshUpdate(x, y, z, BlockType::AIR);
             std::cout << "[CLIENT] Applied block break at (" << x << ", " << y << ", " << z << ") with incremental mesh update" << std::endl;
         } catch (const std::exception& e) {
             std::cerr << "[CLIENT] Error processing block break: " << e.what() << std::endl;
@@ -2180,7 +2252,7 @@ void Game::OnBlockUpdateReceived(uint32_t playerId, int32_t x, int32_t y, int32_
     }
 }
 
-void Game::OnChunkDataReceived(int32_t chunkX, int32_t chunkZ, const uint16_t* blockData) {
+void Game::OnChunkDataReceived(int32_t chunkX, int32_t chunkZ, const uint16_t* blockData, const ChunkBiomeMap& biomeMap) {
     std::cout << "[CLIENT] Queuing chunk data for (" << chunkX << ", " << chunkZ << ")" << std::endl;
     
     // Queue the chunk data for processing on the main thread
@@ -2192,6 +2264,7 @@ void Game::OnChunkDataReceived(int32_t chunkX, int32_t chunkZ, const uint16_t* b
         chunkData.chunkZ = chunkZ;
         // Copy the block data (16x256x16 = 65536 bytes)
         chunkData.blockData.assign(blockData, blockData + (16 * 256 * 16));
+        chunkData.biomeMap = biomeMap;
         m_pendingChunkData.push(std::move(chunkData));
     }
 }
@@ -2269,6 +2342,86 @@ void Game::RenderHotbar() {
     RenderCursorItem();
 }
 
+void Game::RenderPerformanceWindow() {
+    ImGui::SetNextWindowPos(ImVec2(420, 10), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(430, 420), ImGuiCond_FirstUseEver);
+    
+    if (ImGui::Begin("Performance (F3)", &m_showPerformanceWindow)) {
+        const std::deque<GpuProfiler::FrameStats>& history = GpuProfiler::GetHistory();
+        const GpuProfiler::FrameStats& last = GpuProfiler::GetLastFrame();
+        
+        ImGui::Text("Frame %llu: CPU %.2f ms, GPU %.2f ms", static_cast<unsigned long long>(last.frame), last.cpuFrameMs,
+                    last.GetGpuTotalMs());
+        
+        // GPU time per frame across the history
+        std::vector<float> gpuTotals;
+        gpuTotals.reserve(history.size());
+        for (const GpuProfiler::FrameStats& stats : history) {
+            gpuTotals.push_back(stats.GetGpuTotalMs());
+        }
+        if (!gpuTotals.empty()) {
+            ImGui::PlotLines("##gpu", gpuTotals.data(), static_cast<int>(gpuTotals.size()), 0, "GPU ms", 0.0f, FLT_MAX,
+                             ImVec2(-1, 60));
+        }
+        
+        // Last, average and worst GPU time of each pass over the history; untimed frames are left out
+        if (ImGui::BeginTable("passes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Pass");
+            ImGui::TableSetupColumn("Last ms");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("Max ms");
+            ImGui::TableHeadersRow();
+            for (int pass = 0; pass < GpuProfiler::PASS_COUNT; ++pass) {
+                float total = 0.0f;
+                float worst = 0.0f;
+                int timed = 0;
+                for (const GpuProfiler::FrameStats& stats : history) {
+                    if (stats.passTimed[pass]) {
+                        total += stats.passMs[pass];
+                        worst = std::max(worst, stats.passMs[pass]);
+                        ++timed;
+                    }
+                }
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GpuProfiler::GetPassName(static_cast<GpuProfiler::Pass>(pass)));
+                ImGui::TableNextColumn();
+                if (last.passTimed[pass]) {
+                    ImGui::Text("%.3f", last.passMs[pass]);
+                } else {
+                    ImGui::TextDisabled("-");
+                }
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", timed > 0 ? total / timed : 0.0f);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", worst);
+            }
+            ImGui::EndTable();
+        }
+        
+        ImGui::Separator();
+        ImGui::Text("Draw Calls: %d", last.drawCalls);
+        ImGui::Text("Vertices: %lld", static_cast<long long>(last.vertices));
+        ImGui::Text("GL State Calls: %d issued, %d redundant skipped", last.stateCalls, last.stateCallsSkipped);
+        ImGui::Text("Buffer Uploads: %.1f KB", last.uploadBytes / 1024.0);
+        
+        ImGui::Separator();
+        if (ImGui::Button("Export CSV")) {
+            std::string filepath = "gpu_profile_" + std::to_string(static_cast<long long>(std::time(nullptr))) + ".csv";
+            if (GpuProfiler::ExportCSV(filepath)) {
+                m_profileExportMessage = "Wrote " + std::to_string(history.size()) + " frames to " + filepath;
+            } else {
+                m_profileExportMessage = "Failed to write " + filepath;
+            }
+        }
+        if (!m_profileExportMessage.empty()) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(m_profileExportMessage.c_str());
+        }
+    }
+    ImGui::End();
+}
+
 
 Vec3 Game::CalculateSpawnPosition() const {
     if (!m_world) {
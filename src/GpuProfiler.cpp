@@ -0,0 +1,185 @@
+#include "GpuProfiler.h"
+#include "GLStateCache.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+GpuProfiler::QueryFrame GpuProfiler::s_queryFrames[GpuProfiler::QUERY_FRAMES];
+int GpuProfiler::s_currentQueryFrame = 0;
+int GpuProfiler::s_activePass = -1;
+bool GpuProfiler::s_initialized = false;
+GpuProfiler::FrameStats GpuProfiler::s_current;
+GpuProfiler::FrameStats GpuProfiler::s_lastFrame;
+std::deque<GpuProfiler::FrameStats> GpuProfiler::s_history;
+std::chrono::steady_clock::time_point GpuProfiler::s_frameStart;
+
+float GpuProfiler::FrameStats::GetGpuTotalMs() const {
+    float total = 0.0f;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        if (passTimed[pass]) {
+            total += passMs[pass];
+        }
+    }
+    return total;
+}
+
+bool GpuProfiler::Initialize() {
+    if (s_initialized) {
+        return true;
+    }
+    // Timer queries are core since OpenGL 3.3, the version the game requests
+    for (QueryFrame& queryFrame : s_queryFrames) {
+        glGenQueries(PASS_COUNT, queryFrame.queries);
+        std::fill(std::begin(queryFrame.issued), std::end(queryFrame.issued), false);
+        queryFrame.recorded = false;
+    }
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "[PROFILER] Failed to create GPU timer queries; only counters will be recorded" << std::endl;
+        Shutdown();
+        return false;
+    }
+    s_initialized = true;
+    return true;
+}
+
+void GpuProfiler::Shutdown() {
+    if (s_activePass >= 0) {
+        glEndQuery(GL_TIME_ELAPSED);
+        s_activePass = -1;
+    }
+    for (QueryFrame& queryFrame : s_queryFrames) {
+        glDeleteQueries(PASS_COUNT, queryFrame.queries);
+        queryFrame = QueryFrame();
+    }
+    s_initialized = false;
+}
+
+void GpuProfiler::BeginFrame() {
+    auto now = std::chrono::steady_clock::now();
+
+    // Close the frame that just ended; its counters wait with its queries until the results are in
+    if (s_current.frame != 0) {
+        if (s_activePass >= 0) {
+            std::cerr << "[PROFILER] Pass " << GetPassName(static_cast<Pass>(s_activePass)) << " was never ended" << std::endl;
+            glEndQuery(GL_TIME_ELAPSED);
+            s_activePass = -1;
+        }
+        s_current.cpuFrameMs = std::chrono::duration<float, std::milli>(now - s_frameStart).count();
+        s_current.stateCalls = GLStateCache::GetStats().issued;
+        s_current.stateCallsSkipped = GLStateCache::GetStats().skipped;
+        QueryFrame& finished = s_queryFrames[s_currentQueryFrame];
+        finished.stats = s_current;
+        finished.recorded = true;
+    }
+    GLStateCache::ResetStats();
+
+    // The slot about to be reused holds the oldest frame, issued QUERY_FRAMES - 1 frames ago. Results that
+    // are still not available are dropped rather than waited for
+    s_currentQueryFrame = (s_currentQueryFrame + 1) % QUERY_FRAMES;
+    QueryFrame& oldest = s_queryFrames[s_currentQueryFrame];
+    if (oldest.recorded) {
+        for (int pass = 0; pass < PASS_COUNT; ++pass) {
+            if (!oldest.issued[pass]) {
+                continue;
+            }
+            GLint available = 0;
+            glGetQueryObjectiv(oldest.queries[pass], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint64 elapsedNs = 0;
+                glGetQueryObjectui64v(oldest.queries[pass], GL_QUERY_RESULT, &elapsedNs);
+                oldest.stats.passMs[pass] = static_cast<float>(elapsedNs / 1.0e6);
+                oldest.stats.passTimed[pass] = true;
+            }
+        }
+        s_lastFrame = oldest.stats;
+        s_history.push_back(oldest.stats);
+        if (s_history.size() > HISTORY_FRAMES) {
+            s_history.pop_front();
+        }
+        oldest.recorded = false;
+    }
+    std::fill(std::begin(oldest.issued), std::end(oldest.issued), false);
+
+    uint64_t frame = s_current.frame + 1;
+    s_current = FrameStats();
+    s_current.frame = frame;
+    s_frameStart = now;
+}
+
+void GpuProfiler::BeginPass(Pass pass) {
+    QueryFrame& queryFrame = s_queryFrames[s_currentQueryFrame];
+    if (!s_initialized || s_activePass >= 0 || queryFrame.issued[pass]) {
+        return;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, queryFrame.queries[pass]);
+    queryFrame.issued[pass] = true;
+    s_activePass = pass;
+}
+
+void GpuProfiler::EndPass(Pass pass) {
+    if (s_activePass != pass) {
+        return; // Its BeginPass was ignored
+    }
+    glEndQuery(GL_TIME_ELAPSED);
+    s_activePass = -1;
+}
+
+void GpuProfiler::CountDraw(int64_t vertices, int instances) {
+    ++s_current.drawCalls;
+    s_current.vertices += vertices * instances;
+}
+
+void GpuProfiler::CountDraws(int drawCalls, int64_t vertices) {
+    s_current.drawCalls += drawCalls;
+    s_current.vertices += vertices;
+}
+
+void GpuProfiler::CountUpload(size_t bytes) {
+    s_current.uploadBytes += bytes;
+}
+
+bool GpuProfiler::ExportCSV(const std::string& filepath) {
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "[PROFILER] Failed to open " << filepath << " for writing" << std::endl;
+        return false;
+    }
+
+    file << "frame,cpu_frame_ms,gpu_total_ms";
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        file << ',' << GetPassName(static_cast<Pass>(pass)) << "_ms";
+    }
+    file << ",draw_calls,vertices,state_calls,state_calls_skipped,upload_bytes\n";
+
+    for (const FrameStats& stats : s_history) {
+        file << stats.frame << ',' << stats.cpuFrameMs << ',' << stats.GetGpuTotalMs();
+        for (int pass = 0; pass < PASS_COUNT; ++pass) {
+            file << ',';
+            if (stats.passTimed[pass]) {
+                file << stats.passMs[pass];
+            }
+        }
+        file << ',' << stats.drawCalls << ',' << stats.vertices << ',' << stats.stateCalls << ','
+             << stats.stateCallsSkipped << ',' << stats.uploadBytes << '\n';
+    }
+
+    if (!file) {
+        std::cerr << "[PROFILER] Failed to write " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const char* GpuProfiler::GetPassName(Pass pass) {
+    switch (pass) {
+        case PASS_SKY: return "sky";
+        case PASS_OPAQUE: return "opaque";
+        case PASS_CUTOUT: return "cutout";
+        case PASS_WATER: return "water";
+        case PASS_PLAYERS: return "players";
+        case PASS_ARM: return "arm";
+        case PASS_IMGUI: return "imgui";
+        default: return "unknown";
+    }
+}
@@ -479,7 +479,7 @@ void NetworkClient::SetBlockUpdateCallback(std::function<void(uint32_t, int32_t,
     m_onBlockUpdate = callback;
 }
 
-void NetworkClient::SetChunkDataCallback(std::function<void(int32_t, int32_t, const uint16_t*)> callback) {
+void NetworkClient::SetChunkDataCallback(std::function<void(int32_t, int32_t, const uint16_t*, const ChunkBiomeMap&)> callback) {
     m_onChunkData = callback;
 }
 
@@ -0,0 +1,338 @@
+#include "PerlinNoise.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define PERLIN_NOISE_SSE2 1
+    #endif
+    // The AVX2 kernel is compiled for AVX2 through a target attribute and only called after a CPU check
+    #if defined(__GNUC__) || defined(__clang__)
+        #define PERLIN_NOISE_AVX2 1
+    #endif
+#endif
+
+// Keep a * b + c as two rounded operations everywhere, like the SIMD kernels. CMakeLists.txt also
+// builds this file with -ffp-contract=off (/fp:precise on MSVC), which is what GCC honours
+#if defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#endif
+
+PerlinNoise::Kernel PerlinNoise::s_kernel = PerlinNoise::DetectKernel();
+
+namespace {
+
+// 6t^5 - 15t^4 + 10t^3; the kernels evaluate it in this exact order
+inline float Fade(float t) {
+    float t3 = t * t * t;
+    return t3 * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+inline float Lerp(float t, float a, float b) {
+    return a + t * (b - a);
+}
+
+// Eight gradients: bit 2 clear gives the diagonals (+-1, +-1) with bits 0 and 1 as the x and z signs;
+// bit 2 set gives the axes, bit 1 picking z over x and bit 0 the sign
+inline float Grad(int hash, float x, float z) {
+    if (hash & 4) {
+        float axis = (hash & 2) ? z : x;
+        return (hash & 1) ? -axis : axis;
+    }
+    return ((hash & 1) ? -x : x) + ((hash & 2) ? -z : z);
+}
+
+// The z half of a row's lattice lookup, shared by every column of the row and computed the same way
+// by every kernel
+struct RowLattice {
+    int zi;   // Lattice row, wrapped to the table
+    float zf; // Offset inside the cell
+    float v;  // Fade(zf)
+};
+
+inline RowLattice GetRowLattice(int worldZ, float frequency) {
+    float z = static_cast<float>(worldZ) * frequency;
+    float z0 = std::floor(z);
+    RowLattice lattice;
+    lattice.zi = static_cast<int>(z0) & 255;
+    lattice.zf = z - z0;
+    lattice.v = Fade(lattice.zf);
+    return lattice;
+}
+
+} // namespace
+
+PerlinNoise::PerlinNoise(int seed) {
+    // Fisher-Yates shuffle on raw mt19937 output, which unlike std::shuffle is the same on every standard library
+    std::mt19937 rng(static_cast<uint32_t>(seed));
+    std::array<int32_t, 256> table;
+    for (int i = 0; i < 256; ++i) {
+        table[i] = i;
+    }
+    for (int i = 255; i > 0; --i) {
+        int j = static_cast<int>(rng() % static_cast<uint32_t>(i + 1));
+        std::swap(table[i], table[j]);
+    }
+    for (int i = 0; i < 512; ++i) {
+        m_permutation[i] = table[i & 255];
+    }
+}
+
+float PerlinNoise::Sample(float x, float z) const {
+    float x0 = std::floor(x);
+    float z0 = std::floor(z);
+    int xi = static_cast<int>(x0) & 255;
+    int zi = static_cast<int>(z0) & 255;
+    float xf = x - x0;
+    float zf = z - z0;
+    float u = Fade(xf);
+    float v = Fade(zf);
+
+    int a = m_permutation[xi] + zi;
+    int b = m_permutation[xi + 1] + zi;
+    float n00 = Grad(m_permutation[a], xf, zf);
+    float n10 = Grad(m_permutation[b], xf - 1.0f, zf);
+    float n01 = Grad(m_permutation[a + 1], xf, zf - 1.0f);
+    float n11 = Grad(m_permutation[b + 1], xf - 1.0f, zf - 1.0f);
+    return Lerp(v, Lerp(u, n00, n10), Lerp(u, n01, n11));
+}
+
+void PerlinNoise::SampleRow(int worldX, int worldZ, float frequency, float* out) const {
+    SampleRowWith(s_kernel, worldX, worldZ, frequency, out);
+}
+
+void PerlinNoise::SampleRowWith(Kernel kernel, int worldX, int worldZ, float frequency, float* out) const {
+    switch (kernel) {
+        case Kernel::AVX2:
+            SampleRowAVX2(worldX, worldZ, frequency, out);
+            break;
+        case Kernel::SSE2:
+            SampleRowSSE2(worldX, worldZ, frequency, out);
+            break;
+        default:
+            SampleRowScalar(worldX, worldZ, frequency, out);
+            break;
+    }
+}
+
+void PerlinNoise::SampleGrid(int worldX, int worldZ, float frequency, float* out) const {
+    for (int z = 0; z < BATCH_WIDTH; ++z) {
+        SampleRow(worldX, worldZ + z, frequency, out + z * BATCH_WIDTH);
+    }
+}
+
+void PerlinNoise::SampleRowScalar(int worldX, int worldZ, float frequency, float* out) const {
+    for (int i = 0; i < BATCH_WIDTH; ++i) {
+        out[i] = SampleColumn(worldX + i, worldZ, frequency);
+    }
+}
+
+#ifdef PERLIN_NOISE_SSE2
+void PerlinNoise::SampleRowSSE2(int worldX, int worldZ, float frequency, float* out) const {
+    const RowLattice row = GetRowLattice(worldZ, frequency);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zf = _mm_set1_ps(row.zf);
+    const __m128 zf1 = _mm_set1_ps(row.zf - 1.0f);
+    const __m128 v = _mm_set1_ps(row.v);
+    const __m128i mask255 = _mm_set1_epi32(255);
+
+    auto fade = [](__m128 t) {
+        __m128 t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+        __m128 inner = _mm_add_ps(_mm_mul_ps(t, _mm_sub_ps(_mm_mul_ps(t, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f))), _mm_set1_ps(10.0f));
+        return _mm_mul_ps(t3, inner);
+    };
+    auto lerp = [](__m128 t, __m128 a, __m128 b) { return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a))); };
+    auto select = [](__m128i mask, __m128 whenSet, __m128 whenClear) {
+        __m128 maskF = _mm_castsi128_ps(mask);
+        return _mm_or_ps(_mm_and_ps(maskF, whenSet), _mm_andnot_ps(maskF, whenClear));
+    };
+    auto grad = [&select](__m128i hash, __m128 x, __m128 z) {
+        // Flipping the sign bit is the same exact negation the scalar Grad does
+        __m128 signX = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(hash, _mm_set1_epi32(1)), 31));
+        __m128 signZ = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(hash, _mm_set1_epi32(2)), 30));
+        __m128 diagonal = _mm_add_ps(_mm_xor_ps(x, signX), _mm_xor_ps(z, signZ));
+        __m128i useZ = _mm_cmpeq_epi32(_mm_and_si128(hash, _mm_set1_epi32(2)), _mm_set1_epi32(2));
+        __m128 axis = _mm_xor_ps(select(useZ, z, x), signX);
+        __m128i isAxis = _mm_cmpeq_epi32(_mm_and_si128(hash, _mm_set1_epi32(4)), _mm_set1_epi32(4));
+        return select(isAxis, axis, diagonal);
+    };
+
+    alignas(16) int32_t xIndex[4];
+    alignas(16) int32_t h00[4], h10[4], h01[4], h11[4];
+    for (int i = 0; i < BATCH_WIDTH; i += 4) {
+        __m128i column = _mm_add_epi32(_mm_set1_epi32(worldX + i), _mm_set_epi32(3, 2, 1, 0));
+        __m128 x = _mm_mul_ps(_mm_cvtepi32_ps(column), _mm_set1_ps(frequency));
+
+        // floor without SSE4.1: truncate, then step down where truncation rounded up
+        __m128 x0 = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+        x0 = _mm_sub_ps(x0, _mm_and_ps(_mm_cmpgt_ps(x0, x), one));
+        _mm_store_si128(reinterpret_cast<__m128i*>(xIndex), _mm_and_si128(_mm_cvttps_epi32(x0), mask255));
+
+        // SSE2 has no gather, so the table lookups are done per lane
+        for (int lane = 0; lane < 4; ++lane) {
+            int a = m_permutation[xIndex[lane]] + row.zi;
+            int b = m_permutation[xIndex[lane] + 1] + row.zi;
+            h00[lane] = m_permutation[a];
+            h10[lane] = m_permutation[b];
+            h01[lane] = m_permutation[a + 1];
+            h11[lane] = m_permutation[b + 1];
+        }
+
+        __m128 xf = _mm_sub_ps(x, x0);
+        __m128 xf1 = _mm_sub_ps(xf, one);
+        __m128 u = fade(xf);
+        __m128 n00 = grad(_mm_load_si128(reinterpret_cast<const __m128i*>(h00)), xf, zf);
+        __m128 n10 = grad(_mm_load_si128(reinterpret_cast<const __m128i*>(h10)), xf1, zf);
+        __m128 n01 = grad(_mm_load_si128(reinterpret_cast<const __m128i*>(h01)), xf, zf1);
+        __m128 n11 = grad(_mm_load_si128(reinterpret_cast<const __m128i*>(h11)), xf1, zf1);
+        _mm_storeu_ps(out + i, lerp(v, lerp(u, n00, n10), lerp(u, n01, n11)));
+    }
+}
+#else
+void PerlinNoise::SampleRowSSE2(int worldX, int worldZ, float frequency, float* out) const {
+    SampleRowScalar(worldX, worldZ, frequency, out);
+}
+#endif
+
+#ifdef PERLIN_NOISE_AVX2
+__attribute__((target("avx2")))
+void PerlinNoise::SampleRowAVX2(int worldX, int worldZ, float frequency, float* out) const {
+    const RowLattice row = GetRowLattice(worldZ, frequency);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 zf = _mm256_set1_ps(row.zf);
+    const __m256 zf1 = _mm256_set1_ps(row.zf - 1.0f);
+    const __m256 v = _mm256_set1_ps(row.v);
+    const __m256i zi = _mm256_set1_epi32(row.zi);
+    const __m256i oneInt = _mm256_set1_epi32(1);
+    const int* table = m_permutation.data();
+
+    for (int i = 0; i < BATCH_WIDTH; i += 8) {
+        __m256i column = _mm256_add_epi32(_mm256_set1_epi32(worldX + i), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        __m256 x = _mm256_mul_ps(_mm256_cvtepi32_ps(column), _mm256_set1_ps(frequency));
+        __m256 x0 = _mm256_floor_ps(x);
+        __m256i xi = _mm256_and_si256(_mm256_cvttps_epi32(x0), _mm256_set1_epi32(255));
+
+        __m256i a = _mm256_add_epi32(_mm256_i32gather_epi32(table, xi, 4), zi);
+        __m256i b = _mm256_add_epi32(_mm256_i32gather_epi32(table, _mm256_add_epi32(xi, oneInt), 4), zi);
+        __m256i h00 = _mm256_i32gather_epi32(table, a, 4);
+        __m256i h10 = _mm256_i32gather_epi32(table, b, 4);
+        __m256i h01 = _mm256_i32gather_epi32(table, _mm256_add_epi32(a, oneInt), 4);
+        __m256i h11 = _mm256_i32gather_epi32(table, _mm256_add_epi32(b, oneInt), 4);
+
+        __m256 xf = _mm256_sub_ps(x, x0);
+        __m256 xf1 = _mm256_sub_ps(xf, one);
+        __m256 t3 = _mm256_mul_ps(_mm256_mul_ps(xf, xf), xf);
+        __m256 u = _mm256_mul_ps(t3, _mm256_add_ps(_mm256_mul_ps(xf, _mm256_sub_ps(_mm256_mul_ps(xf, _mm256_set1_ps(6.0f)),
+                                                                                     _mm256_set1_ps(15.0f))),
+                                                   _mm256_set1_ps(10.0f)));
+
+        // Same gradient selection as the SSE2 kernel, with blends on the hash bits
+        __m256 corner[4];
+        const __m256i hashes[4] = {h00, h10, h01, h11};
+        const __m256 cornerX[4] = {xf, xf1, xf, xf1};
+        const __m256 cornerZ[4] = {zf, zf, zf1, zf1};
+        for (int c = 0; c < 4; ++c) {
+            __m256i hash = hashes[c];
+            __m256 signX = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(hash, oneInt), 31));
+            __m256 signZ = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(2)), 30));
+            __m256 diagonal = _mm256_add_ps(_mm256_xor_ps(cornerX[c], signX), _mm256_xor_ps(cornerZ[c], signZ));
+            __m256 useZ = _mm256_castsi256_ps(_mm256_slli_epi32(hash, 30)); // Bit 1 moved to the sign bit
+            __m256 axis = _mm256_xor_ps(_mm256_blendv_ps(cornerX[c], cornerZ[c], useZ), signX);
+            __m256 isAxis = _mm256_castsi256_ps(_mm256_slli_epi32(hash, 29)); // Bit 2 moved to the sign bit
+            corner[c] = _mm256_blendv_ps(diagonal, axis, isAxis);
+        }
+
+        __m256 nx0 = _mm256_add_ps(corner[0], _mm256_mul_ps(u, _mm256_sub_ps(corner[1], corner[0])));
+        __m256 nx1 = _mm256_add_ps(corner[2], _mm256_mul_ps(u, _mm256_sub_ps(corner[3], corner[2])));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(nx0, _mm256_mul_ps(v, _mm256_sub_ps(nx1, nx0))));
+    }
+}
+#else
+void PerlinNoise::SampleRowAVX2(int worldX, int worldZ, float frequency, float* out) const {
+    SampleRowSSE2(worldX, worldZ, frequency, out);
+}
+#endif
+
+bool PerlinNoise::IsKernelSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::SCALAR:
+            return true;
+        case Kernel::SSE2:
+#ifdef PERLIN_NOISE_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case Kernel::AVX2:
+#ifdef PERLIN_NOISE_AVX2
+            __builtin_cpu_init(); // s_kernel is detected during static initialization, possibly before libgcc's own
+            return __builtin_cpu_supports("avx2");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+bool PerlinNoise::VerifyKernel(Kernel kernel) {
+    if (!IsKernelSupported(kernel)) {
+        return false;
+    }
+    
+    // The world's noise frequencies plus awkward ones, at rows on both sides of zero and far out
+    static const int seeds[] = {0, 1234, -7};
+    static const float frequencies[] = {0.003f, 0.008f, 0.02f, 0.05f, 0.08f, 0.13f, 0.15f, 1.0f, 3.7f};
+    static const int origins[][2] = {{0, 0}, {-16, -16}, {-8, 24}, {4096, -2048}, {-30000, 30000}, {123457, -98765}};
+    float batch[BATCH_WIDTH];
+    for (int seed : seeds) {
+        PerlinNoise noise(seed);
+        for (float frequency : frequencies) {
+            for (const auto& origin : origins) {
+                for (int z = 0; z < 4; ++z) {
+                    int worldZ = origin[1] + z * 5;
+                    noise.SampleRowWith(kernel, origin[0], worldZ, frequency, batch);
+                    for (int i = 0; i < BATCH_WIDTH; ++i) {
+                        float expected = noise.SampleColumn(origin[0] + i, worldZ, frequency);
+                        if (std::memcmp(&batch[i], &expected, sizeof(float)) != 0) {
+                            std::cerr << "[NOISE] " << GetKernelName(kernel) << " kernel gives " << batch[i] << " instead of "
+                                      << expected << " at column (" << origin[0] + i << ", " << worldZ << "), frequency "
+                                      << frequency << "; not using it" << std::endl;
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+PerlinNoise::Kernel PerlinNoise::DetectKernel() {
+    if (VerifyKernel(Kernel::AVX2)) {
+        return Kernel::AVX2;
+    }
+    if (VerifyKernel(Kernel::SSE2)) {
+        return Kernel::SSE2;
+    }
+    return Kernel::SCALAR;
+}
+
+void PerlinNoise::SetKernel(Kernel kernel) {
+    while (kernel != Kernel::SCALAR && !VerifyKernel(kernel)) {
+        kernel = static_cast<Kernel>(static_cast<int>(kernel) - 1);
+    }
+    s_kernel = kernel;
+}
+
+const char* PerlinNoise::GetKernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::SCALAR: return "scalar";
+        case Kernel::SSE2: return "SSE2";
+        case Kernel::AVX2: return "AVX2";
+    }
+    return "unknown";
+}
@@ -133,9 +133,8 @@ RaycastResult Player::CastRay(World* world, float maxDistance) const {
             break;
         }
         
-        // Check if we hit a solid block
-        Block block = world->GetBlock(mapX, mapY, mapZ);
-        if (block.IsSolid()) {
+        // Check if we hit a solid block (occupancy bit only, no block decode)
+        if (world->IsBlockOccupied(mapX, mapY, mapZ)) {
             result.hit = true;
             result.blockPos = Vec3((float)mapX, (float)mapY, (float)mapZ);
             result.distance = perpWallDist;
@@ -288,6 +287,14 @@ bool Player::CheckCollision(const Vec3& newPosition, World* world, const BlockMa
         heightsToCheck.push_back(playerHeight - 0.01f); // Just below the head
     }
     
+    // Broad phase: every sample below falls inside this block range, so when the occupancy
+    // bitmasks show it empty there is nothing to collide with
+    if (!world->IsRegionOccupied(static_cast<int>(std::round(newPosition.x - halfWidth)), static_cast<int>(std::floor(newPosition.y)),
+                                 static_cast<int>(std::round(newPosition.z - halfWidth)), static_cast<int>(std::round(newPosition.x + halfWidth)),
+                                 static_cast<int>(std::floor(newPosition.y + heightsToCheck.back())), static_cast<int>(std::round(newPosition.z + halfWidth)))) {
+        return false;
+    }
+    
     for (float heightOffset : heightsToCheck) {
         float yCheck = newPosition.y + heightOffset;
         
@@ -320,10 +327,9 @@ bool Player::CheckCollision(const Vec3& newPosition, World* world, const BlockMa
                 testZ >= blockZ - 0.5f && testZ <= blockZ + 0.5f &&
                 yCheck >= blockY && yCheck < blockY + 1.0f) {
                 
-                Block block = world->GetBlock(blockX, blockY, blockZ);
-                if (block.IsSolid()) {
+                if (world->IsBlockOccupied(blockX, blockY, blockZ)) {
                     // Skip collision if this is a ground block and we have BlockManager
-                    if (blockManager && blockManager->IsGround(block.GetType())) {
+                    if (blockManager && blockManager->IsGround(world->GetBlock(blockX, blockY, blockZ).GetType())) {
                         continue; // Don't collide with ground blocks
                     }
                     return true; // Collision detected
@@ -364,10 +370,9 @@ bool Player::CheckGroundCollision(const Vec3& position, World* world, const Bloc
             testZ >= blockZ - 0.5f && testZ <= blockZ + 0.5f &&
             position.y >= blockY && position.y < blockY + 1.0f) {
             
-            Block block = world->GetBlock(blockX, blockY, blockZ);
-            if (block.IsSolid()) {
+            if (world->IsBlockOccupied(blockX, blockY, blockZ)) {
                 // Skip collision if this is a ground block and we have BlockManager
-                if (blockManager && blockManager->IsGround(block.GetType())) {
+                if (blockManager && blockManager->IsGround(world->GetBlock(blockX, blockY, blockZ).GetType())) {
                     continue; // Don't treat ground blocks as solid ground for landing
                 }
                 return true; // Ground collision detected
@@ -421,6 +426,26 @@ float Player::FindGroundLevel(const Vec3& position, World* world, const BlockMan
     // Start from current falling position and work upward to find the ground surface
     int startY = static_cast<int>(std::floor(position.y));
     
+    // With block categories available the chunk SOLID heightmaps answer this directly:
+    // take the highest solid block at or below the feet across the same sample columns
+    // that CheckGroundCollision tests
+    if (blockManager) {
+        float halfWidth = GetPlayerWidth() / 2.0f;
+        const float offsets[5][2] = {
+            {-halfWidth, -halfWidth}, {halfWidth, -halfWidth},
+            {halfWidth, halfWidth}, {-halfWidth, halfWidth}, {0.0f, 0.0f}
+        };
+        
+        int groundY = -1;
+        for (const auto& offset : offsets) {
+            int blockX = static_cast<int>(std::round(position.x + offset[0]));
+            int blockZ = static_cast<int>(std::round(position.z + offset[1]));
+            groundY = std::max(groundY, world->FindHighestBlockBelow(blockX, blockZ, startY, HeightmapType::SOLID));
+        }
+        
+        return groundY >= 0 ? static_cast<float>(groundY + 1) : position.y;
+    }
+    
     // Look for the highest solid block below the player
     for (int y = startY; y >= 0; y--) {
         Vec3 testPos = Vec3(position.x, static_cast<float>(y), position.z);
@@ -527,10 +552,9 @@ bool Player::HasLowCeiling(World* world, const BlockManager* blockManager) const
         int blockY = static_cast<int>(std::floor(checkHeight));
         int blockZ = static_cast<int>(std::round(testZ));
         
-        Block block = world->GetBlock(blockX, blockY, blockZ);
-        if (block.IsSolid()) {
+        if (world->IsBlockOccupied(blockX, blockY, blockZ)) {
             // Skip if it's a ground block
-            if (blockManager && blockManager->IsGround(block.GetType())) {
+            if (blockManager && blockManager->IsGround(world->GetBlock(blockX, blockY, blockZ).GetType())) {
                 continue;
             }
             return true; // Found a low ceiling
@@ -871,8 +895,7 @@ bool Player::VerifyTerrainSafety(World* world) const {
             int blockY = static_cast<int>(std::floor(m_position.y + yOffset));
             int blockZ = static_cast<int>(std::round(testZ));
             
-            Block block = world->GetBlock(blockX, blockY, blockZ);
-            if (block.IsSolid()) {
+            if (world->IsBlockOccupied(blockX, blockY, blockZ)) {
                 foundGround = true;
                 break;
             }
@@ -1,22 +1,21 @@
 #include "PlayerModel.h"
+#include "GLStateCache.h"
+#include "GpuProfiler.h"
 #include "Debug.h"
 #include <iostream>
-#include <cmath>  // For M_PI and fmod
+#include <cmath>
+#include <cstddef> // For offsetof
 #include <filesystem>
 #include <random>
 #include <chrono>
 #include "../third_party/stb_image.h"
 
 PlayerModel::PlayerModel() : 
-    m_headVAO(0), m_headVBO(0),
-    m_torsoVAO(0), m_torsoVBO(0),
-    m_leftArmVAO(0), m_leftArmVBO(0),
     m_rightArmVAO(0), m_rightArmVBO(0),
-    m_leftLegVAO(0), m_leftLegVBO(0),
-    m_rightLegVAO(0), m_rightLegVBO(0),
+    m_instancedVAO(0), m_instancedVBO(0), m_instanceVBO(0),
     m_shaderProgram(0),
     m_modelLoc(-1), m_viewLoc(-1), m_projLoc(-1), m_skinTextureLoc(-1),
-    m_currentSkinTexture(0),
+    m_currentSkinTexture(0), m_skinArrayTexture(0), m_skinLayerCount(0),
     m_randomGenerator(std::chrono::steady_clock::now().time_since_epoch().count()),
     m_isPunching(false), m_punchAnimationTime(0.0f), m_punchAnimationDuration(0.3f) {
 }
@@ -35,30 +34,19 @@ bool PlayerModel::Initialize() {
     // Assign random skin
     AssignRandomSkin();
     
-    CreateHeadGeometry();
-    CreateTorsoGeometry();
-    CreateArmGeometry(m_leftArmVAO, m_leftArmVBO, GetLeftArmUVMapping());
     CreateArmGeometry(m_rightArmVAO, m_rightArmVBO, GetRightArmUVMapping());
-    CreateLegGeometry(m_leftLegVAO, m_leftLegVBO, GetLeftLegUVMapping());
-    CreateLegGeometry(m_rightLegVAO, m_rightLegVBO, GetRightLegUVMapping());
+    CreateInstancedGeometry();
     
     return true;
 }
 
 void PlayerModel::Shutdown() {
     // Clean up VAOs and VBOs
-    if (m_headVAO) { glDeleteVertexArrays(1, &m_headVAO); m_headVAO = 0; }
-    if (m_headVBO) { glDeleteBuffers(1, &m_headVBO); m_headVBO = 0; }
-    if (m_torsoVAO) { glDeleteVertexArrays(1, &m_torsoVAO); m_torsoVAO = 0; }
-    if (m_torsoVBO) { glDeleteBuffers(1, &m_torsoVBO); m_torsoVBO = 0; }
-    if (m_leftArmVAO) { glDeleteVertexArrays(1, &m_leftArmVAO); m_leftArmVAO = 0; }
-    if (m_leftArmVBO) { glDeleteBuffers(1, &m_leftArmVBO); m_leftArmVBO = 0; }
     if (m_rightArmVAO) { glDeleteVertexArrays(1, &m_rightArmVAO); m_rightArmVAO = 0; }
     if (m_rightArmVBO) { glDeleteBuffers(1, &m_rightArmVBO); m_rightArmVBO = 0; }
-    if (m_leftLegVAO) { glDeleteVertexArrays(1, &m_leftLegVAO); m_leftLegVAO = 0; }
-    if (m_leftLegVBO) { glDeleteBuffers(1, &m_leftLegVBO); m_leftLegVBO = 0; }
-    if (m_rightLegVAO) { glDeleteVertexArrays(1, &m_rightLegVAO); m_rightLegVAO = 0; }
-    if (m_rightLegVBO) { glDeleteBuffers(1, &m_rightLegVBO); m_rightLegVBO = 0; }
+    if (m_instancedVAO) { glDeleteVertexArrays(1, &m_instancedVAO); m_instancedVAO = 0; }
+    if (m_instancedVBO) { glDeleteBuffers(1, &m_instancedVBO); m_instancedVBO = 0; }
+    if (m_instanceVBO) { glDeleteBuffers(1, &m_instanceVBO); m_instanceVBO = 0; }
     
     // Clean up skin textures
     for (unsigned int texture : m_skinTextures) {
@@ -67,6 +55,8 @@ void PlayerModel::Shutdown() {
         }
     }
     m_skinTextures.clear();
+    if (m_skinArrayTexture) { glDeleteTextures(1, &m_skinArrayTexture); m_skinArrayTexture = 0; }
+    m_skinLayerCount = 0;
 }
 
 void PlayerModel::UseShaderProgram(unsigned int shaderProgram) {
@@ -80,98 +70,21 @@ void PlayerModel::SetUniformLocations(int modelLoc, int viewLoc, int projLoc, in
     m_skinTextureLoc = skinTextureLoc;
 }
 
-void PlayerModel::Render(const Vec3& position, float yaw, float pitch) {
-    if (m_shaderProgram == 0) return;
-    
-    // Don't switch shader programs - use the one set by Renderer
-    // glUseProgram(m_shaderProgram);
+void PlayerModel::RenderInstanced(const std::vector<PlayerInstance>& instances) {
+    if (instances.empty() || m_instancedVAO == 0 || m_skinArrayTexture == 0) return;
     
-    // Bind the current skin texture
-    if (m_currentSkinTexture != 0 && m_skinTextureLoc != -1) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_currentSkinTexture);
-        glUniform1i(m_skinTextureLoc, 0);
-    }
-    
-    // Normalize yaw to prevent accumulation issues
-    float normalizedYaw = fmod(yaw, 360.0f);
-    if (normalizedYaw < 0.0f) normalizedYaw += 360.0f;
-    
-    // Base transformation matrix for the entire player
-    // Player position represents center at ground level (feet)
-    // Total player height is 1.8 blocks
-    // Transformation order: Translate to world position, then rotate, then apply body part offset
-    Mat4 translation = CreateTranslationMatrix(position.x, position.y, position.z);
-    Mat4 yawRotation = CreateRotationYMatrix(normalizedYaw * M_PI / 180.0f);
-    Mat4 playerTransform = MultiplyMatrices(translation, yawRotation);
-    
-    // Render Head (0.5x0.45x0.5 blocks) - top of player
-    // Position: y + 1.575 (center of head at 1.575 blocks above feet)
-    {
-        Mat4 headTransform = CreateTranslationMatrix(0.0f, 1.575f, 0.0f);
-        Mat4 modelMatrix = MultiplyMatrices(playerTransform, headTransform);
-        glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
-        
-        glBindVertexArray(m_headVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36); // 6 faces * 6 vertices
-    }
-    
-    // Render Torso (0.5x0.675x0.25 blocks) - middle of player
-    // Position: y + 1.0125 (center of torso at 1.0125 blocks above feet)
-    {
-        Mat4 torsoTransform = CreateTranslationMatrix(0.0f, 1.0125f, 0.0f);
-        Mat4 modelMatrix = MultiplyMatrices(playerTransform, torsoTransform);
-        glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
-        
-        glBindVertexArray(m_torsoVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-    }
-    
-    // Render Left Arm (0.25x0.675x0.25 blocks) - attached to torso
-    // Position: align with torso center at y + 1.0125
-    {
-        Mat4 armTransform = CreateTranslationMatrix(-0.375f, 1.0125f, 0.0f); // -0.25 (torso half width) - 0.125 (arm half width)
-        Mat4 modelMatrix = MultiplyMatrices(playerTransform, armTransform);
-        glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
-        
-        glBindVertexArray(m_leftArmVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-    }
-    
-    // Render Right Arm (0.25x0.675x0.25 blocks) - attached to torso
-    // Position: align with torso center at y + 1.0125
-    {
-        Mat4 armTransform = CreateTranslationMatrix(0.375f, 1.0125f, 0.0f); // 0.25 (torso half width) + 0.125 (arm half width)
-        Mat4 modelMatrix = MultiplyMatrices(playerTransform, armTransform);
-        glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
-        
-        glBindVertexArray(m_rightArmVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-    }
-    
-    // Render Left Leg (0.25x0.675x0.25 blocks) - bottom of player
-    // Position: y + 0.3375 (center of leg at 0.3375 blocks above feet)
-    {
-        Mat4 legTransform = CreateTranslationMatrix(-0.125f, 0.3375f, 0.0f); // -0.125 (quarter torso width)
-        Mat4 modelMatrix = MultiplyMatrices(playerTransform, legTransform);
-        glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
-        
-        glBindVertexArray(m_leftLegVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-    }
+    GLStateCache::ActiveTexture(GL_TEXTURE0);
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_skinArrayTexture);
     
-    // Render Right Leg (0.25x0.675x0.25 blocks) - bottom of player
-    // Position: y + 0.3375 (center of leg at 0.3375 blocks above feet)
-    {
-        Mat4 legTransform = CreateTranslationMatrix(0.125f, 0.3375f, 0.0f); // 0.125 (quarter torso width)
-        Mat4 modelMatrix = MultiplyMatrices(playerTransform, legTransform);
-        glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
-        
-        glBindVertexArray(m_rightLegVAO);
-        glDrawArrays(GL_TRIANGLES, 0, 36);
-    }
+    // Orphan last frame's instances instead of waiting for the GPU to finish reading them
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(PlayerInstance), instances.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GpuProfiler::CountUpload(instances.size() * sizeof(PlayerInstance));
     
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(m_instancedVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, BODY_PART_COUNT * VERTICES_PER_PART, static_cast<GLsizei>(instances.size()));
+    GpuProfiler::CountDraw(BODY_PART_COUNT * VERTICES_PER_PART, static_cast<int>(instances.size()));
 }
 
 void PlayerModel::RenderFirstPersonArm(const Player& player) {
@@ -179,8 +92,8 @@ void PlayerModel::RenderFirstPersonArm(const Player& player) {
     
     // Bind the current skin texture
     if (m_currentSkinTexture != 0 && m_skinTextureLoc != -1) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_currentSkinTexture);
+        GLStateCache::ActiveTexture(GL_TEXTURE0);
+        GLStateCache::BindTexture(GL_TEXTURE_2D, m_currentSkinTexture);
         glUniform1i(m_skinTextureLoc, 0);
     }
     
@@ -264,10 +177,9 @@ void PlayerModel::RenderFirstPersonArm(const Player& player) {
     
     // Set the model matrix and render the right arm
     glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, finalMatrix.m);
-    glBindVertexArray(m_rightArmVAO);
+    GLStateCache::BindVertexArray(m_rightArmVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);
-    
-    glBindVertexArray(0);
+    GpuProfiler::CountDraw(36);
 }
 
 void PlayerModel::TriggerPunchAnimation() {
@@ -285,58 +197,12 @@ void PlayerModel::UpdateAnimation(float deltaTime) {
     }
 }
 
-void PlayerModel::CreateHeadGeometry() {
-    // Head: 0.5x0.45x0.5 blocks (slightly shorter cube)
-    std::vector<float> vertices = CreateCubeVerticesWithUV(0.5f, 0.45f, 0.5f, 0.0f, 0.0f, 0.0f, GetHeadUVMapping());
-    
-    glGenVertexArrays(1, &m_headVAO);
-    glBindVertexArray(m_headVAO);
-    
-    glGenBuffers(1, &m_headVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_headVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    // Texture coordinate attribute (location 1)
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
-void PlayerModel::CreateTorsoGeometry() {
-    // Torso: 0.5x0.675x0.25 blocks
-    std::vector<float> vertices = CreateCubeVerticesWithUV(0.5f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, GetTorsoUVMapping());
-    
-    glGenVertexArrays(1, &m_torsoVAO);
-    glBindVertexArray(m_torsoVAO);
-    
-    glGenBuffers(1, &m_torsoVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_torsoVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    // Texture coordinate attribute (location 1)
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
 void PlayerModel::CreateArmGeometry(unsigned int& vao, unsigned int& vbo, const std::vector<std::vector<float>>& uvMapping) {
     // Arms: 0.25x0.675x0.25 blocks
     std::vector<float> vertices = CreateCubeVerticesWithUV(0.25f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, uvMapping);
     
     glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
+    GLStateCache::BindVertexArray(vao);
     
     glGenBuffers(1, &vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
@@ -351,34 +217,66 @@ void PlayerModel::CreateArmGeometry(unsigned int& vao, unsigned int& vbo, const
     glEnableVertexAttribArray(1);
     
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(0);
 }
 
-void PlayerModel::CreateLegGeometry(unsigned int& vao, unsigned int& vbo, const std::vector<std::vector<float>>& uvMapping) {
-    // Legs: 0.25x0.675x0.25 blocks
-    std::vector<float> vertices = CreateCubeVerticesWithUV(0.25f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, uvMapping);
+void PlayerModel::CreateInstancedGeometry() {
+    // Every body part around its own centre, in BodyPart order, with the part id appended to each vertex.
+    // Sizes in blocks: head 0.5x0.45x0.5, torso 0.5x0.675x0.25, arms and legs 0.25x0.675x0.25
+    const std::vector<float> parts[BODY_PART_COUNT] = {
+        CreateCubeVerticesWithUV(0.5f, 0.45f, 0.5f, 0.0f, 0.0f, 0.0f, GetHeadUVMapping()),
+        CreateCubeVerticesWithUV(0.5f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, GetTorsoUVMapping()),
+        CreateCubeVerticesWithUV(0.25f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, GetLeftArmUVMapping()),
+        CreateCubeVerticesWithUV(0.25f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, GetRightArmUVMapping()),
+        CreateCubeVerticesWithUV(0.25f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, GetLeftLegUVMapping()),
+        CreateCubeVerticesWithUV(0.25f, 0.675f, 0.25f, 0.0f, 0.0f, 0.0f, GetRightLegUVMapping())
+    };
     
-    glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
+    std::vector<float> vertices;
+    vertices.reserve(BODY_PART_COUNT * VERTICES_PER_PART * INSTANCED_VERTEX_FLOATS);
+    for (int part = 0; part < BODY_PART_COUNT; ++part) {
+        for (size_t i = 0; i + 5 <= parts[part].size(); i += 5) {
+            vertices.insert(vertices.end(), parts[part].begin() + i, parts[part].begin() + i + 5);
+            vertices.push_back(static_cast<float>(part));
+        }
+    }
     
-    glGenBuffers(1, &vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glGenVertexArrays(1, &m_instancedVAO);
+    GLStateCache::BindVertexArray(m_instancedVAO);
+    
+    glGenBuffers(1, &m_instancedVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instancedVBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
     
+    const GLsizei stride = INSTANCED_VERTEX_FLOATS * sizeof(float);
+    
     // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
     glEnableVertexAttribArray(0);
     
     // Texture coordinate attribute (location 1)
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     
+    // Body part attribute (location 2)
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)(5 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    
+    // Per-instance attributes, advanced once per player: position and yaw (location 3),
+    // pitch, walk phase and skin layer (location 4). Filled by RenderInstanced
+    glGenBuffers(1, &m_instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(PlayerInstance), (void*)offsetof(PlayerInstance, x));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(PlayerInstance), (void*)offsetof(PlayerInstance, pitch));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(0);
 }
 
-
-
 // Helper function to create cube geometry with UV coordinates
 std::vector<float> PlayerModel::CreateCubeVerticesWithUV(float width, float height, float depth, 
                                                           float offsetX, float offsetY, float offsetZ,
@@ -462,27 +360,6 @@ Mat4 PlayerModel::CreateScaleMatrix(float sx, float sy, float sz) {
     return scale;
 }
 
-Mat4 PlayerModel::CreateRotationYMatrix(float angle) {
-    Mat4 rot;
-    float c = cos(angle);
-    float s = sin(angle);
-    
-    rot.m[0] = c;
-    rot.m[2] = s;
-    rot.m[8] = -s;
-    rot.m[10] = c;
-    
-    return rot;
-}
-
-Mat4 PlayerModel::CreateTranslationMatrix(float x, float y, float z) {
-    Mat4 trans;
-    trans.m[12] = x;
-    trans.m[13] = y;
-    trans.m[14] = z;
-    return trans;
-}
-
 Mat4 PlayerModel::MultiplyMatrices(const Mat4& a, const Mat4& b) {
     Mat4 result;
     
@@ -501,6 +378,7 @@ Mat4 PlayerModel::MultiplyMatrices(const Mat4& a, const Mat4& b) {
 // Skin management methods
 bool PlayerModel::LoadSkins() {
     std::string skinsPath = "assets/skins";
+    std::vector<unsigned char> skinLayers; // RGBA texels of every 64x64 skin, one layer after another
     
     try {
         for (const auto& entry : std::filesystem::directory_iterator(skinsPath)) {
@@ -508,7 +386,7 @@ bool PlayerModel::LoadSkins() {
                 std::string skinName = entry.path().stem().string();
                 std::string skinPath = entry.path().string();
                 
-                unsigned int textureID = LoadSkinTexture(skinPath);
+                unsigned int textureID = LoadSkinTexture(skinPath, skinLayers);
                 if (textureID != 0) {
                     m_availableSkins.push_back(skinName);
                     m_skinTextures.push_back(textureID);
@@ -526,6 +404,8 @@ bool PlayerModel::LoadSkins() {
         return false;
     }
     
+    CreateSkinArrayTexture(skinLayers);
+    
     DEBUG_TEXTURE("Loaded " << m_availableSkins.size() << " skins");
     return true;
 }
@@ -551,10 +431,10 @@ void PlayerModel::SetSkin(const std::string& skinName) {
     std::cerr << "Skin not found: " << skinName << std::endl;
 }
 
-unsigned int PlayerModel::LoadSkinTexture(const std::string& skinPath) {
+unsigned int PlayerModel::LoadSkinTexture(const std::string& skinPath, std::vector<unsigned char>& skinLayers) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, textureID);
     
     // Set texture parameters for pixel art
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -569,6 +449,8 @@ unsigned int PlayerModel::LoadSkinTexture(const std::string& skinPath) {
     if (data) {
         if (width != 64 || height != 64) {
             std::cerr << "Warning: Skin " << skinPath << " is not 64x64 pixels (" << width << "x" << height << ")" << std::endl;
+        } else {
+            skinLayers.insert(skinLayers.end(), data, data + width * height * 4);
         }
         
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
@@ -583,11 +465,34 @@ unsigned int PlayerModel::LoadSkinTexture(const std::string& skinPath) {
     }
     
     stbi_image_free(data);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
     
     return textureID;
 } 
 
+void PlayerModel::CreateSkinArrayTexture(const std::vector<unsigned char>& skinLayers) {
+    const int layerBytes = 64 * 64 * 4;
+    m_skinLayerCount = static_cast<int>(skinLayers.size() / layerBytes);
+    if (m_skinLayerCount == 0) {
+        std::cerr << "No 64x64 skins for remote players" << std::endl;
+        return;
+    }
+    
+    glGenTextures(1, &m_skinArrayTexture);
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_skinArrayTexture);
+    
+    // Same sampling as the single skin textures
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, 64, 64, m_skinLayerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, skinLayers.data());
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    
+    DEBUG_TEXTURE("Created skin array texture with " << m_skinLayerCount << " layers");
+}
+
 // UV mapping for Minecraft skin format (64x64, each section is 8x8 pixels = 0.125 texture units)
 std::vector<std::vector<float>> PlayerModel::GetHeadUVMapping() {
     // Head mapping: front, back, left, right, bottom, top
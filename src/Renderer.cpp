@@ -2,11 +2,14 @@
 #include "World.h"
 #include "Chunk.h"
 #include "PlayerModel.h"
-#include "BiomeSystem.h"
+#include "GLStateCache.h"
+#include "GpuProfiler.h"
 #include "Debug.h"
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <cmath>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -20,13 +23,14 @@
 Renderer::Renderer() : m_cubeVAO(0), m_cubeVBO(0), m_shaderProgram(0), 
                        m_triangleVAO(0), m_triangleVBO(0),
                        m_wireframeVAO(0), m_wireframeVBO(0), m_wireframeShaderProgram(0),
-                       m_wireframeModelLoc(-1), m_wireframeViewLoc(-1), m_wireframeProjLoc(-1),
+                       m_wireframeModelLoc(-1),
                        m_playerShaderProgram(0),
                        m_playerModelLoc(-1), m_playerViewLoc(-1), m_playerProjLoc(-1),
+                       m_playerInstancedShaderProgram(0),
                        m_skyVAO(0), m_skyVBO(0), m_skyShaderProgram(0),
-                       m_skyViewLoc(-1), m_skyProjLoc(-1), m_skyGameTimeLoc(-1), m_skySunDirLoc(-1),
-                       m_sunTexture(0), m_moonTexture(0),
-                       m_viewportWidth(1280), m_viewportHeight(720) {
+                       m_blockTextureArray(0), m_sunTexture(0), m_moonTexture(0),
+                       m_viewportWidth(1280), m_viewportHeight(720),
+                       m_frameDataUBO(0), m_frameData(), m_animationTime(0.0f) {
 }
 
 Renderer::~Renderer() {
@@ -34,6 +38,15 @@ Renderer::~Renderer() {
 }
 
 bool Renderer::Initialize() {
+    // Whatever ran before us (ImGui setup) may have changed state the cache assumes is at its defaults
+    GLStateCache::Invalidate();
+    
+    // Pass timings are optional; without timer queries the profiler still records its counters
+    GpuProfiler::Initialize();
+    
+    // Chunk meshes are uploaded into the renderer's pools from here on
+    Chunk::SetMeshPools(&m_chunkMeshPools);
+    
     // Create cube geometry
     if (!CreateCubeGeometry()) {
         std::cerr << "Failed to create cube geometry" << std::endl;
@@ -48,7 +61,7 @@ bool Renderer::Initialize() {
     };
 
     glGenVertexArrays(1, &m_triangleVAO);
-    glBindVertexArray(m_triangleVAO);
+    GLStateCache::BindVertexArray(m_triangleVAO);
 
     glGenBuffers(1, &m_triangleVBO);
     glBindBuffer(GL_ARRAY_BUFFER, m_triangleVBO);
@@ -58,7 +71,7 @@ bool Renderer::Initialize() {
     glEnableVertexAttribArray(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(0);
 
     // Create shaders
     if (!CreateShaders()) {
@@ -104,9 +117,6 @@ bool Renderer::Initialize() {
 
     // Get uniform locations for block shaders
     m_modelLoc = glGetUniformLocation(m_shaderProgram, "model");
-    m_viewLoc = glGetUniformLocation(m_shaderProgram, "view");
-    m_projLoc = glGetUniformLocation(m_shaderProgram, "projection");
-    m_cameraYLoc = glGetUniformLocation(m_shaderProgram, "cameraY");
     
     // Get uniform locations for player shaders
     m_playerModelLoc = glGetUniformLocation(m_playerShaderProgram, "model");
@@ -115,33 +125,46 @@ bool Renderer::Initialize() {
     
     // Get uniform locations for wireframe shaders
     m_wireframeModelLoc = glGetUniformLocation(m_wireframeShaderProgram, "model");
-    m_wireframeViewLoc = glGetUniformLocation(m_wireframeShaderProgram, "view");  
-    m_wireframeProjLoc = glGetUniformLocation(m_wireframeShaderProgram, "projection");
-    
-    // Get uniform locations for sky shaders
-    m_skyViewLoc = glGetUniformLocation(m_skyShaderProgram, "view");
-    m_skyProjLoc = glGetUniformLocation(m_skyShaderProgram, "projection");
-    m_skyGameTimeLoc = glGetUniformLocation(m_skyShaderProgram, "gameTime");
-    m_skySunDirLoc = glGetUniformLocation(m_skyShaderProgram, "sunDirection");
     
     // Get uniform locations for water shaders
     m_waterModelLoc = glGetUniformLocation(m_waterShaderProgram, "model");
-    m_waterViewLoc = glGetUniformLocation(m_waterShaderProgram, "view");
-    m_waterProjLoc = glGetUniformLocation(m_waterShaderProgram, "projection");
-    m_waterTimeLoc = glGetUniformLocation(m_waterShaderProgram, "time");
-    m_waterGameTimeLoc = glGetUniformLocation(m_waterShaderProgram, "gameTime");
-    m_waterCameraPosLoc = glGetUniformLocation(m_waterShaderProgram, "cameraPos");
-    m_waterSunDirLoc = glGetUniformLocation(m_waterShaderProgram, "sunDirection");
+    
+    // View, projection, camera and time come from one uniform buffer shared by every world shader
+    glGenBuffers(1, &m_frameDataUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameDataUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, m_frameDataUBO);
+    for (const auto& variant : m_blockShaders) {
+        for (const BlockShader& shader : variant) {
+            BindFrameData(shader.program);
+        }
+    }
+    BindFrameData(m_waterShaderProgram);
+    BindFrameData(m_skyShaderProgram);
+    BindFrameData(m_wireframeShaderProgram);
+    BindFrameData(m_playerInstancedShaderProgram);
+    
+    // Samplers never change unit, so they are set once here rather than every draw
+    for (const auto& variant : m_blockShaders) {
+        for (const BlockShader& shader : variant) {
+            GLStateCache::UseProgram(shader.program);
+            glUniform1i(glGetUniformLocation(shader.program, "blockTextures"), 0);
+        }
+    }
+    GLStateCache::UseProgram(m_playerInstancedShaderProgram);
+    glUniform1i(glGetUniformLocation(m_playerInstancedShaderProgram, "skinTextures"), 0);
+    GLStateCache::UseProgram(0);
 
     // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::SetEnabled(GL_DEPTH_TEST, true);
     glDepthFunc(GL_LESS);
     
     // Enable multisampling for antialiasing (reduce shimmering)
     glEnable(GL_MULTISAMPLE);
     
     // Enable backface culling to hide faces facing away from camera
-    glEnable(GL_CULL_FACE);
+    GLStateCache::SetEnabled(GL_CULL_FACE, true);
     glCullFace(GL_BACK);
     glFrontFace(GL_CCW); // Counter-clockwise winding for front faces
     
@@ -168,10 +191,6 @@ bool Renderer::Initialize() {
         return false;
     }
     
-    // Get texture uniform location after loading textures
-    m_textureLoc = glGetUniformLocation(m_shaderProgram, "blockTexture");
-    m_colorTintLoc = glGetUniformLocation(m_shaderProgram, "colorTint");
-    
     // Initialize player model
     if (!m_playerModel.Initialize()) {
         std::cerr << "Failed to initialize player model" << std::endl;
@@ -193,79 +212,50 @@ bool Renderer::Initialize() {
 }
 
 bool Renderer::CreateCubeGeometry() {
-    // Cube vertices with position (3), AO (1), and texture coordinates (2)  
-    // Format: x, y, z, ao, u, v
-    float cubeVertices[] = {
-        // Front face
-        -0.5f, -0.5f,  0.5f, 1.0f, 0.0f, 0.0f,  // bottom-left
-         0.5f, -0.5f,  0.5f, 1.0f, 1.0f, 0.0f,  // bottom-right
-         0.5f,  0.5f,  0.5f, 1.0f, 1.0f, 1.0f,  // top-right
-         0.5f,  0.5f,  0.5f, 1.0f, 1.0f, 1.0f,  // top-right
-        -0.5f,  0.5f,  0.5f, 1.0f, 0.0f, 1.0f,  // top-left
-        -0.5f, -0.5f,  0.5f, 1.0f, 0.0f, 0.0f,  // bottom-left
-
-        // Back face
-        -0.5f, -0.5f, -0.5f, 1.0f, 1.0f, 0.0f,  // bottom-left
-        -0.5f,  0.5f, -0.5f, 1.0f, 1.0f, 1.0f,  // top-left
-         0.5f,  0.5f, -0.5f, 1.0f, 0.0f, 1.0f,  // top-right
-         0.5f,  0.5f, -0.5f, 1.0f, 0.0f, 1.0f,  // top-right
-         0.5f, -0.5f, -0.5f, 1.0f, 0.0f, 0.0f,  // bottom-right
-        -0.5f, -0.5f, -0.5f, 1.0f, 1.0f, 0.0f,  // bottom-left
-
-        // Left face
-        -0.5f,  0.5f,  0.5f, 1.0f, 1.0f, 1.0f,  // top-right
-        -0.5f,  0.5f, -0.5f, 1.0f, 0.0f, 1.0f,  // top-left
-        -0.5f, -0.5f, -0.5f, 1.0f, 0.0f, 0.0f,  // bottom-left
-        -0.5f, -0.5f, -0.5f, 1.0f, 0.0f, 0.0f,  // bottom-left
-        -0.5f, -0.5f,  0.5f, 1.0f, 1.0f, 0.0f,  // bottom-right
-        -0.5f,  0.5f,  0.5f, 1.0f, 1.0f, 1.0f,  // top-right
-
-        // Right face
-         0.5f,  0.5f,  0.5f, 1.0f, 0.0f, 1.0f,  // top-left
-         0.5f, -0.5f,  0.5f, 1.0f, 0.0f, 0.0f,  // bottom-left
-         0.5f, -0.5f, -0.5f, 1.0f, 1.0f, 0.0f,  // bottom-right
-         0.5f, -0.5f, -0.5f, 1.0f, 1.0f, 0.0f,  // bottom-right
-         0.5f,  0.5f, -0.5f, 1.0f, 1.0f, 1.0f,  // top-right
-         0.5f,  0.5f,  0.5f, 1.0f, 0.0f, 1.0f,  // top-left
-
-        // Bottom face
-        -0.5f, -0.5f, -0.5f, 1.0f, 0.0f, 1.0f,  // top-left
-         0.5f, -0.5f, -0.5f, 1.0f, 1.0f, 1.0f,  // top-right
-         0.5f, -0.5f,  0.5f, 1.0f, 1.0f, 0.0f,  // bottom-right
-         0.5f, -0.5f,  0.5f, 1.0f, 1.0f, 0.0f,  // bottom-right
-        -0.5f, -0.5f,  0.5f, 1.0f, 0.0f, 0.0f,  // bottom-left
-        -0.5f, -0.5f, -0.5f, 1.0f, 0.0f, 1.0f,  // top-left
-
-        // Top face
-        -0.5f,  0.5f, -0.5f, 1.0f, 0.0f, 0.0f,  // bottom-left
-        -0.5f,  0.5f,  0.5f, 1.0f, 0.0f, 1.0f,  // top-left
-         0.5f,  0.5f,  0.5f, 1.0f, 1.0f, 1.0f,  // top-right
-         0.5f,  0.5f,  0.5f, 1.0f, 1.0f, 1.0f,  // top-right  
-         0.5f,  0.5f, -0.5f, 1.0f, 1.0f, 0.0f,  // bottom-right
-        -0.5f,  0.5f, -0.5f, 1.0f, 0.0f, 0.0f   // bottom-left
+    // Unit cube in the packed chunk vertex format so it can be drawn with the block shader.
+    // Each face lists its corners in the same order the chunk mesher emits them.
+    // Format: corner x, y, z, face, corner index
+    static const int cubeCorners[24][5] = {
+        // Front face (+Z)
+        {0, 0, 1, 0, 0}, {1, 0, 1, 0, 1}, {1, 1, 1, 0, 2}, {0, 1, 1, 0, 3},
+        // Back face (-Z)
+        {0, 0, 0, 1, 0}, {0, 1, 0, 1, 3}, {1, 1, 0, 1, 2}, {1, 0, 0, 1, 1},
+        // Left face (-X)
+        {0, 0, 0, 2, 0}, {0, 0, 1, 2, 1}, {0, 1, 1, 2, 2}, {0, 1, 0, 2, 3},
+        // Right face (+X)
+        {1, 0, 0, 3, 0}, {1, 1, 0, 3, 3}, {1, 1, 1, 3, 2}, {1, 0, 1, 3, 1},
+        // Bottom face (-Y)
+        {0, 0, 0, 4, 0}, {1, 0, 0, 4, 1}, {1, 0, 1, 4, 2}, {0, 0, 1, 4, 3},
+        // Top face (+Y)
+        {0, 1, 0, 5, 0}, {0, 1, 1, 5, 3}, {1, 1, 1, 5, 2}, {1, 1, 0, 5, 1}
     };
+    
+    ChunkVertex cubeVertices[24];
+    for (int i = 0; i < 24; ++i) {
+        const int* c = cubeCorners[i];
+        cubeVertices[i] = ChunkVertex::Pack(c[0], c[1], c[2], c[3], 0, c[4], 0);
+    }
 
     glGenVertexArrays(1, &m_cubeVAO);
-    glBindVertexArray(m_cubeVAO);
+    GLStateCache::BindVertexArray(m_cubeVAO);
 
     glGenBuffers(1, &m_cubeVBO);
     glBindBuffer(GL_ARRAY_BUFFER, m_cubeVBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
 
-    // Position attribute (location = 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    // Packed position and face (location = 0)
+    glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)offsetof(ChunkVertex, position));
     glEnableVertexAttribArray(0);
     
-    // AO attribute (location = 1)
-    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    // Packed AO level, corner and flags (location = 1)
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)offsetof(ChunkVertex, attributes));
     glEnableVertexAttribArray(1);
     
-    // Texture coordinate attribute (location = 2)
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(4 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    // Six quads from the shared quad index buffer
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadIndexBuffer::Acquire(6));
 
+    GLStateCache::BindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
 
     return true;
 }
@@ -279,6 +269,11 @@ void Renderer::Shutdown() {
         glDeleteBuffers(1, &m_cubeVBO);
         m_cubeVBO = 0;
     }
+    QuadIndexBuffer::Release();
+    Chunk::SetMeshPools(nullptr);
+    for (ChunkMeshPool& pool : m_chunkMeshPools) {
+        pool.Release();
+    }
     if (m_triangleVAO) {
         glDeleteVertexArrays(1, &m_triangleVAO);
         m_triangleVAO = 0;
@@ -287,14 +282,23 @@ void Renderer::Shutdown() {
         glDeleteBuffers(1, &m_triangleVBO);
         m_triangleVBO = 0;
     }
-    if (m_shaderProgram) {
-        glDeleteProgram(m_shaderProgram);
-        m_shaderProgram = 0;
+    for (auto& variant : m_blockShaders) {
+        for (BlockShader& shader : variant) {
+            if (shader.program) {
+                glDeleteProgram(shader.program);
+            }
+            shader = BlockShader();
+        }
     }
+    m_shaderProgram = 0; // One of the block shader variants
     if (m_playerShaderProgram) {
         glDeleteProgram(m_playerShaderProgram);
         m_playerShaderProgram = 0;
     }
+    if (m_playerInstancedShaderProgram) {
+        glDeleteProgram(m_playerInstancedShaderProgram);
+        m_playerInstancedShaderProgram = 0;
+    }
     
     // Clean up wireframe resources
     if (m_wireframeVAO) {
@@ -327,31 +331,10 @@ void Renderer::Shutdown() {
     // Clean up player model
     m_playerModel.Shutdown();
     
-    // Clean up textures
-    for (const auto& pair : m_blockTextures) {
-        unsigned int texture = pair.second;
-        if (texture != 0) {
-            glDeleteTextures(1, &texture);
-        }
-    }
-    m_blockTextures.clear();
-    
-    // Clean up grass textures
-    if (m_grassTopTexture != 0) {
-        glDeleteTextures(1, &m_grassTopTexture);
-        m_grassTopTexture = 0;
-    }
-    if (m_grassSideTexture != 0) {
-        glDeleteTextures(1, &m_grassSideTexture);
-        m_grassSideTexture = 0;
-    }
-    if (m_grassSideOverlayTexture != 0) {
-        glDeleteTextures(1, &m_grassSideOverlayTexture);
-        m_grassSideOverlayTexture = 0;
-    }
-    if (m_grassBottomTexture != 0) {
-        glDeleteTextures(1, &m_grassBottomTexture);
-        m_grassBottomTexture = 0;
+    // Clean up block texture array
+    if (m_blockTextureArray != 0) {
+        glDeleteTextures(1, &m_blockTextureArray);
+        m_blockTextureArray = 0;
     }
     
     // Clean up sky textures
@@ -363,6 +346,16 @@ void Renderer::Shutdown() {
         glDeleteTextures(1, &m_moonTexture);
         m_moonTexture = 0;
     }
+    
+    if (m_frameDataUBO != 0) {
+        glDeleteBuffers(1, &m_frameDataUBO);
+        m_frameDataUBO = 0;
+    }
+    
+    GpuProfiler::Shutdown();
+    
+    // Deleted names may be handed out again
+    GLStateCache::Invalidate();
 }
 
 void Renderer::Clear() {
@@ -370,7 +363,7 @@ void Renderer::Clear() {
     // Don't clear color buffer here to avoid overriding sky rendering
     
     // Just ensure depth testing is configured properly
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::SetEnabled(GL_DEPTH_TEST, true);
     glDepthFunc(GL_LESS);
 }
 
@@ -388,329 +381,175 @@ void Renderer::SetViewport(int width, int height) {
     DEBUG_INFO("Aspect ratio: " << aspect);
 }
 
-void Renderer::BeginFrame(const Player& player) {
+void Renderer::BeginFrame(const Player& player, float gameTime) {
+    // ImGui draws between our frames; start from unknown state
+    GLStateCache::Invalidate();
+    
     // Ensure viewport is correct (in case ImGui or other code changed it)
     glViewport(0, 0, m_viewportWidth, m_viewportHeight);
     
-    glUseProgram(m_shaderProgram);
-    
-    // Set view matrix and store it for player rendering
+    // Store the view matrix for culling and the first-person arm
     m_viewMatrix = player.GetViewMatrix();
-    glUniformMatrix4fv(m_viewLoc, 1, GL_FALSE, m_viewMatrix.m);
     
     // Update projection matrix with current player FOV (for sprinting effect)
     float aspect = (float)m_viewportWidth / (float)m_viewportHeight;
     m_projectionMatrix = CreateProjectionMatrix(player.GetCurrentFOV(), aspect, 0.1f, 100.0f);
     
-    // Set projection matrix
-    glUniformMatrix4fv(m_projLoc, 1, GL_FALSE, m_projectionMatrix.m);
-    
-    // Store camera Y position for underwater effect and full position for water reflections
+    // Store camera Y position for the underwater shader variants
     Vec3 playerPos = player.GetPosition();
     m_cameraY = playerPos.y;
-    m_cameraPos = playerPos;
-    glUniform1f(m_cameraYLoc, m_cameraY);
+    m_eyePosition = player.GetCameraPosition();
+    
+    // Sun direction over the 15-minute day cycle
+    float cycleTime = fmod(gameTime, 900.0f);
+    float timeAngle = (cycleTime / 900.0f) * 2.0f * M_PI; // Full circle over day cycle
+    m_animationTime += ANIMATION_TIME_STEP;
+
+    m_frameData = FrameData();
+    std::memcpy(m_frameData.view, m_viewMatrix.m, sizeof(m_frameData.view));
+    std::memcpy(m_frameData.projection, m_projectionMatrix.m, sizeof(m_frameData.projection));
+    m_frameData.cameraPosition[0] = m_eyePosition.x;
+    m_frameData.cameraPosition[1] = m_eyePosition.y;
+    m_frameData.cameraPosition[2] = m_eyePosition.z;
+    m_frameData.sunDirection[0] = sin(timeAngle);
+    m_frameData.sunDirection[1] = cos(timeAngle);
+    m_frameData.gameTime = gameTime;
+    m_frameData.animationTime = m_animationTime;
+    
+    // Orphan last frame's block instead of waiting for the GPU to finish reading it
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameDataUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), &m_frameData, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    GpuProfiler::CountUpload(sizeof(FrameData));
     
     // Extract frustum planes for culling
     ExtractFrustum(m_viewMatrix, m_projectionMatrix);
 }
 
-void Renderer::RenderWorld(const World& world, float gameTime) {
+void Renderer::RenderWorld(const World& world) {
     // Use optimized chunk-based rendering instead of individual cubes
-    RenderChunks(world, gameTime);
+    RenderChunks(world);
 }
 
-void Renderer::RenderChunks(const World& world, float gameTime) {
-    // Set identity model matrix since chunks handle their own world positioning
-    Mat4 modelMatrix;  // Identity matrix
-    glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
-    
-    // Enable texture unit 0
-    glActiveTexture(GL_TEXTURE0);
-    glUniform1i(m_textureLoc, 0);
-    
-    // Get all available block types from the block manager
-    std::vector<BlockType> blockTypesToRender = m_blockManager.GetAllBlockTypes();
-    
-    // Render each block type separately with its texture
-    for (BlockType blockType : blockTypesToRender) {
-        // Skip AIR blocks and water blocks (water has its own shader)
-        if (blockType == BlockType::AIR || 
-            blockType == BlockType::WATER_STILL || 
-            blockType == BlockType::WATER_FLOW) {
-            continue;
-        }
-        
-        // Handle grass blocks specially (different textures per face)
-        if (blockType == BlockType::GRASS) {
-            // Render grass top faces with biome-based tint
-            glBindTexture(GL_TEXTURE_2D, m_grassTopTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 5;
-                    int chunkZ = z - 5;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        ApplyBiomeTinting(blockType, chunkX, chunkZ, world.GetSeed());
-                        chunk->RenderGrassMesh(Chunk::GRASS_TOP);
-                    }
-                }
-            }
-            
-            // Render grass side faces with base texture (no tint)
-            glUniform3f(m_colorTintLoc, 1.0f, 1.0f, 1.0f); // White (no tint)
-            glBindTexture(GL_TEXTURE_2D, m_grassSideTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 5;
-                    int chunkZ = z - 5;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderGrassMesh(Chunk::GRASS_SIDE);
-                    }
-                }
-            }
-            
-            // Render grass side overlay on top using polygon offset to avoid z-fighting
-            glEnable(GL_POLYGON_OFFSET_FILL);
-            glPolygonOffset(-1.0f, -1.0f); // Pull overlay slightly toward camera
-            glBindTexture(GL_TEXTURE_2D, m_grassSideOverlayTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 5;
-                    int chunkZ = z - 5;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        ApplyBiomeTinting(blockType, chunkX, chunkZ, world.GetSeed());
-                        chunk->RenderGrassMesh(Chunk::GRASS_SIDE);
-                    }
-                }
-            }
-            glDisable(GL_POLYGON_OFFSET_FILL);
-            
-            // Render grass bottom faces (no tint) 
-            glUniform3f(m_colorTintLoc, 1.0f, 1.0f, 1.0f); // White (no tint)
-            glBindTexture(GL_TEXTURE_2D, m_grassBottomTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 5;
-                    int chunkZ = z - 5;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderGrassMesh(Chunk::GRASS_BOTTOM);
-                    }
-                }
-            }
-        }
-        // Handle oak log blocks (different textures for top vs sides)
-        else if (blockType == BlockType::OAK_LOG) {
-            // Render oak log top/bottom faces
-            glUniform3f(m_colorTintLoc, 1.0f, 1.0f, 1.0f); // No tint
-            glBindTexture(GL_TEXTURE_2D, m_oakLogTopTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 4;
-                    int chunkZ = z - 4;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderLogMesh(Chunk::GRASS_TOP);  // Render log top faces
-                    }
-                }
+void Renderer::RenderChunks(const World& world) {
+    // Enable texture unit 0 (the block shader variants sample it)
+    GLStateCache::ActiveTexture(GL_TEXTURE0);
+    
+    // Queue the section ranges of every visible chunk; each pass is then drawn with one submission
+    // from its shared mesh pool, so the per-chunk cost is only the culling test and a few appends
+    // Culling runs once per chunk and frame; the visible section mask is shared by every pass
+    for (int pass = 0; pass < Chunk::MESH_PASS_COUNT; ++pass) {
+        m_chunkMeshPools[pass].BeginCommands();
+    }
+    m_sectionsTested = 0;
+    m_sectionsCulled = 0;
+    m_sectionsOccluded = 0;
+    bool caveCulling = m_enableCaveCulling && TraverseVisibleSections(world);
+    for (int x = 0; x < WORLD_SIZE; ++x) {
+        for (int z = 0; z < WORLD_SIZE; ++z) {
+            const Chunk* chunk = world.GetChunk(WORLD_MIN_CHUNK + x, WORLD_MIN_CHUNK + z);
+            if (!chunk || !chunk->HasMesh()) {
+                continue;
             }
-            
-            // Render oak log side faces
-            glBindTexture(GL_TEXTURE_2D, m_oakLogSideTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 4;
-                    int chunkZ = z - 4;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderLogMesh(Chunk::GRASS_SIDE);  // Render log side faces
-                    }
+            uint16_t visibleSections = CullChunkSections(*chunk);
+            if (caveCulling) {
+                // In the frustum, but no path of open cells leads there from the camera
+                for (uint16_t bits = visibleSections & ~m_reachedSections[x * WORLD_SIZE + z]; bits != 0; bits &= bits - 1) {
+                    ++m_sectionsOccluded;
+                    ++m_sectionsCulled;
                 }
+                visibleSections &= m_reachedSections[x * WORLD_SIZE + z];
             }
-        }
-        // Handle birch log blocks (different textures for top vs sides)
-        else if (blockType == BlockType::BIRCH_LOG) {
-            // Render birch log top/bottom faces
-            glUniform3f(m_colorTintLoc, 1.0f, 1.0f, 1.0f); // No tint
-            glBindTexture(GL_TEXTURE_2D, m_birchLogTopTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 4;
-                    int chunkZ = z - 4;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderLogMesh(Chunk::GRASS_TOP);  // Render log top faces
-                    }
-                }
-            }
-            
-            // Render birch log side faces
-            glBindTexture(GL_TEXTURE_2D, m_birchLogSideTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 4;
-                    int chunkZ = z - 4;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderLogMesh(Chunk::GRASS_SIDE);  // Render log side faces
-                    }
-                }
-            }
-        }
-        // Handle dark oak log blocks (different textures for top vs sides)
-        else if (blockType == BlockType::DARK_OAK_LOG) {
-            // Render dark oak log top/bottom faces
-            glUniform3f(m_colorTintLoc, 1.0f, 1.0f, 1.0f); // No tint
-            glBindTexture(GL_TEXTURE_2D, m_darkOakLogTopTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 4;
-                    int chunkZ = z - 4;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderLogMesh(Chunk::GRASS_TOP);  // Render log top faces
-                    }
-                }
-            }
-            
-            // Render dark oak log side faces
-            glBindTexture(GL_TEXTURE_2D, m_darkOakLogSideTexture);
-            for (int x = 0; x < WORLD_SIZE; ++x) {
-                for (int z = 0; z < WORLD_SIZE; ++z) {
-                    int chunkX = x - 4;
-                    int chunkZ = z - 4;
-                    const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                    if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                        chunk->RenderLogMesh(Chunk::GRASS_SIDE);  // Render log side faces
-                    }
-                }
+            if (visibleSections == 0) {
+                continue;
             }
-        } else {
-            // Get texture info for this block type
-            const BlockTextureInfo& textureInfo = m_blockManager.GetTextureInfo(blockType);
-            
-            auto textureIt = m_blockTextures.find(blockType);
-            if (textureIt != m_blockTextures.end() && textureIt->second != 0) {
-                glBindTexture(GL_TEXTURE_2D, textureIt->second);
-                
-                // Check if this block type needs biome-based tinting (leaf blocks)
-                if (NeedsBiomeTinting(blockType)) {
-                    // Render chunks with biome-based tinting per chunk
-                    for (int x = 0; x < WORLD_SIZE; ++x) {
-                        for (int z = 0; z < WORLD_SIZE; ++z) {
-                            int chunkX = x - 5;
-                            int chunkZ = z - 5;
-                            const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                            if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                                ApplyBiomeTinting(blockType, chunkX, chunkZ, world.GetSeed());
-                                chunk->RenderMeshForBlockType(blockType);
-                            }
-                        }
-                    }
-                } else {
-                    // Use the actual tint values from the block definition (for non-biome blocks)
-                    glUniform3f(m_colorTintLoc, textureInfo.tintR, textureInfo.tintG, textureInfo.tintB);
-                    
-                    // Render all chunks for this block type with the same tint
-                    for (int x = 0; x < WORLD_SIZE; ++x) {
-                        for (int z = 0; z < WORLD_SIZE; ++z) {
-                            // Convert array indices to chunk coordinates
-                            // Array indices 0-9 map to chunk coordinates -5 to +4
-                            int chunkX = x - 5;
-                            int chunkZ = z - 5;
-                            const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                            if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                                chunk->RenderMeshForBlockType(blockType);
-                            }
-                        }
-                    }
-                }
+            for (int pass = 0; pass < Chunk::MESH_PASS_COUNT; ++pass) {
+                chunk->QueueMeshPass(static_cast<Chunk::MeshPass>(pass), visibleSections);
             }
         }
     }
     
+    m_chunkDrawSubmissions = 0;
+    m_chunkDrawCommands = 0;
+    for (const ChunkMeshPool& pool : m_chunkMeshPools) {
+        m_chunkDrawSubmissions += pool.GetSubmissionCount();
+        m_chunkDrawCommands += pool.GetCommandCount();
+    }
+    
+    // Opaque and cutout geometry sample the same texture array, each pass with its own shader variant
+    GLStateCache::SetEnabled(GL_DEPTH_TEST, true);
+    GLStateCache::SetEnabled(GL_CULL_FACE, true);
+    GLStateCache::SetEnabled(GL_BLEND, false);
+    GLStateCache::DepthMask(true);
+    int underwater = m_cameraY < UNDERWATER_TINT_BELOW_Y ? 1 : 0;
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_blockTextureArray);
+    GpuProfiler::BeginPass(GpuProfiler::PASS_OPAQUE);
+    UseBlockShader(m_blockShaders[BLOCK_SHADER_OPAQUE][underwater]);
+    m_chunkMeshPools[Chunk::MESH_PASS_SOLID].SubmitCommands();
+    GpuProfiler::EndPass(GpuProfiler::PASS_OPAQUE);
+    GpuProfiler::BeginPass(GpuProfiler::PASS_CUTOUT);
+    UseBlockShader(m_blockShaders[BLOCK_SHADER_CUTOUT][underwater]);
+    m_chunkMeshPools[Chunk::MESH_PASS_CUTOUT].SubmitCommands();
+    GpuProfiler::EndPass(GpuProfiler::PASS_CUTOUT);
+    
     // Render water blocks with water shader (after opaque blocks for proper transparency)
-    glUseProgram(m_waterShaderProgram);
+    GpuProfiler::BeginPass(GpuProfiler::PASS_WATER);
+    GLStateCache::UseProgram(m_waterShaderProgram);
     
     // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::SetEnabled(GL_BLEND, true);
+    GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     // Disable depth writing for water (but keep depth testing enabled)
     // This allows us to see blocks behind/underneath the water
-    glDepthMask(GL_FALSE);
-    
-    // Set matrices for water shader
-    glUniformMatrix4fv(m_waterViewLoc, 1, GL_FALSE, m_viewMatrix.m);
-    glUniformMatrix4fv(m_waterProjLoc, 1, GL_FALSE, m_projectionMatrix.m);
-    
-    // Set time uniform for water animation
-    static float waterTime = 0.0f;
-    waterTime += 0.016f; // ~60 FPS increment
-    glUniform1f(m_waterTimeLoc, waterTime);
-    
-    // Set game time for sky color synchronization
-    glUniform1f(m_waterGameTimeLoc, gameTime);
+    GLStateCache::DepthMask(false);
     
-    // Set camera position for reflection calculations
-    glUniform3f(m_waterCameraPosLoc, m_cameraPos.x, m_cameraPos.y, m_cameraPos.z);
+    // Render water blocks (still and flowing water share the water pass)
+    SetRegionModelMatrix(m_waterModelLoc);
+    m_chunkMeshPools[Chunk::MESH_PASS_WATER].SubmitCommands();
     
-    // Calculate sun direction based on game time (same as sky shader)
-    float cycleTime = fmod(gameTime, 900.0f); // Get position within 15-minute cycle
-    float timeAngle = (cycleTime / 900.0f) * 2.0f * M_PI; // Full circle over day cycle
-    Vec3 sunDirection(
-        sin(timeAngle),
-        cos(timeAngle),
-        0.0f
-    );
-    glUniform3f(m_waterSunDirLoc, sunDirection.x, sunDirection.y, sunDirection.z);
-    
-    // Set identity model matrix for water
-    Mat4 waterModelMatrix;  // Identity matrix
-    glUniformMatrix4fv(m_waterModelLoc, 1, GL_FALSE, waterModelMatrix.m);
-    
-    // Don't bind any texture for water - we want pure color
-    glBindTexture(GL_TEXTURE_2D, 0);
-    
-    // Render water blocks
-    std::vector<BlockType> waterBlocks = {BlockType::WATER_STILL, BlockType::WATER_FLOW};
-    for (BlockType waterType : waterBlocks) {
-        for (int x = 0; x < WORLD_SIZE; ++x) {
-            for (int z = 0; z < WORLD_SIZE; ++z) {
-                int chunkX = x - 5;
-                int chunkZ = z - 5;
-                const Chunk* chunk = world.GetChunk(chunkX, chunkZ);
-                if (chunk && chunk->HasMesh() && (!m_enableFrustumCulling || IsChunkInFrustum(chunkX, chunkZ))) {
-                    chunk->RenderMeshForBlockType(waterType);
-                }
-            }
-        }
+    // Later passes are opaque again
+    GLStateCache::DepthMask(true);
+    GLStateCache::SetEnabled(GL_BLEND, false);
+    GpuProfiler::EndPass(GpuProfiler::PASS_WATER);
+}
+
+size_t Renderer::GetChunkMeshAllocatedBytes() const {
+    size_t bytes = QuadIndexBuffer::GetByteSize();
+    for (const ChunkMeshPool& pool : m_chunkMeshPools) {
+        bytes += pool.GetAllocatedBytes();
     }
-    
-    // Re-enable depth writing and disable blending, switch back to regular shader
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
-    glUseProgram(m_shaderProgram);
-    
-    // Unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    return bytes;
+}
+
+size_t Renderer::GetChunkMeshReservedBytes() const {
+    size_t bytes = 0;
+    for (const ChunkMeshPool& pool : m_chunkMeshPools) {
+        bytes += pool.GetReservedBytes();
+    }
+    return bytes;
+}
+
+int Renderer::GetChunkMeshPageCount() const {
+    int pages = 0;
+    for (const ChunkMeshPool& pool : m_chunkMeshPools) {
+        pages += pool.GetPageCount();
+    }
+    return pages;
 }
 
 void Renderer::RenderCube(float x, float y, float z) {
     // Legacy individual cube rendering (kept for compatibility)
-    // Create translation matrix for this cube
-    Mat4 modelMatrix = CreateTranslationMatrix(x, y, z);
+    // Create translation matrix for this cube (cube vertices are block corners 0-1)
+    Mat4 modelMatrix = CreateTranslationMatrix(x - 0.5f, y - 0.5f, z - 0.5f);
     
     // Set model matrix uniform
     glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, modelMatrix.m);
     
     // Render cube
-    glBindVertexArray(m_cubeVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 36);
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(m_cubeVAO);
+    glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, (void*)0);
+    GpuProfiler::CountDraw(36);
     
     // Check for OpenGL errors (only for debugging)
     GLenum error = glGetError();
@@ -727,52 +566,43 @@ void Renderer::RenderBlockWireframe(const Vec3& blockPos, const World& world) {
     }
     
     // Use wireframe shader program
-    glUseProgram(m_wireframeShaderProgram);
-    
-    // Set view and projection matrices (same as current frame)
-    glUniformMatrix4fv(m_wireframeViewLoc, 1, GL_FALSE, m_viewMatrix.m);
-    glUniformMatrix4fv(m_wireframeProjLoc, 1, GL_FALSE, m_projectionMatrix.m);
+    GLStateCache::UseProgram(m_wireframeShaderProgram);
     
     // Create translation matrix for the block position
     Mat4 modelMatrix = CreateTranslationMatrix(blockPos.x, blockPos.y, blockPos.z);
     glUniformMatrix4fv(m_wireframeModelLoc, 1, GL_FALSE, modelMatrix.m);
     
     // Set up wireframe rendering
-    glDisable(GL_CULL_FACE); // Disable face culling for wireframe
+    GLStateCache::SetEnabled(GL_CULL_FACE, false); // Disable face culling for wireframe
     glLineWidth(2.0f); // Make wireframe lines thicker
     
     // Render the complete cube outline (12 lines)
-    glBindVertexArray(m_wireframeVAO);
+    GLStateCache::BindVertexArray(m_wireframeVAO);
     glDrawArrays(GL_LINES, 0, 24); // 12 lines * 2 vertices per line = 24 vertices
-    glBindVertexArray(0);
+    GpuProfiler::CountDraw(24);
     
-    // Restore rendering state
     glLineWidth(1.0f); // Reset line width
-    glEnable(GL_CULL_FACE); // Re-enable face culling
 }
 
 void Renderer::EndFrame() {
     // Ensure OpenGL state is properly reset after rendering
-    glBindVertexArray(0);
-    glUseProgram(0);
+    GLStateCache::BindVertexArray(0);
+    GLStateCache::UseProgram(0);
     
     // Restore viewport in case ImGui changed it
     glViewport(0, 0, m_viewportWidth, m_viewportHeight);
 }
 
 void Renderer::RenderTriangle() {
-    // Legacy triangle rendering
-    glUseProgram(m_shaderProgram);
+    // Legacy triangle rendering, placed at the world origin with the frame's camera
+    GLStateCache::UseProgram(m_shaderProgram);
     
-    // Use identity matrices for 2D triangle
     Mat4 identity;
     glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, identity.m);
-    glUniformMatrix4fv(m_viewLoc, 1, GL_FALSE, identity.m);
-    glUniformMatrix4fv(m_projLoc, 1, GL_FALSE, identity.m);
     
-    glBindVertexArray(m_triangleVAO);
+    GLStateCache::BindVertexArray(m_triangleVAO);
     glDrawArrays(GL_TRIANGLES, 0, 3);
-    glBindVertexArray(0);
+    GpuProfiler::CountDraw(3);
 }
 
 std::string Renderer::LoadShaderSource(const std::string& filepath) {
@@ -787,6 +617,31 @@ std::string Renderer::LoadShaderSource(const std::string& filepath) {
     file.close();
     
     std::string source = buffer.str();
+    
+    // Expand #include "file" lines (relative to this shader) so shared declarations such as the
+    // FrameData block live in one file
+    const std::string directive = "#include \"";
+    std::string directory = filepath.substr(0, filepath.find_last_of('/') + 1);
+    for (size_t start = source.find(directive); start != std::string::npos; start = source.find(directive, start)) {
+        if (start > 0 && source[start - 1] != '\n') {
+            start += directive.size(); // Not at the start of a line (e.g. inside a comment)
+            continue;
+        }
+        size_t nameStart = start + directive.size();
+        size_t nameEnd = source.find('"', nameStart);
+        size_t lineEnd = source.find('\n', start);
+        if (nameEnd == std::string::npos || nameEnd > lineEnd) {
+            std::cerr << "Malformed #include in shader file: " << filepath << std::endl;
+            return "";
+        }
+        std::string included = LoadShaderSource(directory + source.substr(nameStart, nameEnd - nameStart));
+        if (included.empty()) {
+            return "";
+        }
+        source.replace(start, (lineEnd == std::string::npos ? source.size() : lineEnd) - start, included);
+        start += included.size();
+    }
+    
     DEBUG_SHADER("Loaded shader from: " << filepath);
     return source;
 }
@@ -806,37 +661,71 @@ bool Renderer::CreateShaders() {
         return false;
     }
 
-    // Compile shaders
+    // The vertex shader is shared; each variant compiles its own fragment shader
     unsigned int vertexShader = CompileShader(GL_VERTEX_SHADER, vertexShaderSource.c_str());
     if (vertexShader == 0) return false;
 
-    unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentShaderSource.c_str());
+    static const char* variantDefines[BLOCK_SHADER_VARIANT_COUNT] = {
+        "",                      // BLOCK_SHADER_OPAQUE
+        "#define ALPHA_CUTOUT\n" // BLOCK_SHADER_CUTOUT
+    };
+    bool linked = true;
+    for (int variant = 0; variant < BLOCK_SHADER_VARIANT_COUNT && linked; ++variant) {
+        for (int underwater = 0; underwater < 2 && linked; ++underwater) {
+            std::string defines = std::string(variantDefines[variant]) + (underwater ? "#define UNDERWATER\n" : "");
+            BlockShader& shader = m_blockShaders[variant][underwater];
+            shader.program = LinkBlockShaderVariant(vertexShader, fragmentShaderSource, defines);
+            linked = shader.program != 0;
+            shader.modelLoc = glGetUniformLocation(shader.program, "model");
+        }
+    }
+    glDeleteShader(vertexShader);
+    if (!linked) {
+        return false; // Shutdown deletes the variants that did link
+    }
+
+    m_shaderProgram = m_blockShaders[BLOCK_SHADER_OPAQUE][0].program;
+    DEBUG_SHADER("Shaders loaded and compiled successfully!");
+    return true;
+}
+
+unsigned int Renderer::LinkBlockShaderVariant(unsigned int vertexShader, const std::string& fragmentSource, const std::string& defines) {
+    // #defines must follow the #version line
+    std::string source = fragmentSource;
+    size_t versionEnd = source.find('\n');
+    source.insert(versionEnd == std::string::npos ? source.size() : versionEnd + 1, defines);
+    
+    unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, source.c_str());
     if (fragmentShader == 0) {
-        glDeleteShader(vertexShader);
-        return false;
+        return 0;
     }
 
-    // Create shader program
-    m_shaderProgram = glCreateProgram();
-    glAttachShader(m_shaderProgram, vertexShader);
-    glAttachShader(m_shaderProgram, fragmentShader);
-    glLinkProgram(m_shaderProgram);
+    unsigned int program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(fragmentShader);
 
     // Check for linking errors
-    if (!CheckProgramLinking(m_shaderProgram)) {
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        glDeleteProgram(m_shaderProgram);
-        m_shaderProgram = 0;
-        return false;
+    if (!CheckProgramLinking(program)) {
+        glDeleteProgram(program);
+        return 0;
     }
+    return program;
+}
 
-    // Clean up shaders
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+void Renderer::UseBlockShader(const BlockShader& shader) {
+    GLStateCache::UseProgram(shader.program);
+    SetRegionModelMatrix(shader.modelLoc);
+}
 
-    DEBUG_SHADER("Shaders loaded and compiled successfully!");
-    return true;
+void Renderer::BindFrameData(unsigned int program) {
+    GLuint blockIndex = glGetUniformBlockIndex(program, "FrameData");
+    if (blockIndex == GL_INVALID_INDEX) {
+        std::cerr << "Shader program " << program << " has no FrameData block" << std::endl;
+        return;
+    }
+    glUniformBlockBinding(program, blockIndex, FRAME_DATA_BINDING);
 }
 
 bool Renderer::CreatePlayerShaders() {
@@ -883,6 +772,36 @@ bool Renderer::CreatePlayerShaders() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
+    // Instanced variant for remote players: same skin mapping, transforms built in the vertex shader
+    std::string instancedVertexSource = LoadShaderSource("shaders/player_instanced_vertex.glsl");
+    std::string instancedFragmentSource = LoadShaderSource("shaders/player_instanced_fragment.glsl");
+    if (instancedVertexSource.empty() || instancedFragmentSource.empty()) {
+        std::cerr << "Failed to load instanced player shaders" << std::endl;
+        return false;
+    }
+
+    vertexShader = CompileShader(GL_VERTEX_SHADER, instancedVertexSource.c_str());
+    if (vertexShader == 0) return false;
+
+    fragmentShader = CompileShader(GL_FRAGMENT_SHADER, instancedFragmentSource.c_str());
+    if (fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        return false;
+    }
+
+    m_playerInstancedShaderProgram = glCreateProgram();
+    glAttachShader(m_playerInstancedShaderProgram, vertexShader);
+    glAttachShader(m_playerInstancedShaderProgram, fragmentShader);
+    glLinkProgram(m_playerInstancedShaderProgram);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    if (!CheckProgramLinking(m_playerInstancedShaderProgram)) {
+        glDeleteProgram(m_playerInstancedShaderProgram);
+        m_playerInstancedShaderProgram = 0;
+        return false;
+    }
+
     DEBUG_SHADER("Player shaders loaded and compiled successfully!");
     return true;
 }
@@ -1054,7 +973,7 @@ bool Renderer::CreateWireframeGeometry() {
     };
 
     glGenVertexArrays(1, &m_wireframeVAO);
-    glBindVertexArray(m_wireframeVAO);
+    GLStateCache::BindVertexArray(m_wireframeVAO);
 
     glGenBuffers(1, &m_wireframeVBO);
     glBindBuffer(GL_ARRAY_BUFFER, m_wireframeVBO);
@@ -1065,7 +984,7 @@ bool Renderer::CreateWireframeGeometry() {
     glEnableVertexAttribArray(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(0);
 
     return true;
 }
@@ -1124,7 +1043,7 @@ bool Renderer::CreateSkyGeometry() {
     };
 
     glGenVertexArrays(1, &m_skyVAO);
-    glBindVertexArray(m_skyVAO);
+    GLStateCache::BindVertexArray(m_skyVAO);
 
     glGenBuffers(1, &m_skyVBO);
     glBindBuffer(GL_ARRAY_BUFFER, m_skyVBO);
@@ -1135,7 +1054,7 @@ bool Renderer::CreateSkyGeometry() {
     glEnableVertexAttribArray(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLStateCache::BindVertexArray(0);
 
     DEBUG_SHADER("Sky geometry created successfully!");
     return true;
@@ -1201,35 +1120,71 @@ Mat4 Renderer::CreateTranslationMatrix(float x, float y, float z) {
     return trans;
 }
 
+void Renderer::SetRegionModelMatrix(int modelLoc) {
+    // Chunk vertices hold block corners relative to the world's minimum chunk; blocks are centred on their coordinates
+    Mat4 modelMatrix = CreateTranslationMatrix(static_cast<float>(WORLD_MIN_CHUNK * CHUNK_WIDTH) - 0.5f, -0.5f,
+                                               static_cast<float>(WORLD_MIN_CHUNK * CHUNK_DEPTH) - 0.5f);
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, modelMatrix.m);
+}
+
 void Renderer::RenderOtherPlayers(const std::vector<PlayerPosition>& playerPositions) {
-    if (playerPositions.empty()) {
+    const int skinLayerCount = m_playerModel.GetSkinLayerCount();
+    if (playerPositions.empty() || skinLayerCount == 0) {
+        m_remotePlayerWalks.clear();
         return; // No other players to render
     }
     
-
-    
-    // Set the view and projection matrices for player rendering
-    glUseProgram(m_playerShaderProgram);
-    glUniformMatrix4fv(m_playerViewLoc, 1, GL_FALSE, m_viewMatrix.m);
-    glUniformMatrix4fv(m_playerProjLoc, 1, GL_FALSE, m_projectionMatrix.m);
-    
-    // Render each other player with the Minecraft-like player model
+    const float fullTurn = 2.0f * static_cast<float>(M_PI);
+    m_playerInstances.clear();
     for (const PlayerPosition& playerPos : playerPositions) {
+        auto inserted = m_remotePlayerWalks.try_emplace(playerPos.playerId);
+        RemotePlayerWalk& walk = inserted.first->second;
+        float distance = inserted.second ? 0.0f : std::hypot(playerPos.x - walk.x, playerPos.z - walk.z);
+        walk.x = playerPos.x;
+        walk.z = playerPos.z;
+        walk.seen = true;
         
-
-        
-        // Render player model at their position with their rotation
-        Vec3 position(playerPos.x, playerPos.y, playerPos.z);
+        // Swing the limbs while the player moves; once they stop, ease back to the nearest upright pose
+        if (distance > 0.001f && distance < WALK_MAX_STEP) {
+            walk.phase = std::fmod(walk.phase + distance * WALK_PHASE_PER_BLOCK, fullTurn);
+        } else {
+            float rest = std::round(walk.phase / static_cast<float>(M_PI)) * static_cast<float>(M_PI);
+            walk.phase += std::clamp(rest - walk.phase, -WALK_SETTLE_STEP, WALK_SETTLE_STEP);
+        }
         
-        m_playerModel.Render(position, playerPos.yaw, playerPos.pitch);
+        PlayerInstance instance;
+        instance.x = playerPos.x;
+        instance.y = playerPos.y;
+        instance.z = playerPos.z;
+        instance.yaw = playerPos.yaw;
+        instance.pitch = playerPos.pitch;
+        instance.walkPhase = walk.phase;
+        instance.skinLayer = static_cast<float>(playerPos.playerId % static_cast<uint32_t>(skinLayerCount));
+        m_playerInstances.push_back(instance);
+    }
+    
+    // Forget players who are no longer in the list
+    for (auto it = m_remotePlayerWalks.begin(); it != m_remotePlayerWalks.end();) {
+        if (!it->second.seen) {
+            it = m_remotePlayerWalks.erase(it);
+        } else {
+            it->second.seen = false;
+            ++it;
+        }
     }
     
-
+    GpuProfiler::BeginPass(GpuProfiler::PASS_PLAYERS);
+    GLStateCache::UseProgram(m_playerInstancedShaderProgram);
+    GLStateCache::SetEnabled(GL_CULL_FACE, true);
+    m_playerModel.RenderInstanced(m_playerInstances);
+    GpuProfiler::EndPass(GpuProfiler::PASS_PLAYERS);
 }
 
 void Renderer::RenderFirstPersonArm(const Player& player) {
+    GpuProfiler::BeginPass(GpuProfiler::PASS_ARM);
+    
     // Set up the player shader program for first-person arm rendering
-    glUseProgram(m_playerShaderProgram);
+    GLStateCache::UseProgram(m_playerShaderProgram);
     
     // For first-person arm, use identity view matrix so it's not affected by camera rotation
     // This makes it stay fixed relative to the screen like in Minecraft
@@ -1239,8 +1194,9 @@ void Renderer::RenderFirstPersonArm(const Player& player) {
     glUniformMatrix4fv(m_playerViewLoc, 1, GL_FALSE, identityView.m);
     glUniformMatrix4fv(m_playerProjLoc, 1, GL_FALSE, m_projectionMatrix.m);
     
-    // Disable depth testing completely for the arm so it always shows up
-    glDisable(GL_DEPTH_TEST);
+    // Disable depth testing completely for the arm so it always shows up; back faces must then be culled
+    GLStateCache::SetEnabled(GL_DEPTH_TEST, false);
+    GLStateCache::SetEnabled(GL_CULL_FACE, true);
     
     // Debug output to verify arm is being rendered
     static int renderCount = 0;
@@ -1253,16 +1209,15 @@ void Renderer::RenderFirstPersonArm(const Player& player) {
     m_playerModel.RenderFirstPersonArm(player);
     
     // Re-enable depth testing for subsequent rendering
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::SetEnabled(GL_DEPTH_TEST, true);
     
-    // Switch back to main shader program for subsequent rendering
-    glUseProgram(m_shaderProgram);
+    GpuProfiler::EndPass(GpuProfiler::PASS_ARM);
 }
 
 unsigned int Renderer::LoadTexture(const std::string& filepath) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, textureID);
     
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -1297,7 +1252,7 @@ unsigned int Renderer::LoadTexture(const std::string& filepath) {
     }
     
     stbi_image_free(data);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
     
     return textureID;
 }
@@ -1305,7 +1260,7 @@ unsigned int Renderer::LoadTexture(const std::string& filepath) {
 unsigned int Renderer::LoadTextureWithAlpha(const std::string& filepath) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, textureID);
     
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -1328,80 +1283,82 @@ unsigned int Renderer::LoadTextureWithAlpha(const std::string& filepath) {
     }
     
     stbi_image_free(data);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
     
     return textureID;
 }
 
 bool Renderer::LoadBlockTextures() {
-    // Load block definitions from JSON
+    // Load block definitions from JSON (this also lays out the texture array)
     if (!m_blockManager.LoadBlockDefinitions("blocks_config.json")) {
         std::cerr << "Failed to load block definitions from JSON" << std::endl;
         return false;
     }
     
-    // Load textures for all block types
-    std::vector<BlockType> allBlockTypes = m_blockManager.GetAllBlockTypes();
+    const std::vector<TextureLayerSource>& sources = m_blockManager.GetTextureLayerSources();
+    if (sources.empty()) {
+        std::cerr << "No block textures to load" << std::endl;
+        return false;
+    }
+    
+    GLint maxLayers = 0;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+    if (static_cast<GLint>(sources.size()) > maxLayers) {
+        std::cerr << "Block textures need " << sources.size() << " array layers, but the GPU supports "
+                  << maxLayers << std::endl;
+        return false;
+    }
     
-    for (BlockType blockType : allBlockTypes) {
-        const BlockTextureInfo& textureInfo = m_blockManager.GetTextureInfo(blockType);
+    const int size = BLOCK_TEXTURE_SIZE;
+    const int layerBytes = size * size * 4;
+    std::vector<unsigned char> pixels(static_cast<size_t>(layerBytes) * sources.size(), 0);
+    
+    for (size_t layer = 0; layer < sources.size(); ++layer) {
+        const TextureLayerSource& source = sources[layer];
+        std::string filepath = "assets/block/" + source.file;
         
-        // Skip AIR blocks
-        if (blockType == BlockType::AIR) {
-            m_blockTextures[blockType] = 0;
+        int width, height, nrChannels;
+        unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &nrChannels, 4); // Force RGBA
+        if (!data) {
+            // Leave the layer transparent so the missing texture is obvious but harmless
+            std::cerr << "Failed to load texture: " << filepath << std::endl;
+            std::cerr << "STB Error: " << stbi_failure_reason() << std::endl;
             continue;
         }
         
-        // Handle blocks with special texture requirements (like grass)
-        if (blockType == BlockType::GRASS) {
-            // Load grass textures (already handled by default blocks)
-            m_grassTopTexture = LoadTexture("assets/block/" + textureInfo.top);
-            m_grassSideTexture = LoadTexture("assets/block/" + textureInfo.sides);
-            m_grassSideOverlayTexture = LoadTextureWithAlpha("assets/block/" + textureInfo.overlay);
-            m_grassBottomTexture = LoadTexture("assets/block/" + textureInfo.bottom);
-            m_blockTextures[blockType] = m_grassSideTexture;
-        }
-        // Handle log blocks (different textures for top/bottom vs sides)
-        else if (blockType == BlockType::OAK_LOG) {
-            m_oakLogTopTexture = LoadTexture("assets/block/" + textureInfo.top);
-            m_oakLogSideTexture = LoadTexture("assets/block/" + textureInfo.sides);
-            m_blockTextures[blockType] = m_oakLogSideTexture;
-        }
-        else if (blockType == BlockType::BIRCH_LOG) {
-            m_birchLogTopTexture = LoadTexture("assets/block/" + textureInfo.top);
-            m_birchLogSideTexture = LoadTexture("assets/block/" + textureInfo.sides);
-            m_blockTextures[blockType] = m_birchLogSideTexture;
-        }
-        else if (blockType == BlockType::DARK_OAK_LOG) {
-            m_darkOakLogTopTexture = LoadTexture("assets/block/" + textureInfo.top);
-            m_darkOakLogSideTexture = LoadTexture("assets/block/" + textureInfo.sides);
-            m_blockTextures[blockType] = m_darkOakLogSideTexture;
-        }
-        // Handle blocks with a single texture for all faces
-        else if (!textureInfo.all.empty()) {
-            unsigned int textureID = LoadTexture("assets/block/" + textureInfo.all);
-            m_blockTextures[blockType] = textureID;
-            
-            if (textureID == 0) {
-                std::cerr << "Failed to load texture for block type " << static_cast<int>(blockType) 
-                          << " (" << m_blockManager.GetBlockNameByType(blockType) << ")" << std::endl;
+        // Animated textures are vertical strips of square frames; use the first frame.
+        // Frames that are not 32x32 are resampled (nearest) to the array's resolution.
+        int frameSize = std::min(width, height);
+        unsigned char* out = &pixels[layer * layerBytes];
+        for (int y = 0; y < size; ++y) {
+            int srcY = y * frameSize / size;
+            for (int x = 0; x < size; ++x) {
+                int srcX = x * frameSize / size;
+                const unsigned char* texel = &data[(srcY * width + srcX) * 4];
+                unsigned char* dst = &out[(y * size + x) * 4];
+                // Bake the block definition's tint into the texels
+                dst[0] = static_cast<unsigned char>(texel[0] * source.tintR);
+                dst[1] = static_cast<unsigned char>(texel[1] * source.tintG);
+                dst[2] = static_cast<unsigned char>(texel[2] * source.tintB);
+                dst[3] = texel[3];
             }
         }
-        // Handle blocks with separate textures for different faces (future enhancement)
-        else if (!textureInfo.sides.empty()) {
-            // For now, just use the sides texture for all faces
-            unsigned int textureID = LoadTexture("assets/block/" + textureInfo.sides);
-            m_blockTextures[blockType] = textureID;
-        }
-        else {
-            // No texture specified, use a default or skip
-            std::cout << "Warning: No texture specified for block " 
-                      << m_blockManager.GetBlockNameByType(blockType) << std::endl;
-            m_blockTextures[blockType] = 0;
-        }
+        
+        DEBUG_TEXTURE("Loaded texture layer " << layer << ": " << filepath << " (" << width << "x" << height << ")");
+        stbi_image_free(data);
     }
     
-    DEBUG_TEXTURE("Loaded textures for " << m_blockTextures.size() << " block types");
+    glGenTextures(1, &m_blockTextureArray);
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, m_blockTextureArray);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, static_cast<GLsizei>(sources.size()), 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    GLStateCache::BindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    
+    DEBUG_TEXTURE("Loaded " << sources.size() << " block texture layers");
     return true;
 }
 
@@ -1455,61 +1412,37 @@ bool Renderer::LoadInventoryTextures() {
     return true;
 }
 
-void Renderer::RenderSky(float gameTime) {
+void Renderer::RenderSky() {
     // Debug output only when time changes significantly
     static float lastDebugTime = -1.0f;
-    if (abs(gameTime - lastDebugTime) > 10.0f) {
-        std::cout << "[RENDERER] Sky time: " << gameTime << " seconds" << std::endl;
-        lastDebugTime = gameTime;
+    if (abs(m_frameData.gameTime - lastDebugTime) > 10.0f) {
+        std::cout << "[RENDERER] Sky time: " << m_frameData.gameTime << " seconds" << std::endl;
+        lastDebugTime = m_frameData.gameTime;
     }
     
+    GpuProfiler::BeginPass(GpuProfiler::PASS_SKY);
+    
     // Set a neutral clear color as fallback (will be overridden by sky rendering)
+    // Depth writes must be on for the clear to reach the depth buffer
+    GLStateCache::DepthMask(true);
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
-    // Save current rendering state
-    bool depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-    bool cullFaceEnabled = glIsEnabled(GL_CULL_FACE);
+    // Disable depth testing, depth writing, and face culling for sky rendering.
+    // The world passes that follow set the state they need again
+    GLStateCache::SetEnabled(GL_DEPTH_TEST, false);
+    GLStateCache::DepthMask(false);
+    GLStateCache::SetEnabled(GL_CULL_FACE, false); // Disable culling so we can see inside faces of skybox
     
-    // Disable depth testing, depth writing, and face culling for sky rendering
-    glDisable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-    glDisable(GL_CULL_FACE); // Disable culling so we can see inside faces of skybox
-    
-    // Use sky shader program
-    glUseProgram(m_skyShaderProgram);
-    
-    // Set uniforms
-    glUniformMatrix4fv(m_skyViewLoc, 1, GL_FALSE, m_viewMatrix.m);
-    glUniformMatrix4fv(m_skyProjLoc, 1, GL_FALSE, m_projectionMatrix.m);
-    glUniform1f(m_skyGameTimeLoc, gameTime);
-    
-    // Calculate sun direction based on time (for potential future use)
-    float cycleTime = fmod(gameTime, 900.0f); // Get position within 15-minute cycle
-    float timeAngle = (cycleTime / 900.0f) * 2.0f * M_PI; // Full circle over day cycle
-    Vec3 sunDirection(
-        sin(timeAngle),
-        cos(timeAngle),
-        0.0f
-    );
-    glUniform3f(m_skySunDirLoc, sunDirection.x, sunDirection.y, sunDirection.z);
+    // View, projection, game time and sun direction come from the frame's uniform buffer
+    GLStateCache::UseProgram(m_skyShaderProgram);
     
     // Render sky geometry
-    glBindVertexArray(m_skyVAO);
+    GLStateCache::BindVertexArray(m_skyVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36); // 36 vertices for cube (6 faces * 6 vertices per face)
-    glBindVertexArray(0);
+    GpuProfiler::CountDraw(36);
     
-    // Restore rendering state
-    glDepthMask(GL_TRUE);
-    if (depthTestEnabled) {
-        glEnable(GL_DEPTH_TEST);
-    }
-    if (cullFaceEnabled) {
-        glEnable(GL_CULL_FACE);
-    }
-    
-    // Switch back to main shader program for subsequent rendering
-    glUseProgram(m_shaderProgram);
+    GpuProfiler::EndPass(GpuProfiler::PASS_SKY);
 }
 
 // ============== FRUSTUM CULLING IMPLEMENTATION ==============
@@ -1518,17 +1451,18 @@ void Renderer::ExtractFrustum(const Mat4& viewMatrix, const Mat4& projMatrix) {
     // Multiply view and projection matrices to get view-projection matrix
     Mat4 viewProj;
     
-    // Manual matrix multiplication: viewProj = proj * view
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
-            viewProj.m[i * 4 + j] = 0;
+    // Manual matrix multiplication: viewProj = proj * view. Matrices are column-major (as uploaded to
+    // the shaders), so element (row, column) is m[column * 4 + row]
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            viewProj.m[column * 4 + row] = 0;
             for (int k = 0; k < 4; k++) {
-                viewProj.m[i * 4 + j] += projMatrix.m[i * 4 + k] * viewMatrix.m[k * 4 + j];
+                viewProj.m[column * 4 + row] += projMatrix.m[k * 4 + row] * viewMatrix.m[column * 4 + k];
             }
         }
     }
     
-    // Extract the six frustum planes from the view-projection matrix
+    // Extract the six frustum planes from the view-projection matrix (row 3 plus or minus rows 0-2)
     // Left plane
     m_frustum.planes[0] = Plane(
         Vec3(viewProj.m[3] + viewProj.m[0], viewProj.m[7] + viewProj.m[4], viewProj.m[11] + viewProj.m[8]),
@@ -1575,40 +1509,107 @@ void Renderer::ExtractFrustum(const Mat4& viewMatrix, const Mat4& projMatrix) {
     }
 }
 
-bool Renderer::IsChunkInFrustum(int chunkX, int chunkZ) const {
-    // Calculate chunk world bounds
-    // Each chunk is 16x16 blocks in XZ, full height (256) in Y
-    float worldX = chunkX * CHUNK_WIDTH;
-    float worldZ = chunkZ * CHUNK_DEPTH;
-    
-    Vec3 chunkMin(worldX, 0.0f, worldZ);
-    Vec3 chunkMax(worldX + CHUNK_WIDTH, CHUNK_HEIGHT, worldZ + CHUNK_DEPTH); 
-    
-    AABB chunkAABB(chunkMin, chunkMax);
-    
-    // Make culling much more conservative by expanding the AABB significantly
-    // This prevents false positives where chunks at the edge get culled incorrectly
-            // Using a large margin because 70° FOV is still quite wide
-    float margin = 16.0f; // 16 block margin - very conservative
-    AABB expandedAABB(Vec3(chunkMin.x - margin, chunkMin.y - margin, chunkMin.z - margin),
-                      Vec3(chunkMax.x + margin, chunkMax.y + margin, chunkMax.z + margin));
-    
-    bool inFrustum = IsAABBInFrustum(expandedAABB);
-    
-    // Debug output for the first few seconds to see culling behavior
-    static float debugStartTime = glfwGetTime();
-    if (glfwGetTime() - debugStartTime < 5.0f) { // Debug for first 5 seconds
-        if (!inFrustum) {
-            static int debugCount = 0;
-            if (debugCount < 10) { // Limit debug spam
-                std::cout << "[FRUSTUM] Culling chunk (" << chunkX << ", " << chunkZ 
-                          << ") at world coords (" << worldX << ", " << worldZ << ")" << std::endl;
-                debugCount++;
+uint16_t Renderer::CullChunkSections(const Chunk& chunk) {
+    uint16_t meshSections = chunk.GetMeshSectionMask();
+    int sectionCount = 0;
+    for (uint16_t bits = meshSections; bits != 0; bits &= bits - 1) {
+        ++sectionCount;
+    }
+    m_sectionsTested += sectionCount;
+    if (!m_enableFrustumCulling || meshSections == 0) {
+        return meshSections;
+    }
+    
+    // Blocks are centred on their coordinates, so block b covers [b - 0.5, b + 0.5]. Heights are clipped
+    // to the blocks the mesh was built from, which trims the air above the terrain out of the top section
+    float minX = static_cast<float>(chunk.GetChunkX() * CHUNK_WIDTH) - 0.5f;
+    float minZ = static_cast<float>(chunk.GetChunkZ() * CHUNK_DEPTH) - 0.5f;
+    float maxX = minX + CHUNK_WIDTH;
+    float maxZ = minZ + CHUNK_DEPTH;
+    int minY = std::max(chunk.GetMeshMinY(), 0);
+    int maxY = chunk.GetMeshMaxY() >= 0 ? chunk.GetMeshMaxY() : CHUNK_HEIGHT - 1;
+    
+    // Whole column first: most chunks outside the view are rejected with one test
+    if (!IsAABBInFrustum(AABB(Vec3(minX, minY - 0.5f, minZ), Vec3(maxX, maxY + 0.5f, maxZ)))) {
+        m_sectionsCulled += sectionCount;
+        return 0;
+    }
+    
+    uint16_t visibleSections = 0;
+    for (int sectionY = 0; sectionY < CHUNK_SECTION_COUNT; ++sectionY) {
+        if (!((meshSections >> sectionY) & 1)) {
+            continue;
+        }
+        int sectionMinY = std::max(sectionY * SECTION_SIZE, minY);
+        int sectionMaxY = std::min(sectionY * SECTION_SIZE + SECTION_SIZE - 1, maxY);
+        if (sectionMinY <= sectionMaxY &&
+            IsAABBInFrustum(AABB(Vec3(minX, sectionMinY - 0.5f, minZ), Vec3(maxX, sectionMaxY + 0.5f, maxZ)))) {
+            visibleSections |= static_cast<uint16_t>(1u << sectionY);
+        } else {
+            ++m_sectionsCulled;
+        }
+    }
+    return visibleSections;
+}
+
+bool Renderer::TraverseVisibleSections(const World& world) {
+    m_reachedSections.assign(WORLD_SIZE * WORLD_SIZE, 0);
+    m_sectionQueue.clear();
+    
+    // Blocks are centred on their coordinates, so the camera is in block round(position)
+    int blockX = static_cast<int>(std::floor(m_eyePosition.x + 0.5f));
+    int blockY = static_cast<int>(std::floor(m_eyePosition.y + 0.5f));
+    int blockZ = static_cast<int>(std::floor(m_eyePosition.z + 0.5f));
+    int cameraChunkX = static_cast<int>(std::floor(static_cast<float>(blockX) / CHUNK_WIDTH));
+    int cameraChunkZ = static_cast<int>(std::floor(static_cast<float>(blockZ) / CHUNK_DEPTH));
+    if (blockY < 0 || blockY >= CHUNK_HEIGHT || !world.GetChunk(cameraChunkX, cameraChunkZ)) {
+        return false; // Above, below or beside the world: nothing to walk from, fall back to the frustum alone
+    }
+    
+    auto gridIndex = [](int chunkX, int chunkZ) { return (chunkX - WORLD_MIN_CHUNK) * WORLD_SIZE + (chunkZ - WORLD_MIN_CHUNK); };
+    m_reachedSections[gridIndex(cameraChunkX, cameraChunkZ)] |= static_cast<uint16_t>(1u << (blockY >> 4));
+    m_sectionQueue.push_back({cameraChunkX, blockY >> 4, cameraChunkZ, -1, 0});
+    
+    // Neighbour offsets (x, y, z) by section face id: +Z, -Z, -X, +X, -Y, +Y
+    static const int faceOffsets[SECTION_FACE_COUNT][3] = {{0, 0, 1}, {0, 0, -1}, {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}};
+    
+    // Breadth-first, so each section is entered along one of the shortest paths from the camera. Leaving
+    // is allowed through faces the section connects to the entry face, away from the camera only, and
+    // only into sections that intersect the frustum
+    for (size_t head = 0; head < m_sectionQueue.size(); ++head) {
+        SectionStep step = m_sectionQueue[head];
+        SectionVisibility visibility = world.GetChunk(step.chunkX, step.chunkZ)->GetSectionVisibility(step.sectionY);
+        for (int face = 0; face < SECTION_FACE_COUNT; ++face) {
+            if ((step.directions >> (face ^ 1)) & 1) {
+                continue;
+            }
+            if (step.enteredFace >= 0 && !AreSectionFacesConnected(visibility, step.enteredFace, face)) {
+                continue;
             }
+            
+            int chunkX = step.chunkX + faceOffsets[face][0];
+            int sectionY = step.sectionY + faceOffsets[face][1];
+            int chunkZ = step.chunkZ + faceOffsets[face][2];
+            if (sectionY < 0 || sectionY >= CHUNK_SECTION_COUNT || !world.GetChunk(chunkX, chunkZ)) {
+                continue;
+            }
+            uint16_t& reached = m_reachedSections[gridIndex(chunkX, chunkZ)];
+            uint16_t bit = static_cast<uint16_t>(1u << sectionY);
+            if (reached & bit) {
+                continue;
+            }
+            
+            Vec3 sectionMin(chunkX * CHUNK_WIDTH - 0.5f, sectionY * SECTION_SIZE - 0.5f, chunkZ * CHUNK_DEPTH - 0.5f);
+            if (m_enableFrustumCulling &&
+                !IsAABBInFrustum(AABB(sectionMin, Vec3(sectionMin.x + CHUNK_WIDTH, sectionMin.y + SECTION_SIZE, sectionMin.z + CHUNK_DEPTH)))) {
+                continue;
+            }
+            
+            reached |= bit;
+            m_sectionQueue.push_back({chunkX, sectionY, chunkZ, face ^ 1, static_cast<uint8_t>(step.directions | (1u << face))});
         }
     }
-    
-    return inFrustum;
+    return true;
 }
 
 bool Renderer::IsAABBInFrustum(const AABB& aabb) const {
@@ -1633,46 +1634,6 @@ bool Renderer::IsAABBInFrustum(const AABB& aabb) const {
     return true; // AABB is inside or intersecting the frustum
 }
 
-bool Renderer::NeedsBiomeTinting(BlockType blockType) const {
-    return blockType == BlockType::GRASS || IsLeafBlock(blockType);
-}
-
-bool Renderer::IsLeafBlock(BlockType blockType) const {
-    return blockType == BlockType::ACACIA_LEAVES ||
-           blockType == BlockType::AZALEA_LEAVES ||
-           blockType == BlockType::BIRCH_LEAVES ||
-           blockType == BlockType::CHERRY_LEAVES ||
-           blockType == BlockType::JUNGLE_LEAVES ||
-           blockType == BlockType::MANGROVE_LEAVES ||
-           blockType == BlockType::SPRUCE_LEAVES ||
-           blockType == static_cast<BlockType>(235); // OAK_LEAVES
-}
-
-void Renderer::ApplyBiomeTinting(BlockType blockType, int chunkX, int chunkZ, int worldSeed) {
-    // Get center position of chunk for biome calculation
-    int worldX = chunkX * 16 + 8; // CHUNK_WIDTH is 16
-    int worldZ = chunkZ * 16 + 8; // CHUNK_DEPTH is 16
-    
-    // Get biome for this chunk
-    BiomeType biome = BiomeSystem::GetBiomeType(worldX, worldZ, worldSeed);
-    
-    float r, g, b;
-    
-    if (blockType == BlockType::GRASS) {
-        // Apply grass color for this biome
-        BiomeSystem::GetGrassColor(biome, r, g, b);
-    } else if (IsLeafBlock(blockType)) {
-        // Apply foliage color for this biome
-        BiomeSystem::GetFoliageColor(biome, r, g, b);
-    } else {
-        // Fallback to no tint
-        r = g = b = 1.0f;
-    }
-    
-    // Apply the tint to the shader
-    glUniform3f(m_colorTintLoc, r, g, b);
-}
-
 // Item texture management methods
 unsigned int Renderer::LoadItemTexture(const std::string& itemIconPath) {
     // Check if texture is already loaded
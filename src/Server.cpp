@@ -886,7 +886,7 @@ void Server::SendChunkData(socket_t clientSocket, int32_t chunkX, int32_t chunkZ
         return;
     }
     
-    // TODO: Create proper ChunkDataMessage for large chunk data
+    // TODO: Create proper ChunkDataMessage for large chunk data, blocks plus chunk->GetBiomeMap()
     // For now, just log that chunk data was requested
     std::cout << "[SERVER] CHUNK_DATA needs proper ChunkDataMessage implementation" << std::endl;
     return;
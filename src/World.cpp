@@ -1,4 +1,6 @@
 #include "World.h"
+#include "PerlinNoise.h"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
@@ -22,6 +24,11 @@ World::World(int seed) : m_seed(seed) {
     std::cout << "World created with seed: " << m_seed << std::endl;
 }
 
+World::~World() {
+    // Workers hold pointers into this World, so stop them before anything else is destroyed
+    m_workers.reset();
+}
+
 void World::InitializeChunks() {
     // Initialize 10x10 grid of chunks centered around origin
     // Array index [0][0] = chunk (-5, -5)
@@ -56,6 +63,46 @@ Block World::GetBlock(int worldX, int worldY, int worldZ) const {
     return chunk->GetBlock(localX, worldY, localZ);
 }
 
+bool World::IsBlockOccupied(int worldX, int worldY, int worldZ) const {
+    if (!IsValidWorldPosition(worldX, worldY, worldZ)) {
+        return false;
+    }
+    
+    int chunkX, chunkZ, localX, localZ;
+    WorldToChunkCoords(worldX, worldZ, chunkX, chunkZ, localX, localZ);
+    
+    const Chunk* chunk = GetChunk(chunkX, chunkZ);
+    return chunk && chunk->IsOccupied(localX, worldY, localZ);
+}
+
+bool World::IsRegionOccupied(int minX, int minY, int minZ, int maxX, int maxY, int maxZ) const {
+    // Blocks outside the world read as air, so clamp the box to the valid height range
+    minY = std::max(minY, 0);
+    maxY = std::min(maxY, CHUNK_HEIGHT - 1);
+    
+    for (int worldZ = minZ; worldZ <= maxZ; ++worldZ) {
+        // Walk the X range one chunk-wide span at a time, testing the span's bits of each row together
+        for (int spanStartX = minX; spanStartX <= maxX; ) {
+            int chunkX, chunkZ, localX, localZ;
+            WorldToChunkCoords(spanStartX, worldZ, chunkX, chunkZ, localX, localZ);
+            int spanEndLocalX = std::min(CHUNK_WIDTH - 1, localX + (maxX - spanStartX));
+            int nextSpanStartX = spanStartX + (spanEndLocalX - localX) + 1;
+            
+            const Chunk* chunk = GetChunk(chunkX, chunkZ);
+            if (chunk) {
+                uint16_t spanMask = static_cast<uint16_t>(((1u << (spanEndLocalX + 1)) - 1) & ~((1u << localX) - 1));
+                for (int worldY = minY; worldY <= maxY; ++worldY) {
+                    if (chunk->GetOccupancyRow(worldY, localZ) & spanMask) {
+                        return true;
+                    }
+                }
+            }
+            spanStartX = nextSpanStartX;
+        }
+    }
+    return false;
+}
+
 void World::SetBlock(int worldX, int worldY, int worldZ, BlockType type) {
     if (!IsValidWorldPosition(worldX, worldY, worldZ)) {
         return;
@@ -84,7 +131,7 @@ void World::SetBlock(int worldX, int worldY, int worldZ, const Block& block) {
     }
 }
 
-void World::SetBlockWithMeshUpdate(int worldX, int worldY, int worldZ, BlockType type, const BlockManager* blockManager) {
+void World::SetBlockWithMeshUpdate(int worldX, int worldY, int worldZ, BlockType type) {
     if (!IsValidWorldPosition(worldX, worldY, worldZ)) {
         return;
     }
@@ -95,14 +142,16 @@ void World::SetBlockWithMeshUpdate(int worldX, int worldY, int worldZ, BlockType
     Chunk* chunk = GetChunk(chunkX, chunkZ);
     if (chunk) {
         chunk->SetBlock(localX, worldY, localZ, type);
-        chunk->UpdateBlockMesh(localX, worldY, localZ, this, blockManager);
+        
+        // Rebuild the touched sections in the background ahead of streamed chunks; uploaded by ProcessMeshQueue
+        RequestSectionMesh(chunkX, chunkZ, Chunk::GetEditSectionMask(worldY), true);
         
         // Update neighboring chunks if block is on chunk boundary
-        UpdateNeighboringChunks(worldX, worldY, worldZ, blockManager);
+        UpdateNeighboringChunks(worldX, worldY, worldZ);
     }
 }
 
-void World::UpdateNeighboringChunks(int worldX, int worldY, int worldZ, const BlockManager* blockManager) {
+void World::UpdateNeighboringChunks(int worldX, int worldY, int worldZ) {
     int chunkX, chunkZ, localX, localZ;
     WorldToChunkCoords(worldX, worldZ, chunkX, chunkZ, localX, localZ);
     
@@ -112,25 +161,19 @@ void World::UpdateNeighboringChunks(int worldX, int worldY, int worldZ, const Bl
     bool onBackEdge = (localZ == 0);
     bool onFrontEdge = (localZ == CHUNK_DEPTH - 1);
     
-    // Update neighboring chunks that might be affected
-    if (onLeftEdge) {
-        Chunk* leftChunk = GetChunk(chunkX - 1, chunkZ);
-        if (leftChunk) leftChunk->UpdateBlockMesh(CHUNK_WIDTH - 1, worldY, localZ, this, blockManager);
+    // Neighbours sample this block for face culling and ambient occlusion, including the
+    // diagonal neighbour when the block sits on a chunk corner
+    int offsetX = onLeftEdge ? -1 : (onRightEdge ? 1 : 0);
+    int offsetZ = onBackEdge ? -1 : (onFrontEdge ? 1 : 0);
+    uint16_t sectionMask = Chunk::GetEditSectionMask(worldY);
+    if (offsetX != 0) {
+        RequestSectionMesh(chunkX + offsetX, chunkZ, sectionMask, true);
     }
-    
-    if (onRightEdge) {
-        Chunk* rightChunk = GetChunk(chunkX + 1, chunkZ);
-        if (rightChunk) rightChunk->UpdateBlockMesh(0, worldY, localZ, this, blockManager);
+    if (offsetZ != 0) {
+        RequestSectionMesh(chunkX, chunkZ + offsetZ, sectionMask, true);
     }
-    
-    if (onBackEdge) {
-        Chunk* backChunk = GetChunk(chunkX, chunkZ - 1);
-        if (backChunk) backChunk->UpdateBlockMesh(localX, worldY, CHUNK_DEPTH - 1, this, blockManager);
-    }
-    
-    if (onFrontEdge) {
-        Chunk* frontChunk = GetChunk(chunkX, chunkZ + 1);
-        if (frontChunk) frontChunk->UpdateBlockMesh(localX, worldY, 0, this, blockManager);
+    if (offsetX != 0 && offsetZ != 0) {
+        RequestSectionMesh(chunkX + offsetX, chunkZ + offsetZ, sectionMask, true);
     }
 }
 
@@ -182,29 +225,53 @@ const Chunk* World::GetChunk(int chunkX, int chunkZ) const {
 }
 
 void World::Generate() {
-    for (int x = 0; x < WORLD_SIZE; ++x) {
-        for (int z = 0; z < WORLD_SIZE; ++z) {
-            if (m_chunks[x][z]) {
-                m_chunks[x][z]->Generate(m_seed);
-            }
-        }
-    }
+    GenerateChunks(nullptr);
     
     // Generate meshes after all chunks are generated
     GenerateAllMeshes();
 }
 
 void World::GenerateWithBlockManager(const BlockManager* blockManager) {
+    GenerateChunks(blockManager);
+    
+    // Generate meshes after all chunks are generated
+    GenerateAllMeshes(blockManager);
+}
+
+void World::GenerateChunks(const BlockManager* blockManager) {
+    // A chunk's terrain depends only on the seed and its own coordinates, and Chunk::Generate writes
+    // nothing outside the chunk, so the chunks generate in parallel with the same result as in order
+    ThreadPool& workers = GetWorkers();
+    const int chunkCount = WORLD_SIZE * WORLD_SIZE;
+    std::vector<double> chunkMilliseconds(chunkCount, 0.0);
+    auto start = std::chrono::steady_clock::now();
     for (int x = 0; x < WORLD_SIZE; ++x) {
         for (int z = 0; z < WORLD_SIZE; ++z) {
-            if (m_chunks[x][z]) {
-                m_chunks[x][z]->Generate(m_seed, blockManager);
+            Chunk* chunk = m_chunks[x][z].get();
+            if (!chunk) {
+                continue;
             }
+            double* elapsed = &chunkMilliseconds[x * WORLD_SIZE + z];
+            int seed = m_seed;
+            workers.Submit([chunk, seed, blockManager, elapsed]() {
+                auto chunkStart = std::chrono::steady_clock::now();
+                chunk->Generate(seed, blockManager);
+                *elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - chunkStart).count();
+            });
         }
     }
+    workers.WaitIdle();
     
-    // Generate meshes after all chunks are generated
-    GenerateAllMeshes(blockManager);
+    // Wall time against the summed per-chunk time shows how generation scales with the worker count
+    double wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double workMilliseconds = 0.0;
+    for (double milliseconds : chunkMilliseconds) {
+        workMilliseconds += milliseconds;
+    }
+    std::cout << "[WORLD] Generated " << chunkCount << " chunks in " << wallMilliseconds << " ms on "
+              << workers.GetThreadCount() << " worker threads (" << workMilliseconds << " ms of chunk work, "
+              << (wallMilliseconds > 0.0 ? workMilliseconds / wallMilliseconds : 0.0) << "x speedup, "
+              << PerlinNoise::GetKernelName(PerlinNoise::GetKernel()) << " noise)" << std::endl;
 }
 
 void World::RegenerateWithSeed(int newSeed) {
@@ -223,25 +290,89 @@ void World::RegenerateWithSeed(int newSeed, const BlockManager* blockManager) {
     GenerateWithBlockManager(blockManager);
     
     std::cout << "World regenerated with colorful blocks using seed: " << m_seed << std::endl;
+    std::cout << "Block storage: " << (GetBlockMemoryUsage() / 1024) << " KB across " << (WORLD_SIZE * WORLD_SIZE) << " chunks" << std::endl;
 }
 
-void World::GenerateAllMeshes() {
-    // Generate meshes for all chunks
+size_t World::GetBlockMemoryUsage() const {
+    size_t total = 0;
     for (int x = 0; x < WORLD_SIZE; ++x) {
         for (int z = 0; z < WORLD_SIZE; ++z) {
             if (m_chunks[x][z]) {
-                m_chunks[x][z]->GenerateMesh(this);
+                total += m_chunks[x][z]->GetMemoryUsage();
             }
         }
     }
+    return total;
+}
+
+size_t World::GetTotalVertexCount() const {
+    size_t total = 0;
+    for (int x = 0; x < WORLD_SIZE; ++x) {
+        for (int z = 0; z < WORLD_SIZE; ++z) {
+            if (m_chunks[x][z]) {
+                total += m_chunks[x][z]->GetVertexCount();
+            }
+        }
+    }
+    return total;
+}
+
+void World::GenerateAllMeshes() {
+    GenerateAllMeshes(nullptr);
 }
 
 void World::GenerateAllMeshes(const BlockManager* blockManager) {
-    // Generate meshes for all chunks with BlockManager for proper face culling
+    // Every chunk is rebuilt below, so pending background requests are obsolete
+    CancelMeshRequests();
+    ThreadPool& workers = GetWorkers();
+    
+    // Snapshot on this thread, build every chunk in parallel, then upload in one pass.
+    // The BlockManager enables proper face culling against transparent and ground blocks
+    const int chunkCount = WORLD_SIZE * WORLD_SIZE;
+    std::vector<std::unique_ptr<ChunkMeshSnapshot>> snapshots(chunkCount);
+    std::vector<ChunkMeshData> meshData(chunkCount);
+    for (int x = 0; x < WORLD_SIZE; ++x) {
+        for (int z = 0; z < WORLD_SIZE; ++z) {
+            Chunk* chunk = m_chunks[x][z].get();
+            if (!chunk) {
+                continue;
+            }
+            if (blockManager) {
+                chunk->SetBlockManager(blockManager);
+            }
+            int index = x * WORLD_SIZE + z;
+            snapshots[index] = std::make_unique<ChunkMeshSnapshot>();
+            ChunkMesher::CaptureSnapshot(*snapshots[index], *chunk, this, blockManager);
+        }
+    }
+    
+    std::vector<double> chunkMilliseconds(chunkCount, 0.0);
+    auto start = std::chrono::steady_clock::now();
+    for (int index = 0; index < chunkCount; ++index) {
+        if (snapshots[index]) {
+            workers.Submit([&snapshots, &meshData, &chunkMilliseconds, index, blockManager]() {
+                auto chunkStart = std::chrono::steady_clock::now();
+                ChunkMesher(*snapshots[index], blockManager).Build(meshData[index]);
+                chunkMilliseconds[index] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - chunkStart).count();
+            });
+        }
+    }
+    workers.WaitIdle();
+    
+    // Same report as GenerateChunks; the summed build time is the figure to compare mesher changes by
+    double wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double workMilliseconds = 0.0;
+    for (double milliseconds : chunkMilliseconds) {
+        workMilliseconds += milliseconds;
+    }
+    std::cout << "[WORLD] Meshed " << chunkCount << " chunks in " << wallMilliseconds << " ms on "
+              << workers.GetThreadCount() << " worker threads (" << workMilliseconds << " ms of mesh work, "
+              << (Chunk::GetMeshingMode() == Chunk::MeshingMode::GREEDY ? "greedy" : "per-face") << " meshing)" << std::endl;
+    
     for (int x = 0; x < WORLD_SIZE; ++x) {
         for (int z = 0; z < WORLD_SIZE; ++z) {
             if (m_chunks[x][z]) {
-                m_chunks[x][z]->GenerateMesh(this, blockManager);
+                m_chunks[x][z]->ApplyMesh(meshData[x * WORLD_SIZE + z]);
             }
         }
     }
@@ -257,6 +388,149 @@ void World::RegenerateMeshes(const BlockManager* blockManager) {
     GenerateAllMeshes(blockManager);
 }
 
+ThreadPool& World::GetWorkers() {
+    if (!m_workers) {
+        m_workers = std::make_unique<ThreadPool>();
+        std::cout << "[WORLD] Started " << m_workers->GetThreadCount() << " world worker threads" << std::endl;
+    }
+    return *m_workers;
+}
+
+void World::RequestChunkMesh(int chunkX, int chunkZ, bool urgent) {
+    RequestSectionMesh(chunkX, chunkZ, ALL_SECTIONS_MASK, urgent);
+}
+
+void World::RequestSectionMesh(int chunkX, int chunkZ, uint16_t sectionMask, bool urgent) {
+    int arrayX, arrayZ;
+    ChunkCoordsToArrayIndex(chunkX, chunkZ, arrayX, arrayZ);
+    if (!IsValidChunkIndex(arrayX, arrayZ) || !m_chunks[arrayX][arrayZ]) {
+        return;
+    }
+    
+    m_meshDirtySections[arrayX][arrayZ] |= sectionMask;
+    uint8_t& state = m_meshState[arrayX][arrayZ];
+    if (state & MESH_IN_FLIGHT) {
+        // The running build read the old blocks; the dirty sections are requeued once its result lands
+        return;
+    }
+    
+    std::pair<int, int> coords(chunkX, chunkZ);
+    if (state & MESH_QUEUED) {
+        if (!urgent) {
+            return; // Already waiting
+        }
+        m_meshQueue.erase(std::remove(m_meshQueue.begin(), m_meshQueue.end(), coords), m_meshQueue.end());
+    }
+    
+    state |= MESH_QUEUED;
+    if (urgent) {
+        m_meshQueue.push_front(coords);
+    } else {
+        m_meshQueue.push_back(coords);
+    }
+}
+
+void World::RequestChunkMeshWithNeighbors(int chunkX, int chunkZ, bool urgent) {
+    RequestChunkMesh(chunkX, chunkZ, urgent);
+    for (int dx = -1; dx <= 1; ++dx) {
+        for (int dz = -1; dz <= 1; ++dz) {
+            if (dx != 0 || dz != 0) {
+                RequestChunkMesh(chunkX + dx, chunkZ + dz, urgent);
+            }
+        }
+    }
+}
+
+void World::RequestAllChunkMeshes() {
+    for (int x = 0; x < WORLD_SIZE; ++x) {
+        for (int z = 0; z < WORLD_SIZE; ++z) {
+            RequestChunkMesh(x - 5, z - 5);
+        }
+    }
+}
+
+void World::SubmitMeshJob(int chunkX, int chunkZ, const BlockManager* blockManager) {
+    int arrayX, arrayZ;
+    ChunkCoordsToArrayIndex(chunkX, chunkZ, arrayX, arrayZ);
+    Chunk* chunk = m_chunks[arrayX][arrayZ].get();
+    if (blockManager) {
+        chunk->SetBlockManager(blockManager);
+    }
+    
+    // The snapshot is the only chunk data the worker sees, so later edits cannot race with the build
+    std::shared_ptr<ChunkMeshSnapshot> snapshot = std::make_shared<ChunkMeshSnapshot>();
+    ChunkMesher::CaptureSnapshot(*snapshot, *chunk, this, blockManager, m_meshDirtySections[arrayX][arrayZ]);
+    m_meshDirtySections[arrayX][arrayZ] = 0;
+    m_meshState[arrayX][arrayZ] = MESH_IN_FLIGHT;
+    ++m_meshJobsInFlight;
+    
+    GetWorkers().Submit([this, snapshot, blockManager]() {
+        CompletedMesh result;
+        result.chunkX = snapshot->chunkX;
+        result.chunkZ = snapshot->chunkZ;
+        ChunkMesher(*snapshot, blockManager).Build(result.meshData);
+        
+        std::lock_guard<std::mutex> lock(m_completedMeshMutex);
+        m_completedMeshes.push_back(std::move(result));
+    });
+}
+
+void World::ProcessMeshQueue(const BlockManager* blockManager, int maxUploads) {
+    // Hand queued chunks to the workers; finished-but-not-uploaded jobs count as in flight,
+    // which keeps snapshot and vertex memory bounded while uploads catch up
+    const int maxJobs = static_cast<int>(GetWorkers().GetThreadCount()) * MESH_JOBS_PER_WORKER;
+    while (!m_meshQueue.empty() && m_meshJobsInFlight < maxJobs) {
+        std::pair<int, int> coords = m_meshQueue.front();
+        m_meshQueue.pop_front();
+        SubmitMeshJob(coords.first, coords.second, blockManager);
+    }
+    
+    // Upload finished meshes under the per-frame budget; the rest wait for the next frame
+    for (int uploads = 0; uploads < maxUploads; ++uploads) {
+        CompletedMesh completed;
+        {
+            std::lock_guard<std::mutex> lock(m_completedMeshMutex);
+            if (m_completedMeshes.empty()) {
+                break;
+            }
+            completed = std::move(m_completedMeshes.front());
+            m_completedMeshes.pop_front();
+        }
+        --m_meshJobsInFlight;
+        
+        int arrayX, arrayZ;
+        ChunkCoordsToArrayIndex(completed.chunkX, completed.chunkZ, arrayX, arrayZ);
+        m_chunks[arrayX][arrayZ]->ApplyMesh(completed.meshData);
+        
+        // A stale result is still newer than what was on screen, so it is shown until the rebuild lands
+        m_meshState[arrayX][arrayZ] = 0;
+        if (m_meshDirtySections[arrayX][arrayZ] != 0) {
+            RequestSectionMesh(completed.chunkX, completed.chunkZ, 0, true);
+        }
+    }
+}
+
+size_t World::GetPendingMeshCount() const {
+    return m_meshQueue.size() + static_cast<size_t>(m_meshJobsInFlight);
+}
+
+void World::CancelMeshRequests() {
+    if (m_workers) {
+        m_workers->WaitIdle();
+    }
+    m_meshQueue.clear();
+    for (auto& row : m_meshState) {
+        row.fill(0);
+    }
+    for (auto& row : m_meshDirtySections) {
+        row.fill(0);
+    }
+    m_meshJobsInFlight = 0;
+    
+    std::lock_guard<std::mutex> lock(m_completedMeshMutex);
+    m_completedMeshes.clear();
+}
+
 bool World::IsValidWorldPosition(int worldX, int worldY, int worldZ) const {
     // Check Y bounds
     if (worldY < 0 || worldY >= CHUNK_HEIGHT) {
@@ -305,14 +579,34 @@ void World::ChunkCoordsToArrayIndex(int chunkX, int chunkZ, int& arrayX, int& ar
 } 
 
 int World::FindHighestBlock(int worldX, int worldZ) const {
-    // Start from the top and work down to find the highest non-air block
-    for (int y = CHUNK_HEIGHT - 1; y >= 0; y--) {
-        Block block = GetBlock(worldX, y, worldZ);
-        if (block.GetType() != BlockType::AIR) {
-            return y + 1; // Return the Y position above the highest block (where player should spawn)
-        }
+    // Read the highest non-air block straight from the chunk heightmap
+    int highestY = GetHeight(worldX, worldZ, HeightmapType::NON_AIR);
+    if (highestY >= 0) {
+        return highestY + 1; // Return the Y position above the highest block (where player should spawn)
     }
     
     // If no blocks found, return a default height
     return 64; // Default spawn height if no terrain found
+}
+
+int World::GetHeight(int worldX, int worldZ, HeightmapType type) const {
+    int chunkX, chunkZ, localX, localZ;
+    WorldToChunkCoords(worldX, worldZ, chunkX, chunkZ, localX, localZ);
+    
+    const Chunk* chunk = GetChunk(chunkX, chunkZ);
+    if (!chunk) {
+        return -1;
+    }
+    return chunk->GetHeight(localX, localZ, type);
+}
+
+int World::FindHighestBlockBelow(int worldX, int worldZ, int maxY, HeightmapType type) const {
+    int chunkX, chunkZ, localX, localZ;
+    WorldToChunkCoords(worldX, worldZ, chunkX, chunkZ, localX, localZ);
+    
+    const Chunk* chunk = GetChunk(chunkX, chunkZ);
+    if (!chunk) {
+        return -1;
+    }
+    return chunk->FindHighestBlockBelow(localX, localZ, maxY, type);
 } 
\ No newline at end of file